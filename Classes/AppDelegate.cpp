@@ -26,6 +26,7 @@
 #include "HelloWorldScene.h"
 #include "Scenes/SplashScene.h"
 #include "Game/Save/SaveSystem.h"
+#include "Game/GameConfig.h"
 
 // #define USE_AUDIO_ENGINE 1
 // #define USE_SIMPLE_AUDIO_ENGINE 1
@@ -121,6 +122,8 @@ bool AppDelegate::applicationDidFinishLaunching() {
     register_all_packages();
 
     Game::setSaveRootDirectory("save");
+    Game::setSaveCompression(static_cast<Game::SaveCodec>(GameConfig::SAVE_CODEC),
+                             GameConfig::SAVE_COMPRESSION_LEVEL);
 
     // create a scene. it's an autorelease object
     auto scene = SplashScene::createScene();
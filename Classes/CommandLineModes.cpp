@@ -0,0 +1,42 @@
+#include "CommandLineModes.h"
+#include "Game/Save/SaveBenchmark.h"
+#include "Controllers/Systems/WorldSimulation.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+bool hasFlag(const std::vector<std::string>& args, const char* flag) {
+    return std::find(args.begin(), args.end(), flag) != args.end();
+}
+
+// 取参数后面紧跟的值；参数不存在或没有值时返回 false。
+bool flagValue(const std::vector<std::string>& args, const char* flag, std::string& value) {
+    auto it = std::find(args.begin(), args.end(), flag);
+    if (it == args.end() || ++it == args.end()) return false;
+    value = *it;
+    return true;
+}
+
+}
+
+bool runCommandLineMode(const std::vector<std::string>& args, int& exitCode) {
+    if (hasFlag(args, "--save-bench")) {
+        Game::SaveBenchOptions options;
+        options.fuzz = hasFlag(args, "--save-fuzz");
+        exitCode = Game::runSaveBenchmark(options);
+        return true;
+    }
+    std::string days;
+    if (flagValue(args, "--simulate-days", days)) {
+        Controllers::WorldSimOptions options;
+        options.days = std::max(0, std::atoi(days.c_str()));
+        flagValue(args, "--sim-save", options.savePath);
+        flagValue(args, "--sim-report", options.reportPath);
+        std::string workers;
+        if (flagValue(args, "--sim-workers", workers)) options.workers = std::max(0, std::atoi(workers.c_str()));
+        exitCode = Controllers::runWorldSimulation(options);
+        return true;
+    }
+    return false;
+}
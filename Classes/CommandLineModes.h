@@ -0,0 +1,14 @@
+/**
+ * CommandLineModes：开发者命令行模式的统一入口（proj.win32 / proj.linux 的 main 共用）。
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+
+// 识别到以下参数时直接运行对应工具，不创建 AppDelegate / 窗口 / Director：
+// - --save-bench [--save-fuzz]：存档编解码基准与模糊测试，见 Game/Save/SaveBenchmark.h；
+// - --simulate-days N [--sim-save 存档路径] [--sim-report 报告路径] [--sim-workers 线程数]：
+//   无头多日模拟，见 Controllers/Systems/WorldSimulation.h。
+// args 不含程序名。识别到某个模式时返回 true，并通过 exitCode 给出进程退出码。
+bool runCommandLineMode(const std::vector<std::string>& args, int& exitCode);
@@ -7,6 +7,8 @@
 
 namespace Controllers {
 
+class ObstacleOccupancyGrid;
+
 // 环境障碍系统基类（接口约束）：
 // - 职责：定义“环境障碍唯一来源”系统的最小协作接口（挂载、生成、碰撞、受击与清空判定）。
 // - 协作对象：MapBase 用于区域/碰撞判定；上层 Controller 负责调用时机编排。
@@ -27,6 +29,10 @@ public:
                              Game::MapBase* map, int tileSize,
                              const std::function<bool(int,int)>& isSafe) = 0;
 
+    // 绑定共享占用网格：障碍生成/摧毁时登记到 grid；传 nullptr 则使用系统内部网格。
+    // 默认实现不使用网格（适用于障碍数量很少的系统）。
+    virtual void setOccupancyGrid(ObstacleOccupancyGrid* grid) { (void)grid; }
+
     // 点碰撞检测：用于玩家/实体与障碍脚底的碰撞判定。
     virtual bool collides(const cocos2d::Vec2& point, float radius, int tileSize) const = 0;
 
@@ -0,0 +1,85 @@
+#include "Controllers/Environment/ObstacleOccupancyGrid.h"
+#include "Game/GameConfig.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace cocos2d;
+
+namespace Controllers {
+
+long long ObstacleOccupancyGrid::cellKeyOf(int cc, int cr) {
+    return (static_cast<long long>(cr) << 32) | static_cast<unsigned int>(cc);
+}
+
+int ObstacleOccupancyGrid::cellCoordOf(float v) {
+    return static_cast<int>(std::floor(v / static_cast<float>(GameConfig::TILE_SIZE)));
+}
+
+void ObstacleOccupancyGrid::insert(const void* owner, const Node* node, const Rect& footRect) {
+    if (!node) return;
+    Entry e;
+    e.owner = owner;
+    e.node = node;
+    e.rect = footRect;
+    int c0 = cellCoordOf(footRect.getMinX());
+    int c1 = cellCoordOf(footRect.getMaxX());
+    int r0 = cellCoordOf(footRect.getMinY());
+    int r1 = cellCoordOf(footRect.getMaxY());
+    for (int cr = r0; cr <= r1; ++cr) {
+        for (int cc = c0; cc <= c1; ++cc) {
+            _cells[cellKeyOf(cc, cr)].push_back(e);
+        }
+    }
+}
+
+void ObstacleOccupancyGrid::remove(const Node* node, const Rect& footRect) {
+    if (!node) return;
+    int c0 = cellCoordOf(footRect.getMinX());
+    int c1 = cellCoordOf(footRect.getMaxX());
+    int r0 = cellCoordOf(footRect.getMinY());
+    int r1 = cellCoordOf(footRect.getMaxY());
+    for (int cr = r0; cr <= r1; ++cr) {
+        for (int cc = c0; cc <= c1; ++cc) {
+            auto it = _cells.find(cellKeyOf(cc, cr));
+            if (it == _cells.end()) continue;
+            auto& entries = it->second;
+            for (std::size_t i = 0; i < entries.size(); ++i) {
+                if (entries[i].node != node) continue;
+                entries[i] = entries.back();
+                entries.pop_back();
+                break;
+            }
+            if (entries.empty()) _cells.erase(it);
+        }
+    }
+}
+
+bool ObstacleOccupancyGrid::collides(const Vec2& p, float radius, const void* owner) const {
+    if (_cells.empty()) return false;
+    float r2 = radius * radius;
+    int c0 = cellCoordOf(p.x - radius);
+    int c1 = cellCoordOf(p.x + radius);
+    int r0 = cellCoordOf(p.y - radius);
+    int r1 = cellCoordOf(p.y + radius);
+    for (int cr = r0; cr <= r1; ++cr) {
+        for (int cc = c0; cc <= c1; ++cc) {
+            auto it = _cells.find(cellKeyOf(cc, cr));
+            if (it == _cells.end()) continue;
+            for (const auto& e : it->second) {
+                if (owner && e.owner != owner) continue;
+                float cx = std::max(e.rect.getMinX(), std::min(p.x, e.rect.getMaxX()));
+                float cy = std::max(e.rect.getMinY(), std::min(p.y, e.rect.getMaxY()));
+                float dx = p.x - cx;
+                float dy = p.y - cy;
+                if (dx*dx + dy*dy <= r2) return true;
+            }
+        }
+    }
+    return false;
+}
+
+void ObstacleOccupancyGrid::clear() {
+    _cells.clear();
+}
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "cocos2d.h"
+#include <unordered_map>
+#include <vector>
+
+namespace Controllers {
+
+// 环境障碍占用网格：
+// - 职责：按 TILE_SIZE 大小的世界格子索引障碍脚底矩形，碰撞检测只检查探测半径覆盖的少数格子，
+//   与障碍总数无关。
+// - 协作对象：Tree/Rock/Weed 等系统在生成/摧毁时登记/注销；地图控制器可直接整体查询。
+// - 每条记录带有 owner（登记它的系统），便于各系统只检测自己的障碍。
+class ObstacleOccupancyGrid {
+public:
+    // 登记一个障碍的脚底矩形；node 作为注销时的身份标识。
+    void insert(const void* owner, const cocos2d::Node* node, const cocos2d::Rect& footRect);
+    // 注销障碍：footRect 需与登记时一致（障碍为静态，不会移动）。
+    void remove(const cocos2d::Node* node, const cocos2d::Rect& footRect);
+    // 圆与脚底矩形相交检测；owner 非空时只检测该系统登记的障碍。
+    bool collides(const cocos2d::Vec2& p, float radius, const void* owner = nullptr) const;
+    void clear();
+    bool empty() const { return _cells.empty(); }
+
+private:
+    struct Entry {
+        const void* owner = nullptr;
+        const cocos2d::Node* node = nullptr;
+        cocos2d::Rect rect;
+    };
+
+    static long long cellKeyOf(int cc, int cr);
+    static int cellCoordOf(float v);
+
+    std::unordered_map<long long, std::vector<Entry>> _cells;
+};
+
+}
@@ -13,10 +13,13 @@ namespace Controllers {
 
 namespace {
     // 随机选择石头种类（用于生成时的外观差异）。
+    Game::RockKind randomRockKind(std::mt19937& rng) {
+        std::uniform_int_distribution<int> dist(0, 1);
+        return (dist(rng) == 0) ? Game::RockKind::Rock1 : Game::RockKind::Rock2;
+    }
     Game::RockKind randomRockKind() {
         static std::mt19937 rng{ std::random_device{}() };
-        static std::uniform_int_distribution<int> dist(0, 1);
-        return (dist(rng) == 0) ? Game::RockKind::Rock1 : Game::RockKind::Rock2;
+        return randomRockKind(rng);
     }
 }
 
@@ -45,7 +48,7 @@ bool RockSystem::spawnFromTileWithKind(int c, int r, const Vec2& tileCenter,
     rock->setPosition(footCenter);
     _root->addChild(rock, 0);
     long long key = (static_cast<long long>(r) << 32) | static_cast<unsigned long long>(c);
-    _rocks[key] = rock;
+    registerAt(key, rock);
     return true;
 }
 
@@ -75,7 +78,7 @@ void RockSystem::spawnRandom(int count, int cols, int rows,
         rock->setPosition(footCenter);
         _root->addChild(rock, 0);
         long long key = (static_cast<long long>(r) << 32) | static_cast<unsigned long long>(c);
-        _rocks[key] = rock;
+        registerAt(key, rock);
     }
 }
 
@@ -112,11 +115,10 @@ void RockSystem::generateInitial(int cols, int rows,
     }
 }
 
-int RockSystem::regrowNightlyWorldOnly(int cols, int rows,
-                                       const std::function<Game::TileType(int,int)>& getTile,
-                                       const std::function<bool(int,int)>& isOccupiedTile,
-                                       const std::function<void(int,int)>& markOccupiedTile) {
+int RockSystem::regrowNightlyWorldOnly(Game::TileGrid& tiles) {
     auto& ws = Game::globalState();
+    const int cols = tiles.cols();
+    const int rows = tiles.rows();
     if (cols <= 0 || rows <= 0) return 0;
     int area = cols * rows;
     int thresholdDiv = GameConfig::FARM_ROCK_REGEN_THRESHOLD_DIV;
@@ -127,23 +129,18 @@ int RockSystem::regrowNightlyWorldOnly(int cols, int rows,
     int target = GameConfig::FARM_NIGHTLY_REGEN_COUNT;
     if (target <= 0) return 0;
 
-    std::mt19937 rng(static_cast<unsigned>(std::time(nullptr)));
-    std::uniform_int_distribution<int> distC(0, cols - 1);
-    std::uniform_int_distribution<int> distR(0, rows - 1);
+    std::mt19937 rng(Game::nightlySeed(ws, Game::NightlyStream::Rocks));
 
     int created = 0;
-    int attempts = 0;
-    int maxAttempts = std::max(target * 30, 64);
-    while (created < target && attempts < maxAttempts) {
-        attempts++;
-        int c = distC(rng);
-        int r = distR(rng);
-        if (c < 0 || r < 0 || c >= cols || r >= rows) continue;
-        if (getTile && getTile(c, r) != Game::TileType::Soil) continue;
-        if (isOccupiedTile && isOccupiedTile(c, r)) continue;
-        auto kind = randomRockKind();
+    const Game::FreeTileSet& freeSoil = tiles.freeSoil();
+    while (created < target && !freeSoil.empty()) {
+        std::uniform_int_distribution<std::size_t> pick(0, freeSoil.size() - 1);
+        int idx = freeSoil.at(pick(rng));
+        int c = idx % cols;
+        int r = idx / cols;
+        auto kind = randomRockKind(rng);
         ws.farmRocks.push_back(Game::RockPos{c, r, kind});
-        if (markOccupiedTile) markOccupiedTile(c, r);
+        tiles.addBlocker(c, r);
         created++;
     }
     return created;
@@ -157,18 +154,34 @@ Game::Rock* RockSystem::findRockAt(int c, int r) const {
 }
 
 bool RockSystem::collides(const Vec2& p, float radius, int) const {
-    float r2 = radius * radius;
-    for (const auto& pair : _rocks) {
-        Game::Rock* rock = pair.second;
-        if (!rock) continue;
-        Rect rect = rock->footRect();
-        float cx = std::max(rect.getMinX(), std::min(p.x, rect.getMaxX()));
-        float cy = std::max(rect.getMinY(), std::min(p.y, rect.getMaxY()));
-        float dx = p.x - cx;
-        float dy = p.y - cy;
-        if (dx*dx + dy*dy <= r2) return true;
+    if (_rocks.empty()) return false;
+    return occupancy().collides(p, radius, this);
+}
+
+void RockSystem::setOccupancyGrid(ObstacleOccupancyGrid* grid) {
+    ObstacleOccupancyGrid& from = occupancy();
+    ObstacleOccupancyGrid* to = grid ? grid : &_localGrid;
+    if (&from != to) {
+        for (const auto& kv : _rocks) {
+            if (!kv.second) continue;
+            Rect rect = kv.second->footRect();
+            from.remove(kv.second, rect);
+            to->insert(this, kv.second, rect);
+        }
     }
-    return false;
+    _grid = grid;
+}
+
+void RockSystem::registerAt(long long key, Game::Rock* rock) {
+    auto it = _rocks.find(key);
+    if (it != _rocks.end() && it->second) {
+        occupancy().remove(it->second, it->second->footRect());
+    }
+    _rocks[key] = rock;
+    if (!rock) return;
+    // 静态障碍不会移动：ZOrder 只在生成时按脚底 Y 设置一次。
+    rock->setLocalZOrder(static_cast<int>(-rock->getPositionY()));
+    occupancy().insert(this, rock, rock->footRect());
 }
 
 bool RockSystem::damageAt(int c, int r, int amount,
@@ -179,16 +192,18 @@ bool RockSystem::damageAt(int c, int r, int amount,
     rock->applyDamage(amount);
     if (rock->dead()) {
         long long k = (static_cast<long long>(r) << 32) | static_cast<unsigned long long>(c);
+        occupancy().remove(rock, rock->footRect());
         _rocks.erase(k);
         {
             auto& ws = Game::globalState();
             auto& v = ws.farmRocks;
-            v.erase(
-                std::remove_if(v.begin(), v.end(), [c, r](const Game::RockPos& rp) {
-                    return rp.c == c && rp.r == r;
-                }),
-                v.end()
-            );
+            auto removed = std::remove_if(v.begin(), v.end(), [c, r](const Game::RockPos& rp) {
+                return rp.c == c && rp.r == r;
+            });
+            // 注销占用：被移除的条目都位于 (c, r)；remove_if 之后尾部元素的值未指定，不能读取
+            // 该格子若变回无障碍的土壤，会重新进入空闲土壤集合
+            for (auto n = v.end() - removed; n > 0; --n) ws.farmTiles.removeBlocker(c, r);
+            v.erase(removed, v.end());
         }
         if (setTile) setTile(c, r, Game::TileType::Soil);
         rock->playDestructionAnimation([rock, c, r, spawnDrop]{
@@ -200,12 +215,6 @@ bool RockSystem::damageAt(int c, int r, int amount,
     return true;
 }
 
-void RockSystem::sortRocks() {
-    for (auto& kv : _rocks) {
-        if (kv.second) kv.second->setLocalZOrder(static_cast<int>(-kv.second->getPositionY()));
-    }
-}
-
 bool RockSystem::isEmpty() const {
     return _rocks.empty();
 }
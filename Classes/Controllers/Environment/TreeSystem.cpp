@@ -13,10 +13,13 @@ namespace Controllers {
 
 namespace {
     // 随机选择树木种类（用于生成时的外观差异）。
+    Game::TreeKind randomTreeKind(std::mt19937& rng) {
+        std::uniform_int_distribution<int> dist(0, 1);
+        return (dist(rng) == 0) ? Game::TreeKind::Tree1 : Game::TreeKind::Tree2;
+    }
     Game::TreeKind randomTreeKind() {
         static std::mt19937 rng{ std::random_device{}() };
-        static std::uniform_int_distribution<int> dist(0, 1);
-        return (dist(rng) == 0) ? Game::TreeKind::Tree1 : Game::TreeKind::Tree2;
+        return randomTreeKind(rng);
     }
 }
 
@@ -47,7 +50,7 @@ bool TreeSystem::spawnFromTileWithKind(int c, int r, const Vec2& tileCenter,
     tree->setPosition(footCenter);
     _root->addChild(tree, 0);
     long long key = (static_cast<long long>(r) << 32) | static_cast<unsigned long long>(c);
-    _trees[key] = tree;
+    registerAt(key, tree);
     return true;
 }
 
@@ -79,7 +82,7 @@ void TreeSystem::spawnRandom(int count, int cols, int rows,
         tree->setPosition(footCenter);
         _root->addChild(tree, 0);
         long long key = (static_cast<long long>(r) << 32) | static_cast<unsigned long long>(c);
-        _trees[key] = tree;
+        registerAt(key, tree);
     }
 }
 
@@ -116,11 +119,10 @@ void TreeSystem::generateInitial(int cols, int rows,
     }
 }
 
-int TreeSystem::regrowNightlyWorldOnly(int cols, int rows,
-                                      const std::function<Game::TileType(int,int)>& getTile,
-                                      const std::function<bool(int,int)>& isOccupiedTile,
-                                      const std::function<void(int,int)>& markOccupiedTile) {
+int TreeSystem::regrowNightlyWorldOnly(Game::TileGrid& tiles) {
     auto& ws = Game::globalState();
+    const int cols = tiles.cols();
+    const int rows = tiles.rows();
     if (cols <= 0 || rows <= 0) return 0;
     int area = cols * rows;
     int thresholdDiv = GameConfig::FARM_TREE_REGEN_THRESHOLD_DIV;
@@ -131,23 +133,18 @@ int TreeSystem::regrowNightlyWorldOnly(int cols, int rows,
     int target = GameConfig::FARM_NIGHTLY_REGEN_COUNT;
     if (target <= 0) return 0;
 
-    std::mt19937 rng(static_cast<unsigned>(std::time(nullptr)));
-    std::uniform_int_distribution<int> distC(0, cols - 1);
-    std::uniform_int_distribution<int> distR(0, rows - 1);
+    std::mt19937 rng(Game::nightlySeed(ws, Game::NightlyStream::Trees));
 
     int created = 0;
-    int attempts = 0;
-    int maxAttempts = std::max(target * 30, 64);
-    while (created < target && attempts < maxAttempts) {
-        attempts++;
-        int c = distC(rng);
-        int r = distR(rng);
-        if (c < 0 || r < 0 || c >= cols || r >= rows) continue;
-        if (getTile && getTile(c, r) != Game::TileType::Soil) continue;
-        if (isOccupiedTile && isOccupiedTile(c, r)) continue;
-        auto kind = randomTreeKind();
+    const Game::FreeTileSet& freeSoil = tiles.freeSoil();
+    while (created < target && !freeSoil.empty()) {
+        std::uniform_int_distribution<std::size_t> pick(0, freeSoil.size() - 1);
+        int idx = freeSoil.at(pick(rng));
+        int c = idx % cols;
+        int r = idx / cols;
+        auto kind = randomTreeKind(rng);
         ws.farmTrees.push_back(Game::TreePos{c, r, kind});
-        if (markOccupiedTile) markOccupiedTile(c, r);
+        tiles.addBlocker(c, r);
         created++;
     }
     return created;
@@ -160,20 +157,35 @@ Game::Tree* TreeSystem::findTreeAt(int c, int r) const {
     return nullptr;
 }
 
-bool TreeSystem::collides(const Vec2& p, float radius, int /*tileSize*/) const {
-    float r2 = radius * radius;
-    for (const auto& pair : _trees) {
-        Game::Tree* tree = pair.second;
-        if (!tree) continue;
-        
-        Rect rect = tree->footRect();
-        float cx = std::max(rect.getMinX(), std::min(p.x, rect.getMaxX()));
-        float cy = std::max(rect.getMinY(), std::min(p.y, rect.getMaxY()));
-        float dx = p.x - cx;
-        float dy = p.y - cy;
-        if (dx*dx + dy*dy <= r2) return true;
+bool TreeSystem::collides(const Vec2& p, float radius, int) const {
+    if (_trees.empty()) return false;
+    return occupancy().collides(p, radius, this);
+}
+
+void TreeSystem::setOccupancyGrid(ObstacleOccupancyGrid* grid) {
+    ObstacleOccupancyGrid& from = occupancy();
+    ObstacleOccupancyGrid* to = grid ? grid : &_localGrid;
+    if (&from != to) {
+        for (const auto& kv : _trees) {
+            if (!kv.second) continue;
+            Rect rect = kv.second->footRect();
+            from.remove(kv.second, rect);
+            to->insert(this, kv.second, rect);
+        }
     }
-    return false;
+    _grid = grid;
+}
+
+void TreeSystem::registerAt(long long key, Game::Tree* tree) {
+    auto it = _trees.find(key);
+    if (it != _trees.end() && it->second) {
+        occupancy().remove(it->second, it->second->footRect());
+    }
+    _trees[key] = tree;
+    if (!tree) return;
+    // 静态障碍不会移动：ZOrder 只在生成时按脚底 Y 设置一次。
+    tree->setLocalZOrder(static_cast<int>(-tree->getPositionY()));
+    occupancy().insert(this, tree, tree->footRect());
 }
 
 bool TreeSystem::damageAt(int c, int r, int amount,
@@ -184,16 +196,18 @@ bool TreeSystem::damageAt(int c, int r, int amount,
     t->applyDamage(amount);
     if (t->dead()) {
         long long k = (static_cast<long long>(r) << 32) | static_cast<unsigned long long>(c);
+        occupancy().remove(t, t->footRect());
         _trees.erase(k);
         {
             auto& ws = Game::globalState();
             auto& v = ws.farmTrees;
-            v.erase(
-                std::remove_if(v.begin(), v.end(), [c, r](const Game::TreePos& tp) {
-                    return tp.c == c && tp.r == r;
-                }),
-                v.end()
-            );
+            auto removed = std::remove_if(v.begin(), v.end(), [c, r](const Game::TreePos& tp) {
+                return tp.c == c && tp.r == r;
+            });
+            // 注销占用：被移除的条目都位于 (c, r)；remove_if 之后尾部元素的值未指定，不能读取
+            // 该格子若变回无障碍的土壤，会重新进入空闲土壤集合
+            for (auto n = v.end() - removed; n > 0; --n) ws.farmTiles.removeBlocker(c, r);
+            v.erase(removed, v.end());
         }
         if (setTile) setTile(c, r, Game::TileType::Soil);
         t->playDestructionAnimation([t, c, r, spawnDrop]{
@@ -205,16 +219,12 @@ bool TreeSystem::damageAt(int c, int r, int amount,
     return true;
 }
 
-void TreeSystem::sortTrees() {
+void TreeSystem::refreshSeason() {
     int seasonIndex = Game::globalState().seasonIndex;
-    if (_cachedSeasonIndex != seasonIndex) {
-        _cachedSeasonIndex = seasonIndex;
-        for (auto& kv : _trees) {
-            if (kv.second) kv.second->setSeasonIndex(seasonIndex);
-        }
-    }
+    if (_cachedSeasonIndex == seasonIndex) return;
+    _cachedSeasonIndex = seasonIndex;
     for (auto& kv : _trees) {
-        if (kv.second) kv.second->setLocalZOrder(static_cast<int>(-kv.second->getPositionY()));
+        if (kv.second) kv.second->setSeasonIndex(seasonIndex);
     }
 }
 
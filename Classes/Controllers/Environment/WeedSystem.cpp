@@ -29,7 +29,7 @@ bool WeedSystem::spawnFromTile(int c, int r, const Vec2& tileCenter,
     weed->setPosition(footCenter);
     _root->addChild(weed, 0);
     long long key = (static_cast<long long>(r) << 32) | static_cast<unsigned long long>(c);
-    _weeds[key] = weed;
+    registerAt(key, weed);
     return true;
 }
 
@@ -57,7 +57,7 @@ void WeedSystem::spawnRandom(int count, int cols, int rows,
         weed->setPosition(footCenter);
         _root->addChild(weed, 0);
         long long key = (static_cast<long long>(r) << 32) | static_cast<unsigned long long>(c);
-        _weeds[key] = weed;
+        registerAt(key, weed);
     }
 }
 
@@ -93,11 +93,10 @@ void WeedSystem::generateInitial(int cols, int rows,
     }
 }
 
-int WeedSystem::regrowNightlyWorldOnly(int cols, int rows,
-                                       const std::function<Game::TileType(int,int)>& getTile,
-                                       const std::function<bool(int,int)>& isOccupiedTile,
-                                       const std::function<void(int,int)>& markOccupiedTile) {
+int WeedSystem::regrowNightlyWorldOnly(Game::TileGrid& tiles) {
     auto& ws = Game::globalState();
+    const int cols = tiles.cols();
+    const int rows = tiles.rows();
     if (cols <= 0 || rows <= 0) return 0;
     int area = cols * rows;
     int thresholdDiv = GameConfig::FARM_WEED_REGEN_THRESHOLD_DIV;
@@ -108,22 +107,17 @@ int WeedSystem::regrowNightlyWorldOnly(int cols, int rows,
     int target = GameConfig::FARM_NIGHTLY_REGEN_COUNT;
     if (target <= 0) return 0;
 
-    std::mt19937 rng(static_cast<unsigned>(std::time(nullptr)));
-    std::uniform_int_distribution<int> distC(0, cols - 1);
-    std::uniform_int_distribution<int> distR(0, rows - 1);
+    std::mt19937 rng(Game::nightlySeed(ws, Game::NightlyStream::Weeds));
 
     int created = 0;
-    int attempts = 0;
-    int maxAttempts = std::max(target * 30, 64);
-    while (created < target && attempts < maxAttempts) {
-        attempts++;
-        int c = distC(rng);
-        int r = distR(rng);
-        if (c < 0 || r < 0 || c >= cols || r >= rows) continue;
-        if (getTile && getTile(c, r) != Game::TileType::Soil) continue;
-        if (isOccupiedTile && isOccupiedTile(c, r)) continue;
+    const Game::FreeTileSet& freeSoil = tiles.freeSoil();
+    while (created < target && !freeSoil.empty()) {
+        std::uniform_int_distribution<std::size_t> pick(0, freeSoil.size() - 1);
+        int idx = freeSoil.at(pick(rng));
+        int c = idx % cols;
+        int r = idx / cols;
         ws.farmWeeds.push_back(Game::WeedPos{c, r});
-        if (markOccupiedTile) markOccupiedTile(c, r);
+        tiles.addBlocker(c, r);
         created++;
     }
     return created;
@@ -137,18 +131,34 @@ Game::Weed* WeedSystem::findWeedAt(int c, int r) const {
 }
 
 bool WeedSystem::collides(const Vec2& p, float radius, int) const {
-    float r2 = radius * radius;
-    for (const auto& pair : _weeds) {
-        Game::Weed* weed = pair.second;
-        if (!weed) continue;
-        Rect rect = weed->footRect();
-        float cx = std::max(rect.getMinX(), std::min(p.x, rect.getMaxX()));
-        float cy = std::max(rect.getMinY(), std::min(p.y, rect.getMaxY()));
-        float dx = p.x - cx;
-        float dy = p.y - cy;
-        if (dx*dx + dy*dy <= r2) return true;
+    if (_weeds.empty()) return false;
+    return occupancy().collides(p, radius, this);
+}
+
+void WeedSystem::setOccupancyGrid(ObstacleOccupancyGrid* grid) {
+    ObstacleOccupancyGrid& from = occupancy();
+    ObstacleOccupancyGrid* to = grid ? grid : &_localGrid;
+    if (&from != to) {
+        for (const auto& kv : _weeds) {
+            if (!kv.second) continue;
+            Rect rect = kv.second->footRect();
+            from.remove(kv.second, rect);
+            to->insert(this, kv.second, rect);
+        }
     }
-    return false;
+    _grid = grid;
+}
+
+void WeedSystem::registerAt(long long key, Game::Weed* weed) {
+    auto it = _weeds.find(key);
+    if (it != _weeds.end() && it->second) {
+        occupancy().remove(it->second, it->second->footRect());
+    }
+    _weeds[key] = weed;
+    if (!weed) return;
+    // 静态障碍不会移动：ZOrder 只在生成时按脚底 Y 设置一次。
+    weed->setLocalZOrder(static_cast<int>(-weed->getPositionY()));
+    occupancy().insert(this, weed, weed->footRect());
 }
 
 bool WeedSystem::damageAt(int c, int r, int amount,
@@ -161,16 +171,18 @@ bool WeedSystem::damageAt(int c, int r, int amount,
     if (!weed) return false;
     weed->applyDamage(amount);
     if (weed->dead()) {
+        occupancy().remove(weed, weed->footRect());
         _weeds.erase(k);
         {
             auto& ws = Game::globalState();
             auto& v = ws.farmWeeds;
-            v.erase(
-                std::remove_if(v.begin(), v.end(), [c, r](const Game::WeedPos& wp) {
-                    return wp.c == c && wp.r == r;
-                }),
-                v.end()
-            );
+            auto removed = std::remove_if(v.begin(), v.end(), [c, r](const Game::WeedPos& wp) {
+                return wp.c == c && wp.r == r;
+            });
+            // 注销占用：被移除的条目都位于 (c, r)；remove_if 之后尾部元素的值未指定，不能读取
+            // 该格子若变回无障碍的土壤，会重新进入空闲土壤集合
+            for (auto n = v.end() - removed; n > 0; --n) ws.farmTiles.removeBlocker(c, r);
+            v.erase(removed, v.end());
         }
         weed->playDestructionAnimation([weed, c, r, spawnDrop]{
             if (spawnDrop) spawnDrop(c, r, static_cast<int>(Game::ItemType::Fiber));
@@ -185,12 +197,6 @@ bool WeedSystem::isEmpty() const {
     return _weeds.empty();
 }
 
-void WeedSystem::sortWeeds() {
-    for (auto& kv : _weeds) {
-        if (kv.second) kv.second->setLocalZOrder(static_cast<int>(-kv.second->getPositionY()));
-    }
-}
-
 std::vector<Game::WeedPos> WeedSystem::getAllWeedTiles() const {
     std::vector<Game::WeedPos> out;
     out.reserve(_weeds.size());
@@ -6,7 +6,9 @@
 #include "Game/EnvironmentObstacle/Weed.h"
 #include "Game/Map/MapBase.h"
 #include "Game/Tile.h"
+#include "Game/TileGrid.h"
 #include "Controllers/Environment/EnvironmentObstacleSystemBase.h"
+#include "Controllers/Environment/ObstacleOccupancyGrid.h"
 
 namespace Controllers {
 
@@ -36,16 +38,18 @@ public:
                          const std::function<bool(int,int)>& isOccupiedTile,
                          const std::function<void(int,int)>& markOccupiedTile);
 
-    // 夜间补充生成：当杂草数量低于阈值时，向 WorldState 追加生成若干丛杂草（不创建可视化）。
-    static int regrowNightlyWorldOnly(int cols, int rows,
-                                      const std::function<Game::TileType(int,int)>& getTile,
-                                      const std::function<bool(int,int)>& isOccupiedTile,
-                                      const std::function<void(int,int)>& markOccupiedTile);
+    // 夜间补充生成：当杂草数量低于阈值时，从 tiles 的空闲土壤集合中抽取位置，向 WorldState 追加生成若干丛杂草
+    // （不创建可视化）并登记占用。恰好抽取 min(目标数, 空闲格子数) 次，不做拒绝重试。
+    // 位置取自 Game::nightlySeed 派生的当日随机流，同一存档同一天结果一致。
+    static int regrowNightlyWorldOnly(Game::TileGrid& tiles);
 
     // 查找指定瓦片坐标的杂草节点（在线：返回运行时节点指针；未找到返回 nullptr）。
     Game::Weed* findWeedAt(int c, int r) const;
 
-    // 点碰撞检测：用于玩家/实体与杂草的脚底碰撞判定。
+    // 绑定共享占用网格：已存在的杂草会迁移到新网格。
+    void setOccupancyGrid(ObstacleOccupancyGrid* grid) override;
+
+    // 点碰撞检测（只检查探测半径覆盖的占用格子）：用于玩家/实体与杂草的脚底碰撞判定。
     bool collides(const cocos2d::Vec2& point, float radius, int tileSize) const override;
 
     // 对指定瓦片上的杂草造成伤害；若摧毁则播放动画、生成掉落，并从 WorldState 清理。
@@ -56,14 +60,19 @@ public:
     // 是否为空：用于地图初始化时判断是否需要从存档/生成逻辑恢复。
     bool isEmpty() const override;
 
-    // 每帧排序：维护 ZOrder（按 Y 值排序以实现遮挡关系）。
-    void sortWeeds();
     // 获取当前系统内所有杂草的瓦片坐标（用于写回 WorldState）。
     std::vector<Game::WeedPos> getAllWeedTiles() const;
 
 private:
+    // 记录瓦片上的杂草并登记到占用网格（覆盖同一瓦片的旧记录时先注销旧记录）。
+    void registerAt(long long key, Game::Weed* weed);
+    ObstacleOccupancyGrid& occupancy() { return _grid ? *_grid : _localGrid; }
+    const ObstacleOccupancyGrid& occupancy() const { return _grid ? *_grid : _localGrid; }
+
     cocos2d::Node* _root = nullptr;
     std::unordered_map<long long, Game::Weed*> _weeds;
+    ObstacleOccupancyGrid* _grid = nullptr;
+    ObstacleOccupancyGrid _localGrid;
 };
 
 }
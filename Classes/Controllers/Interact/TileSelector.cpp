@@ -4,19 +4,10 @@
 
 namespace {
 
-struct TileCandidate {
-    int c;
-    int r;
-};
-
-int buildFront3x3Candidates(int pc,
-                            int pr,
-                            const cocos2d::Vec2& dir,
-                            const std::function<bool(int,int)>& inBounds,
-                            TileCandidate* outCands,
-                            int maxOut) {
-    int dc = 0;
-    int dr = 0;
+// 由朝向向量得到四方向单位步长；朝向近似为零时默认向下。
+void facingStep(const cocos2d::Vec2& dir, int& dc, int& dr) {
+    dc = 0;
+    dr = 0;
     if (std::abs(dir.x) > std::abs(dir.y)) {
         dc = (dir.x > 0.1f) ? 1 : ((dir.x < -0.1f) ? -1 : 0);
     } else {
@@ -25,15 +16,23 @@ int buildFront3x3Candidates(int pc,
     if (dc == 0 && dr == 0) {
         dr = -1;
     }
+}
 
+int buildFront3x3Candidates(int pc,
+                            int pr,
+                            int dc,
+                            int dr,
+                            const std::function<bool(int,int)>& inBounds,
+                            std::pair<int,int>* outCands,
+                            int maxOut) {
     int count = 0;
     auto pushUnique = [&](int c, int r) {
         if (count >= maxOut) return;
         if (inBounds && !inBounds(c, r)) return;
         for (int i = 0; i < count; ++i) {
-            if (outCands[i].c == c && outCands[i].r == r) return;
+            if (outCands[i].first == c && outCands[i].second == r) return;
         }
-        outCands[count++] = TileCandidate{c, r};
+        outCands[count++] = std::make_pair(c, r);
     };
 
     pushUnique(pc, pr);
@@ -53,18 +52,17 @@ int buildFront3x3Candidates(int pc,
 
 namespace Controllers {
 
-std::pair<int,int> TileSelector::selectForwardTile(
+bool TileSelector::computeForwardFan(
     const cocos2d::Vec2& playerPos,
     const cocos2d::Vec2& lastDir,
     const std::function<void(const cocos2d::Vec2&, int&, int&)>& worldToTileIndex,
     const std::function<bool(int,int)>& inBounds,
     float tileSize,
-    bool hasLastClick,
-    const cocos2d::Vec2& lastClickWorldPos,
-    const std::function<cocos2d::Vec2(int,int)>& tileToWorld)
+    ForwardFan& inout)
 {
     int pc = 0;
     int pr = 0;
+    // 玩家世界坐标略微向下偏移（贴近脚底）后再换算瓦片索引。
     if (worldToTileIndex) {
         cocos2d::Vec2 basisPos = playerPos;
         if (tileSize > 0.0f) {
@@ -76,82 +74,135 @@ std::pair<int,int> TileSelector::selectForwardTile(
     if (dir.lengthSquared() < 0.0001f) {
         dir = cocos2d::Vec2(0, -1);
     }
-    TileCandidate cands[10];
-    int count = buildFront3x3Candidates(pc, pr, dir, inBounds, cands, 10);
-    if (count <= 0) return { pc, pr };
+    int dc = 0;
+    int dr = 0;
+    facingStep(dir, dc, dr);
+    if (inout.valid && inout.pc == pc && inout.pr == pr && inout.dc == dc && inout.dr == dr) {
+        return false;
+    }
+    inout.valid = true;
+    inout.pc = pc;
+    inout.pr = pr;
+    inout.dc = dc;
+    inout.dr = dr;
+    inout.count = buildFront3x3Candidates(pc, pr, dc, dr, inBounds, inout.tiles, ForwardFan::kMaxTiles);
+    return true;
+}
+
+std::pair<int,int> TileSelector::selectForwardTile(
+    const ForwardFan& fan,
+    const std::function<bool(int,int)>& inBounds,
+    float tileSize,
+    bool hasLastClick,
+    const cocos2d::Vec2& lastClickWorldPos,
+    const std::function<cocos2d::Vec2(int,int)>& tileToWorld)
+{
+    if (fan.count <= 0) return { fan.pc, fan.pr };
 
     if (hasLastClick && tileToWorld && tileSize > 0.0f) {
         cocos2d::Vec2 click = lastClickWorldPos;
         float half = tileSize * 0.5f;
-        for (int i = 0; i < count; ++i) {
-            cocos2d::Vec2 center = tileToWorld(cands[i].c, cands[i].r);
+        for (int i = 0; i < fan.count; ++i) {
+            cocos2d::Vec2 center = tileToWorld(fan.tiles[i].first, fan.tiles[i].second);
             cocos2d::Rect rect(center.x - half, center.y - half, tileSize, tileSize);
             if (rect.containsPoint(click)) {
-                return { cands[i].c, cands[i].r };
+                return fan.tiles[i];
             }
         }
         return { -1, -1 };
     }
 
-    int dc = 0;
-    int dr = 0;
-    if (std::abs(dir.x) > std::abs(dir.y)) {
-        dc = (dir.x > 0.1f) ? 1 : ((dir.x < -0.1f) ? -1 : 0);
-    } else {
-        dr = (dir.y > 0.1f) ? 1 : ((dir.y < -0.1f) ? -1 : 0);
-    }
-    if (dc == 0 && dr == 0) {
-        dr = -1;
-    }
-
-    int fc = pc + dc;
-    int fr = pr + dr;
+    int fc = fan.pc + fan.dc;
+    int fr = fan.pr + fan.dr;
     if (!inBounds || inBounds(fc, fr)) {
         return { fc, fr };
     }
-    return { pc, pr };
+    return { fan.pc, fan.pr };
 }
 
-void TileSelector::drawFanCursor(
-    cocos2d::DrawNode* cursor,
+std::pair<int,int> TileSelector::selectForwardTile(
     const cocos2d::Vec2& playerPos,
     const cocos2d::Vec2& lastDir,
     const std::function<void(const cocos2d::Vec2&, int&, int&)>& worldToTileIndex,
     const std::function<bool(int,int)>& inBounds,
-    const std::function<cocos2d::Vec2(int,int)>& tileToWorld,
-    float tileSize)
+    float tileSize,
+    bool hasLastClick,
+    const cocos2d::Vec2& lastClickWorldPos,
+    const std::function<cocos2d::Vec2(int,int)>& tileToWorld)
 {
-    if (!cursor) return;
-    cursor->clear();
-    int pc = 0;
-    int pr = 0;
-    if (worldToTileIndex) {
-        cocos2d::Vec2 basisPos = playerPos;
-        if (tileSize > 0.0f) {
-            basisPos = playerPos + cocos2d::Vec2(0, -tileSize * 0.75f);
+    ForwardFan fan;
+    computeForwardFan(playerPos, lastDir, worldToTileIndex, inBounds, tileSize, fan);
+    return selectForwardTile(fan, inBounds, tileSize, hasLastClick, lastClickWorldPos, tileToWorld);
+}
+
+FanCursor::~FanCursor() {
+    reset();
+}
+
+void FanCursor::reset() {
+    for (auto* quad : _quads) {
+        if (!quad) continue;
+        quad->removeFromParent();
+        quad->release();
+    }
+    _quads.clear();
+    _parent = nullptr;
+    _quadSize = 0.0f;
+    _shown = false;
+}
+
+void FanCursor::update(cocos2d::Node* parent,
+                       const ForwardFan& fan,
+                       const std::function<cocos2d::Vec2(int,int)>& tileToWorld,
+                       float tileSize)
+{
+    if (!parent || !tileToWorld) return;
+    if (_quadSize != tileSize) {
+        // 瓦片尺寸变化：方框需按新尺寸重画。
+        reset();
+        _quadSize = tileSize;
+    }
+    if (_parent != parent) {
+        for (auto* quad : _quads) {
+            quad->removeFromParent();
+            parent->addChild(quad);
         }
-        worldToTileIndex(basisPos, pc, pr);
+        _parent = parent;
+        _shown = false;
     }
-    cocos2d::Vec2 dir = lastDir;
-    if (dir.lengthSquared() < 0.0001f) {
-        dir = cocos2d::Vec2(0, -1);
+    if (_shown && _pc == fan.pc && _pr == fan.pr && _dc == fan.dc && _dr == fan.dr && _count == fan.count) {
+        return;
     }
-    TileCandidate cands[10];
-    int count = buildFront3x3Candidates(pc, pr, dir, inBounds, cands, 10);
-    if (count <= 0) return;
-    float s = tileSize;
-    for (int i = 0; i < count; ++i) {
-        int c = cands[i].c;
-        int r = cands[i].r;
-        cocos2d::Vec2 center = tileToWorld(c, r);
-        cocos2d::Vec2 a(center.x - s * 0.5f, center.y - s * 0.5f);
-        cocos2d::Vec2 b(center.x + s * 0.5f, center.y - s * 0.5f);
-        cocos2d::Vec2 d(center.x - s * 0.5f, center.y + s * 0.5f);
-        cocos2d::Vec2 e(center.x + s * 0.5f, center.y + s * 0.5f);
-        cursor->drawLine(a, b, cocos2d::Color4F(1.f, 0.9f, 0.2f, 1.f));
-        cursor->drawLine(b, e, cocos2d::Color4F(1.f, 0.9f, 0.2f, 1.f));
-        cursor->drawLine(e, d, cocos2d::Color4F(1.f, 0.9f, 0.2f, 1.f));
-        cursor->drawLine(d, a, cocos2d::Color4F(1.f, 0.9f, 0.2f, 1.f));
+    _shown = true;
+    _pc = fan.pc;
+    _pr = fan.pr;
+    _dc = fan.dc;
+    _dr = fan.dr;
+    _count = fan.count;
+
+    float half = tileSize * 0.5f;
+    while (static_cast<int>(_quads.size()) < fan.count) {
+        auto* quad = cocos2d::DrawNode::create();
+        cocos2d::Vec2 a(-half, -half);
+        cocos2d::Vec2 b(half, -half);
+        cocos2d::Vec2 d(-half, half);
+        cocos2d::Vec2 e(half, half);
+        quad->drawLine(a, b, cocos2d::Color4F(1.f, 0.9f, 0.2f, 1.f));
+        quad->drawLine(b, e, cocos2d::Color4F(1.f, 0.9f, 0.2f, 1.f));
+        quad->drawLine(e, d, cocos2d::Color4F(1.f, 0.9f, 0.2f, 1.f));
+        quad->drawLine(d, a, cocos2d::Color4F(1.f, 0.9f, 0.2f, 1.f));
+        quad->retain();
+        parent->addChild(quad);
+        _quads.push_back(quad);
+    }
+    for (int i = 0; i < static_cast<int>(_quads.size()); ++i) {
+        auto* quad = _quads[i];
+        if (i < fan.count) {
+            quad->setPosition(tileToWorld(fan.tiles[i].first, fan.tiles[i].second));
+            quad->setVisible(true);
+        } else {
+            quad->setVisible(false);
+        }
     }
 }
 
@@ -167,31 +218,12 @@ void TileSelector::collectForwardFanTiles(
 {
     // 清空输出容器，避免残留上一次调用的结果。
     outTiles.clear();
-    int pc = 0;
-    int pr = 0;
-    // 通过回调把玩家世界坐标（略微向下偏移，贴近脚底）转换为瓦片索引。
-    if (worldToTileIndex) {
-        cocos2d::Vec2 basisPos = playerPos;
-        if (tileSize > 0.0f) {
-            basisPos = playerPos + cocos2d::Vec2(0, -tileSize * 0.75f);
-        }
-        worldToTileIndex(basisPos, pc, pr);
-    }
-    // 若最近朝向几乎为零向量，则默认使用“向上”作为朝向，保证扇形稳定。
-    cocos2d::Vec2 dir = lastDir;
-    if (dir.lengthSquared() < 0.0001f) {
-        dir = cocos2d::Vec2(0, -1);
-    }
-    // 使用内部的 buildFront3x3Candidates 统一生成“当前格 + 前方 3x3 区域”的候选列表。
-    TileCandidate cands[10];
-    int count = buildFront3x3Candidates(pc, pr, dir, inBounds, cands, 10);
-    if (count <= 0) return;
-    // 遍历候选格，根据 includeSelf 决定是否排除玩家脚下格子，并写入输出数组。
-    for (int i = 0; i < count; ++i) {
-        int c = cands[i].c;
-        int r = cands[i].r;
-
-        outTiles.emplace_back(c, r);
+    // 与目标瓦片/光标共用同一套扇形候选计算（当前格 + 前方 3x3 区域）。
+    ForwardFan fan;
+    computeForwardFan(playerPos, lastDir, worldToTileIndex, inBounds, tileSize, fan);
+    if (fan.count <= 0) return;
+    for (int i = 0; i < fan.count; ++i) {
+        outTiles.push_back(fan.tiles[i]);
     }
 }
 
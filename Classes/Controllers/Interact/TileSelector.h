@@ -7,32 +7,87 @@
 
 namespace Controllers {
 
+// 前方扇形候选：玩家脚底瓦片 + 四方向朝向 + “当前格 + 前方 3x3”候选格（最多 10 个）。
+// - 由 TileSelector::computeForwardFan 生成；脚底瓦片与朝向不变时复用上次结果。
+// - 目标瓦片选择与光标绘制共用同一份候选，避免每帧重复计算。
+struct ForwardFan {
+    static const int kMaxTiles = 10;
+    bool valid = false;
+    int pc = 0;
+    int pr = 0;
+    int dc = 0;
+    int dr = -1;
+    int count = 0;
+    std::pair<int,int> tiles[kMaxTiles];
+
+    // 使缓存失效（地图边界变化时调用，例如矿洞换层）。
+    void invalidate() { valid = false; }
+};
+
+// 扇形光标（保留模式）：
+// - 持有一小组预先画好的方框节点，只在候选格变化时移动/显隐，不再每帧 clear + 重画。
+// - 方框节点由本对象 retain，父节点被移除后也可安全重新挂接。
+class FanCursor {
+public:
+    FanCursor() = default;
+    ~FanCursor();
+    FanCursor(const FanCursor&) = delete;
+    FanCursor& operator=(const FanCursor&) = delete;
+
+    // 把 fan 的候选格显示在 parent 下；parent、候选或瓦片尺寸未变时直接返回。
+    void update(cocos2d::Node* parent,
+                const ForwardFan& fan,
+                const std::function<cocos2d::Vec2(int,int)>& tileToWorld,
+                float tileSize);
+    // 释放所有方框节点（父节点即将销毁或需要强制重建时调用）。
+    void reset();
+
+private:
+    cocos2d::Node* _parent = nullptr;
+    std::vector<cocos2d::DrawNode*> _quads;
+    float _quadSize = 0.0f;
+    bool _shown = false;
+    int _pc = 0;
+    int _pr = 0;
+    int _dc = 0;
+    int _dr = 0;
+    int _count = 0;
+};
+
 // 瓦片选择工具：
-// - 作用：根据玩家位置/朝向/最近一次点击等信息，计算工具作用的目标瓦片，并可绘制扇形光标。
+// - 作用：根据玩家位置/朝向/最近一次点击等信息，计算工具作用的目标瓦片，并提供扇形候选供光标显示。
 // - 职责边界：只提供纯计算与绘制辅助，不持有地图状态与输入状态。
 // - 主要协作对象：调用方通过回调提供 world<->tile 坐标转换与边界判断，避免耦合具体地图实现。
 class TileSelector {
 public:
-    // 选择“前方目标瓦片”：优先使用最近一次点击，否则按朝向取面前瓦片。
-    static std::pair<int,int> selectForwardTile(
+    // 计算前方扇形候选，写入 inout；脚底瓦片与朝向未变时沿用已有候选并返回 false。
+    static bool computeForwardFan(
         const cocos2d::Vec2& playerPos,
         const cocos2d::Vec2& lastDir,
         const std::function<void(const cocos2d::Vec2&, int&, int&)>& worldToTileIndex,
         const std::function<bool(int,int)>& inBounds,
         float tileSize,
+        ForwardFan& inout);
+
+    // 基于已计算的扇形选择“前方目标瓦片”：优先使用最近一次点击，否则按朝向取面前瓦片。
+    static std::pair<int,int> selectForwardTile(
+        const ForwardFan& fan,
+        const std::function<bool(int,int)>& inBounds,
+        float tileSize,
         bool hasLastClick,
         const cocos2d::Vec2& lastClickWorldPos,
         const std::function<cocos2d::Vec2(int,int)>& tileToWorld);
 
-    // 绘制扇形光标：根据朝向在前方扇形区域绘制可作用瓦片的提示。
-    static void drawFanCursor(
-        cocos2d::DrawNode* cursor,
+    // 选择“前方目标瓦片”：优先使用最近一次点击，否则按朝向取面前瓦片。
+    static std::pair<int,int> selectForwardTile(
         const cocos2d::Vec2& playerPos,
         const cocos2d::Vec2& lastDir,
         const std::function<void(const cocos2d::Vec2&, int&, int&)>& worldToTileIndex,
         const std::function<bool(int,int)>& inBounds,
-        const std::function<cocos2d::Vec2(int,int)>& tileToWorld,
-        float tileSize);
+        float tileSize,
+        bool hasLastClick,
+        const cocos2d::Vec2& lastClickWorldPos,
+        const std::function<cocos2d::Vec2(int,int)>& tileToWorld);
 
     // 收集前方扇形内的瓦片坐标列表（可选择是否包含玩家自身所在瓦片）。
     static void collectForwardFanTiles(
@@ -69,20 +69,17 @@ void FarmMapController::init() {
     _rows = static_cast<int>(_farmMap->getMapSize().height);
 
     auto &ws = Game::globalState();
-    if (ws.farmTiles.empty()) {
-        _tiles.assign(_cols * _rows, Game::TileType::Soil);
-        applyStaticNotSoilMask();
-        ws.farmTiles = _tiles;
-        ws.farmCols = _cols;
-        ws.farmRows = _rows;
-    } else {
-        // 同步已有瓦片
-        _tiles = ws.farmTiles;
-        // 如果 WorldState 中未保存尺寸（旧存档兼容），则补全
-        if (ws.farmCols == 0) ws.farmCols = _cols;
-        if (ws.farmRows == 0) ws.farmRows = _rows;
-        applyStaticNotSoilMask();
-    }
+    // 瓦片网格由 WorldState 唯一持有，控制器通过 _grid 直接读写
+    _grid = &ws.farmTiles;
+    if (_grid->empty()) {
+        _grid->reset(_cols, _rows, Game::TileType::Soil);
+    } else if ((_grid->cols() != _cols || _grid->rows() != _rows) &&
+               _grid->size() == static_cast<std::size_t>(_cols * _rows)) {
+        // 旧存档未保存尺寸：按当前地图尺寸补全
+        std::vector<Game::TileType> legacy = _grid->data();
+        _grid->assign(_cols, _rows, std::move(legacy));
+    }
+    applyStaticNotSoilMask();
 
     _cursor = DrawNode::create();
     if (_farmMap && _farmMap->getTMX()) {
@@ -168,6 +165,10 @@ void FarmMapController::init() {
     _rockSystem->attachTo(_actorsRoot);
     _weedSystem = new Controllers::WeedSystem();
     _weedSystem->attachTo(_actorsRoot);
+    _obstacleGrid.clear();
+    _treeSystem->setOccupancyGrid(&_obstacleGrid);
+    _rockSystem->setOccupancyGrid(&_obstacleGrid);
+    _weedSystem->setOccupancyGrid(&_obstacleGrid);
 
     refreshMapVisuals();
     refreshDropsVisuals();
@@ -293,6 +294,8 @@ void FarmMapController::init() {
             ws.farmWeeds = weedSystemConcrete->getAllWeedTiles();
         }
     }
+    // 障碍物列表可能在上面被整体生成/替换，按最终列表重建占用层
+    Game::syncFarmBlockers(ws);
 
     // 门口区域
     float s = static_cast<float>(GameConfig::TILE_SIZE);
@@ -306,10 +309,9 @@ void FarmMapController::init() {
 void FarmMapController::applyStaticNotSoilMask() {
     if (!_farmMap) return;
     float s = tileSize();
-    bool changed = false;
     for (int r = 0; r < _rows; ++r) {
         for (int c = 0; c < _cols; ++c) {
-            auto current = _tiles[r * _cols + c];
+            auto current = getTile(c, r);
             if (current != Game::TileType::Soil &&
                 current != Game::TileType::Tilled &&
                 current != Game::TileType::Watered) {
@@ -318,14 +320,10 @@ void FarmMapController::applyStaticNotSoilMask() {
             auto center = tileToWorld(c, r);
             Vec2 footCenter = center + Vec2(0, -s * 0.5f);
             if (_farmMap->inBuildingArea(footCenter) || _farmMap->inWallArea(footCenter)) {
-                _tiles[r * _cols + c] = Game::TileType::NotSoil;
-                changed = true;
+                _grid->set(c, r, Game::TileType::NotSoil);
             }
         }
     }
-    if (changed) {
-        Game::globalState().farmTiles = _tiles;
-    }
 }
 
 Vec2 FarmMapController::getPlayerPosition(const Vec2& playerMapLocalPos) const {
@@ -357,19 +355,9 @@ Vec2 FarmMapController::clampPosition(const Vec2& current, const Vec2& next, flo
     if (_farmMap) {
         Vec2 footX = tryX + Vec2(0, -s * 0.5f);
         bool baseBlockedX = _farmMap->collides(footX, radius);
-        bool treeBlockedX = false;
-        bool rockBlockedX = false;
-        bool weedBlockedX = false;
-        if (_treeSystem) {
-            treeBlockedX = _treeSystem->collides(footX, radius * 0.75f, GameConfig::TILE_SIZE);
-        }
-        if (_rockSystem) {
-            rockBlockedX = _rockSystem->collides(footX, radius * 0.75f, GameConfig::TILE_SIZE);
-        }
-        if (_weedSystem) {
-            weedBlockedX = _weedSystem->collides(footX, radius * 0.75f, GameConfig::TILE_SIZE);
-        }
-        if (baseBlockedX || treeBlockedX || rockBlockedX || weedBlockedX) {
+        // 树/石头/杂草共享占用网格：一次查询只检查探测半径覆盖的格子。
+        bool obstacleBlockedX = _obstacleGrid.collides(footX, radius * 0.75f);
+        if (baseBlockedX || obstacleBlockedX) {
             tryX.x = current.x;
         }
     }
@@ -377,19 +365,8 @@ Vec2 FarmMapController::clampPosition(const Vec2& current, const Vec2& next, flo
     if (_farmMap) {
         Vec2 footY = tryY + Vec2(0, -s * 0.5f);
         bool baseBlockedY = _farmMap->collides(footY, radius);
-        bool treeBlockedY = false;
-        bool rockBlockedY = false;
-        bool weedBlockedY = false;
-        if (_treeSystem) {
-            treeBlockedY = _treeSystem->collides(footY, radius * 0.75f, GameConfig::TILE_SIZE);
-        }
-        if (_rockSystem) {
-            rockBlockedY = _rockSystem->collides(footY, radius * 0.75f, GameConfig::TILE_SIZE);
-        }
-        if (_weedSystem) {
-            weedBlockedY = _weedSystem->collides(footY, radius * 0.75f, GameConfig::TILE_SIZE);
-        }
-        if (baseBlockedY || treeBlockedY || rockBlockedY || weedBlockedY) {
+        bool obstacleBlockedY = _obstacleGrid.collides(footY, radius * 0.75f);
+        if (baseBlockedY || obstacleBlockedY) {
             tryY.y = current.y;
         }
     }
@@ -403,9 +380,7 @@ Vec2 FarmMapController::clampPosition(const Vec2& current, const Vec2& next, flo
 
 bool FarmMapController::collides(const Vec2& pos, float radius) const {
     if (_farmMap && _farmMap->collides(pos, radius)) return true;
-    if (_treeSystem && _treeSystem->collides(pos, radius, GameConfig::TILE_SIZE)) return true;
-    if (_rockSystem && _rockSystem->collides(pos, radius, GameConfig::TILE_SIZE)) return true;
-    if (_weedSystem && _weedSystem->collides(pos, radius, GameConfig::TILE_SIZE)) return true;
+    if (_obstacleGrid.collides(pos, radius)) return true;
     if (_chestController && _chestController->collides(pos)) return true;
     if (_furnaceController && _furnaceController->collides(pos)) return true;
     return false;
@@ -442,13 +417,11 @@ void FarmMapController::sortActorWithEnvironment(cocos2d::Node* actor) {
     if (!actor) return;
     float s = tileSize();
     float footY = actor->getPositionY() - s * 0.5f; // player node is at tile center; use foot for sorting
-    actor->setLocalZOrder(static_cast<int>(-footY));
+    // 树/石头/杂草的 ZOrder 在生成时已固定；这里只在角色脚底 Y 变化时重排该角色。
+    int z = static_cast<int>(-footY);
+    if (actor->getLocalZOrder() != z) actor->setLocalZOrder(z);
     auto treeSystemConcrete = static_cast<Controllers::TreeSystem*>(_treeSystem);
-    if (treeSystemConcrete) treeSystemConcrete->sortTrees();
-    auto rockSystemConcrete = static_cast<Controllers::RockSystem*>(_rockSystem);
-    if (rockSystemConcrete) rockSystemConcrete->sortRocks();
-    auto weedSystemConcrete = static_cast<Controllers::WeedSystem*>(_weedSystem);
-    if (weedSystemConcrete) weedSystemConcrete->sortWeeds();
+    if (treeSystemConcrete) treeSystemConcrete->refreshSeason();
 }
 
 cocos2d::Vec2 FarmMapController::farmMineDoorSpawnPos() const {
@@ -485,12 +458,17 @@ bool FarmMapController::inBounds(int c, int r) const {
 }
 
 std::pair<int,int> FarmMapController::targetTile(const Vec2& playerPos, const Vec2& lastDir) const {
-    return TileSelector::selectForwardTile(
+    TileSelector::computeForwardFan(
         playerPos,
         lastDir,
         [this](const Vec2& p, int& c, int& r){ worldToTileIndex(p, c, r); },
         [this](int c, int r){ return inBounds(c, r); },
         tileSize(),
+        _fan);
+    return TileSelector::selectForwardTile(
+        _fan,
+        [this](int c, int r){ return inBounds(c, r); },
+        tileSize(),
         _hasLastClick,
         _lastClickWorldPos,
         [this](int c, int r){ return tileToWorld(c, r); });
@@ -499,26 +477,36 @@ std::pair<int,int> FarmMapController::targetTile(const Vec2& playerPos, const Ve
 
 void FarmMapController::updateCursor(const Vec2& playerPos, const Vec2& lastDir) {
     if (!_cursor) return;
-    TileSelector::drawFanCursor(
-        _cursor,
+    TileSelector::computeForwardFan(
         playerPos,
         lastDir,
         [this](const Vec2& p, int& c, int& r) { worldToTileIndex(p, c, r); },
         [this](int c, int r) { return inBounds(c, r); },
-        [this](int c, int r) { return tileToWorld(c, r); },
-        tileSize());
+        tileSize(),
+        _fan);
+    _fanCursor.update(_cursor, _fan, [this](int c, int r) { return tileToWorld(c, r); }, tileSize());
 }
 
 Game::TileType FarmMapController::getTile(int c, int r) const {
-    auto t = _tiles[r * _cols + c];
-    return t;
+    return _grid->at(static_cast<std::size_t>(r * _cols + c));
 }
 
 void FarmMapController::setTile(int c, int r, Game::TileType t) {
-    _tiles[r * _cols + c] = t;
-    Game::globalState().farmTiles = _tiles;
-    // Immediately refresh visuals to reflect tile changes
-    refreshMapVisuals();
+    // 直接写入共享网格（WorldState 即时可见），仅标记该瓦片及其四邻域为脏
+    if (!_grid->set(c, r, t)) return;
+    markTileDirty(c, r);
+    if (_tileBatchDepth > 0) return;
+    flushDirtyTiles();
+}
+
+void FarmMapController::beginTileBatch() {
+    ++_tileBatchDepth;
+}
+
+void FarmMapController::commitTileBatch() {
+    if (_tileBatchDepth <= 0) return;
+    if (--_tileBatchDepth > 0) return;
+    flushDirtyTiles();
 }
 
 Vec2 FarmMapController::tileToWorld(int c, int r) const {
@@ -534,193 +522,171 @@ void FarmMapController::worldToTileIndex(const Vec2& p, int& c, int& r) const {
     r = static_cast<int>((p.y - _mapOrigin.y) / s);
 }
 
-void FarmMapController::refreshMapVisuals() {
-    if (!_tileRoot) return;
-    const bool isWinter = (Game::globalState().seasonIndex == 3);
-    const char* dirtFile = isWinter ? "hoeDirtSnow.png" : "hoeDirt.png";
-    auto* dirtTex = cocos2d::Director::getInstance()->getTextureCache()->addImage(dirtFile);
-    float s = tileSize();
-    std::unordered_set<long long> alive;
-    std::unordered_set<long long> aliveWater;
-    for (int r = 0; r < _rows; ++r) {
-        for (int c = 0; c < _cols; ++c) {
-            if (getTile(c, r) == Game::TileType::Tilled || getTile(c, r) == Game::TileType::Watered) {
-                long long key = (static_cast<long long>(r) << 32) | static_cast<unsigned long long>(c);
-                alive.insert(key);
-                cocos2d::Sprite* spr = nullptr;
-                auto it = _tileSprites.find(key);
-                if (it == _tileSprites.end()) {
-                    spr = cocos2d::Sprite::create(dirtFile);
-                    spr->setAnchorPoint(cocos2d::Vec2(0.5f, 0.5f));
-                    _tileRoot->addChild(spr, 0);
-                    _tileSprites[key] = spr;
-                } else {
-                    spr = it->second;
-                }
-                if (spr && dirtTex && spr->getTexture() != dirtTex) {
-                    spr->setTexture(dirtTex);
-                }
-                int tw = 16, th = 16;
-                bool up = false, down = false, left = false, right = false;
-                if (r + 1 < _rows) {
-                    auto t = getTile(c, r + 1);
-                    up = (t == Game::TileType::Tilled || t == Game::TileType::Watered);
-                }
-                if (r - 1 >= 0) {
-                    auto t = getTile(c, r - 1);
-                    down = (t == Game::TileType::Tilled || t == Game::TileType::Watered);
-                }
-                if (c - 1 >= 0) {
-                    auto t = getTile(c - 1, r);
-                    left = (t == Game::TileType::Tilled || t == Game::TileType::Watered);
-                }
-                if (c + 1 < _cols) {
-                    auto t = getTile(c + 1, r);
-                    right = (t == Game::TileType::Tilled || t == Game::TileType::Watered);
-                }
-                int mask = 0;
-                if (up) mask |= 1;
-                if (down) mask |= 2;
-                if (left) mask |= 4;
-                if (right) mask |= 8;
-                int rowBottom = 4;
-                int colLeft = 1;
-                switch (mask) {
-                    case 0:  rowBottom = 1; colLeft = 1; break;
-                    case 2:  rowBottom = 2; colLeft = 1; break;
-                    case 1:  rowBottom = 4; colLeft = 1; break;
-                    case 3:  rowBottom = 3; colLeft = 1; break;
-                    case 8:  rowBottom = 4; colLeft = 2; break;
-                    case 4:  rowBottom = 4; colLeft = 4; break;
-                    case 12: rowBottom = 4; colLeft = 3; break;
-                    case 10: rowBottom = 1; colLeft = 2; break;
-                    case 6:  rowBottom = 1; colLeft = 4; break;
-                    case 5:  rowBottom = 3; colLeft = 4; break;
-                    case 9:  rowBottom = 3; colLeft = 2; break;
-                    case 11: rowBottom = 2; colLeft = 2; break;
-                    case 13: rowBottom = 3; colLeft = 3; break;
-                    case 14: rowBottom = 1; colLeft = 3; break;
-                    case 7:  rowBottom = 2; colLeft = 4; break;
-                    case 15: rowBottom = 2; colLeft = 3; break;
-                    default: rowBottom = 1; colLeft = 1; break;
-                }
-                float texW = spr->getTexture() ? spr->getTexture()->getContentSize().width : 0.0f;
-                float texH = spr->getTexture() ? spr->getTexture()->getContentSize().height : 0.0f;
-                int totalRows = texH > 0 ? static_cast<int>(texH / th) : 1;
-                int colIndex0 = colLeft - 1;
-                int rowIndexFromTop0 = totalRows - rowBottom;
-                if (rowIndexFromTop0 < 0) rowIndexFromTop0 = 0;
-                float x = static_cast<float>(colIndex0 * tw);
-                float y = texH - static_cast<float>((rowIndexFromTop0 + 1) * th);
-                spr->setTextureRect(cocos2d::Rect(x, y, static_cast<float>(tw), static_cast<float>(th)));
-                auto pos = tileToWorld(c, r);
-                spr->setPosition(pos);
-                spr->setVisible(true);
-
-                if (getTile(c, r) == Game::TileType::Watered) {
-                    aliveWater.insert(key);
-                    cocos2d::Sprite* sprW = nullptr;
-                    auto itW = _waterSprites.find(key);
-                    if (itW == _waterSprites.end()) {
-                        sprW = cocos2d::Sprite::create(dirtFile);
-                        sprW->setAnchorPoint(cocos2d::Vec2(0.5f, 0.5f));
-                        _tileRoot->addChild(sprW, 1);
-                        _waterSprites[key] = sprW;
-                    } else {
-                        sprW = itW->second;
-                    }
-                    if (sprW && dirtTex && sprW->getTexture() != dirtTex) {
-                        sprW->setTexture(dirtTex);
-                    }
-                    bool upW = false, downW = false, leftW = false, rightW = false;
-                    if (r + 1 < _rows) {
-                        auto t = getTile(c, r + 1);
-                        upW = (t == Game::TileType::Watered);
-                    }
-                    if (r - 1 >= 0) {
-                        auto t = getTile(c, r - 1);
-                        downW = (t == Game::TileType::Watered);
-                    }
-                    if (c - 1 >= 0) {
-                        auto t = getTile(c - 1, r);
-                        leftW = (t == Game::TileType::Watered);
-                    }
-                    if (c + 1 < _cols) {
-                        auto t = getTile(c + 1, r);
-                        rightW = (t == Game::TileType::Watered);
-                    }
-                    int maskW = 0;
-                    if (upW) maskW |= 1;
-                    if (downW) maskW |= 2;
-                    if (leftW) maskW |= 4;
-                    if (rightW) maskW |= 8;
-                    int rowBottomW = 4;
-                    int colLeftW = 1;
-                    switch (maskW) {
-                        case 0:  rowBottomW = 1; colLeftW = 1; break;
-                        case 2:  rowBottomW = 2; colLeftW = 1; break;
-                        case 1:  rowBottomW = 4; colLeftW = 1; break;
-                        case 3:  rowBottomW = 3; colLeftW = 1; break;
-                        case 8:  rowBottomW = 4; colLeftW = 2; break;
-                        case 4:  rowBottomW = 4; colLeftW = 4; break;
-                        case 12: rowBottomW = 4; colLeftW = 3; break;
-                        case 10: rowBottomW = 1; colLeftW = 2; break;
-                        case 6:  rowBottomW = 1; colLeftW = 4; break;
-                        case 5:  rowBottomW = 3; colLeftW = 4; break;
-                        case 9:  rowBottomW = 3; colLeftW = 2; break;
-                        case 11: rowBottomW = 2; colLeftW = 2; break;
-                        case 13: rowBottomW = 3; colLeftW = 3; break;
-                        case 14: rowBottomW = 1; colLeftW = 3; break;
-                        case 7:  rowBottomW = 2; colLeftW = 4; break;
-                        case 15: rowBottomW = 2; colLeftW = 3; break;
-                        default: rowBottomW = 1; colLeftW = 1; break;
-                    }
-                    colLeftW += 4;
-                    float texWW = sprW->getTexture() ? sprW->getTexture()->getContentSize().width : 0.0f;
-                    float texHW = sprW->getTexture() ? sprW->getTexture()->getContentSize().height : 0.0f;
-                    int columnsW = texWW > 0 ? static_cast<int>(texWW / tw) : 1;
-                    int totalRowsW = texHW > 0 ? static_cast<int>(texHW / th) : 1;
-                    int colIndex0W = colLeftW - 1;
-                    int rowIndexFromTop0W = totalRowsW - rowBottomW;
-                    if (rowIndexFromTop0W < 0) rowIndexFromTop0W = 0;
-                    float xW = static_cast<float>(colIndex0W * tw);
-                    float yW = texHW - static_cast<float>((rowIndexFromTop0W + 1) * th);
-                    sprW->setTextureRect(cocos2d::Rect(xW, yW, static_cast<float>(tw), static_cast<float>(th)));
-                    auto posW = tileToWorld(c, r);
-                    sprW->setPosition(posW);
-                    sprW->setVisible(true);
-                }
-            }
-        }
+namespace {
+
+bool isTilledLike(Game::TileType t) {
+    return t == Game::TileType::Tilled || t == Game::TileType::Watered;
+}
+
+// 4 邻域掩码（上=1 下=2 左=4 右=8）到 hoeDirt 图集帧（1-based 自底向上行、自左向右列）。
+void autotileFrame(int mask, int& rowBottom, int& colLeft) {
+    switch (mask) {
+        case 0:  rowBottom = 1; colLeft = 1; break;
+        case 2:  rowBottom = 2; colLeft = 1; break;
+        case 1:  rowBottom = 4; colLeft = 1; break;
+        case 3:  rowBottom = 3; colLeft = 1; break;
+        case 8:  rowBottom = 4; colLeft = 2; break;
+        case 4:  rowBottom = 4; colLeft = 4; break;
+        case 12: rowBottom = 4; colLeft = 3; break;
+        case 10: rowBottom = 1; colLeft = 2; break;
+        case 6:  rowBottom = 1; colLeft = 4; break;
+        case 5:  rowBottom = 3; colLeft = 4; break;
+        case 9:  rowBottom = 3; colLeft = 2; break;
+        case 11: rowBottom = 2; colLeft = 2; break;
+        case 13: rowBottom = 3; colLeft = 3; break;
+        case 14: rowBottom = 1; colLeft = 3; break;
+        case 7:  rowBottom = 2; colLeft = 4; break;
+        case 15: rowBottom = 2; colLeft = 3; break;
+        default: rowBottom = 1; colLeft = 1; break;
     }
+}
 
-    // Remove any overlay sprites that are no longer needed
-    std::vector<long long> toRemove;
-    for (auto &kv : _tileSprites) {
-        if (alive.find(kv.first) == alive.end()) {
-            toRemove.push_back(kv.first);
-        }
+void applyAutotileRect(cocos2d::Sprite* spr, int rowBottom, int colLeft) {
+    const int tw = 16, th = 16;
+    float texH = spr->getTexture() ? spr->getTexture()->getContentSize().height : 0.0f;
+    int totalRows = texH > 0 ? static_cast<int>(texH / th) : 1;
+    int colIndex0 = colLeft - 1;
+    int rowIndexFromTop0 = totalRows - rowBottom;
+    if (rowIndexFromTop0 < 0) rowIndexFromTop0 = 0;
+    float x = static_cast<float>(colIndex0 * tw);
+    float y = texH - static_cast<float>((rowIndexFromTop0 + 1) * th);
+    spr->setTextureRect(cocos2d::Rect(x, y, static_cast<float>(tw), static_cast<float>(th)));
+}
+
+long long tileKeyOf(int c, int r) {
+    return (static_cast<long long>(r) << 32) | static_cast<unsigned long long>(c);
+}
+
+} // namespace
+
+void FarmMapController::markTileDirty(int c, int r) {
+    if (_allTilesDirty) return;
+    if (_tileDirtyMark.size() != _grid->size()) {
+        _tileDirtyMark.assign(_grid->size(), 0);
     }
-    for (auto k : toRemove) {
-        if (_tileSprites.count(k)) {
-            auto spr = _tileSprites[k];
-            if (spr) spr->removeFromParent();
-            _tileSprites.erase(k);
-        }
+    static const int offs[5][2] = { {0, 0}, {1, 0}, {-1, 0}, {0, 1}, {0, -1} };
+    for (const auto& o : offs) {
+        int nc = c + o[0];
+        int nr = r + o[1];
+        if (!inBounds(nc, nr)) continue;
+        int idx = nr * _cols + nc;
+        if (_tileDirtyMark[idx]) continue;
+        _tileDirtyMark[idx] = 1;
+        _dirtyTiles.push_back(idx);
     }
-    std::vector<long long> toRemoveWater;
-    for (auto &kv : _waterSprites) {
-        if (aliveWater.find(kv.first) == aliveWater.end()) {
-            toRemoveWater.push_back(kv.first);
+}
+
+void FarmMapController::updateTileOverlay(int c, int r, const char* dirtFile, cocos2d::Texture2D* dirtTex) {
+    long long key = tileKeyOf(c, r);
+    auto tile = getTile(c, r);
+
+    if (!isTilledLike(tile)) {
+        auto it = _tileSprites.find(key);
+        if (it != _tileSprites.end()) {
+            if (it->second) it->second->removeFromParent();
+            _tileSprites.erase(it);
+        }
+    } else {
+        cocos2d::Sprite* spr = nullptr;
+        auto it = _tileSprites.find(key);
+        if (it == _tileSprites.end()) {
+            spr = cocos2d::Sprite::create(dirtFile);
+            spr->setAnchorPoint(cocos2d::Vec2(0.5f, 0.5f));
+            spr->setPosition(tileToWorld(c, r));
+            _tileRoot->addChild(spr, 0);
+            _tileSprites[key] = spr;
+        } else {
+            spr = it->second;
+        }
+        if (spr && dirtTex && spr->getTexture() != dirtTex) {
+            spr->setTexture(dirtTex);
+        }
+        int mask = 0;
+        if (r + 1 < _rows && isTilledLike(getTile(c, r + 1))) mask |= 1;
+        if (r - 1 >= 0 && isTilledLike(getTile(c, r - 1))) mask |= 2;
+        if (c - 1 >= 0 && isTilledLike(getTile(c - 1, r))) mask |= 4;
+        if (c + 1 < _cols && isTilledLike(getTile(c + 1, r))) mask |= 8;
+        int rowBottom = 1, colLeft = 1;
+        autotileFrame(mask, rowBottom, colLeft);
+        applyAutotileRect(spr, rowBottom, colLeft);
+        spr->setVisible(true);
+    }
+
+    if (tile != Game::TileType::Watered) {
+        auto itW = _waterSprites.find(key);
+        if (itW != _waterSprites.end()) {
+            if (itW->second) itW->second->removeFromParent();
+            _waterSprites.erase(itW);
         }
+        return;
     }
-    for (auto k : toRemoveWater) {
-        if (_waterSprites.count(k)) {
-            auto spr = _waterSprites[k];
-            if (spr) spr->removeFromParent();
-            _waterSprites.erase(k);
+    cocos2d::Sprite* sprW = nullptr;
+    auto itW = _waterSprites.find(key);
+    if (itW == _waterSprites.end()) {
+        sprW = cocos2d::Sprite::create(dirtFile);
+        sprW->setAnchorPoint(cocos2d::Vec2(0.5f, 0.5f));
+        sprW->setPosition(tileToWorld(c, r));
+        _tileRoot->addChild(sprW, 1);
+        _waterSprites[key] = sprW;
+    } else {
+        sprW = itW->second;
+    }
+    if (sprW && dirtTex && sprW->getTexture() != dirtTex) {
+        sprW->setTexture(dirtTex);
+    }
+    int maskW = 0;
+    if (r + 1 < _rows && getTile(c, r + 1) == Game::TileType::Watered) maskW |= 1;
+    if (r - 1 >= 0 && getTile(c, r - 1) == Game::TileType::Watered) maskW |= 2;
+    if (c - 1 >= 0 && getTile(c - 1, r) == Game::TileType::Watered) maskW |= 4;
+    if (c + 1 < _cols && getTile(c + 1, r) == Game::TileType::Watered) maskW |= 8;
+    int rowBottomW = 1, colLeftW = 1;
+    autotileFrame(maskW, rowBottomW, colLeftW);
+    // 浇水覆层位于图集右半部分
+    applyAutotileRect(sprW, rowBottomW, colLeftW + 4);
+    sprW->setVisible(true);
+}
+
+void FarmMapController::flushDirtyTiles() {
+    if (!_tileRoot) return;
+    const bool isWinter = (Game::globalState().seasonIndex == 3);
+    if (isWinter != _overlayWinter) {
+        // 季节贴图切换需要重设所有覆层纹理
+        _overlayWinter = isWinter;
+        _allTilesDirty = true;
+    }
+    if (!_allTilesDirty && _dirtyTiles.empty()) return;
+    const char* dirtFile = isWinter ? "hoeDirtSnow.png" : "hoeDirt.png";
+    auto* dirtTex = cocos2d::Director::getInstance()->getTextureCache()->addImage(dirtFile);
+    if (_allTilesDirty) {
+        for (int r = 0; r < _rows; ++r) {
+            for (int c = 0; c < _cols; ++c) {
+                updateTileOverlay(c, r, dirtFile, dirtTex);
+            }
+        }
+        _allTilesDirty = false;
+        _tileDirtyMark.assign(_grid->size(), 0);
+    } else {
+        for (int idx : _dirtyTiles) {
+            _tileDirtyMark[idx] = 0;
+            updateTileOverlay(idx % _cols, idx / _cols, dirtFile, dirtTex);
         }
     }
+    _dirtyTiles.clear();
+}
+
+void FarmMapController::refreshMapVisuals() {
+    if (!_tileRoot) return;
+    flushDirtyTiles();
     if (_chestController) {
         _chestController->refreshVisuals();
     }
@@ -730,7 +696,9 @@ void FarmMapController::refreshCropsVisuals() {
     if (!_cropsRootBack || !_cropsRootFront || !_cropsDraw) return;
     float s = tileSize();
     std::unordered_set<long long> alive;
-    for (const auto& cp : Game::globalState().farmCrops) {
+    const auto& crops = Game::globalState().farmCrops;
+    for (std::size_t i = 0; i < crops.size(); ++i) {
+        const Game::Crop cp = crops.get(i);
         long long key = (static_cast<long long>(cp.r) << 32) | static_cast<unsigned long long>(cp.c);
         alive.insert(key);
 
@@ -815,25 +783,22 @@ void FarmMapController::spawnDropAt(int c, int r, int itemType, int qty) {
     _dropSystem.spawnDropAt(this, c, r, itemType, qty);
 }
 
-void FarmMapController::collectDropsNear(const cocos2d::Vec2& playerWorldPos, Game::Inventory* inv) {
-    _dropSystem.collectDropsNear(playerWorldPos, inv);
+bool FarmMapController::collectDropsNear(const cocos2d::Vec2& playerWorldPos, Game::Inventory* inv) {
+    return _dropSystem.collectDropsNear(playerWorldPos, inv);
 }
 
 void FarmMapController::setAllPlantableTilesWatered() {
-    bool changed = false;
+    beginTileBatch();
     for (int r = 0; r < _rows; ++r) {
         for (int c = 0; c < _cols; ++c) {
             int idx = r * _cols + c;
-            if (idx < 0 || idx >= static_cast<int>(_tiles.size())) continue;
-            if (_tiles[static_cast<std::size_t>(idx)] == Game::TileType::Tilled) {
-                _tiles[static_cast<std::size_t>(idx)] = Game::TileType::Watered;
-                changed = true;
+            if (idx < 0 || idx >= static_cast<int>(_grid->size())) continue;
+            if (_grid->at(static_cast<std::size_t>(idx)) == Game::TileType::Tilled) {
+                setTile(c, r, Game::TileType::Watered);
             }
         }
     }
-    if (!changed) return;
-    Game::globalState().farmTiles = _tiles;
-    refreshMapVisuals();
+    commitTileBatch();
 }
 
  
@@ -20,6 +20,7 @@
 #include "Controllers/Environment/RockSystem.h"
 #include "Controllers/Environment/WeedSystem.h"
 #include "Controllers/Environment/EnvironmentObstacleSystemBase.h"
+#include "Controllers/Environment/ObstacleOccupancyGrid.h"
 #include "Controllers/Interact/TileSelector.h"
 #include "Controllers/Systems/ChestController.h"
 #include "Controllers/Systems/FurnaceController.h"
@@ -76,6 +77,10 @@ public:
     Game::TileType getTile(int c, int r) const override;
     // 设置瓦片类型（用于耕地/障碍生成等）。
     void setTile(int c, int r, Game::TileType t) override;
+    // 开始批量瓦片修改。
+    void beginTileBatch() override;
+    // 提交批量瓦片修改：刷新脏区域覆层（瓦片已直接写入共享网格）。
+    void commitTileBatch() override;
     // 瓦片索引转世界坐标（瓦片中心点）。
     cocos2d::Vec2 tileToWorld(int c, int r) const override;
     // 世界坐标转瓦片索引。
@@ -86,7 +91,7 @@ public:
     // 获取指定障碍系统实例（只读）。
     const EnvironmentObstacleSystemBase* obstacleSystem(ObstacleKind kind) const override;
 
-    // 刷新地图可视（瓦片覆层/箱子等）。
+    // 刷新地图可视（瓦片覆层/箱子等）；瓦片覆层只重算脏区域。
     void refreshMapVisuals() override;
     // 刷新作物可视（作物精灵与顶层精灵）。
     void refreshCropsVisuals() override;
@@ -121,7 +126,7 @@ public:
 
     // 是否靠近湖泊/水域（用于钓鱼等）。
     bool isNearLake(const cocos2d::Vec2& playerWorldPos, float radius) const override;
-    // 将角色渲染层级与环境节点做排序（遮挡关系）。
+    // 按脚底 Y 设置角色渲染层级，与环境节点形成遮挡关系（环境节点 ZOrder 在生成时固定）。
     void sortActorWithEnvironment(cocos2d::Node* actor) override;
     // 是否为农场地图（供外部做场景分支）。
     bool isFarm() const override { return true; }
@@ -130,8 +135,8 @@ public:
     // 清除最近一次点击记录。
     void clearLastClickWorldPos() override { _hasLastClick = false; }
 
-    // 收集玩家附近掉落物到背包。
-    void collectDropsNear(const cocos2d::Vec2& playerWorldPos, Game::Inventory* inv) override;
+    // 收集玩家附近掉落物到背包；返回是否有掉落被拾取。
+    bool collectDropsNear(const cocos2d::Vec2& playerWorldPos, Game::Inventory* inv) override;
 
     // 是否支持天气系统。
     bool supportsWeather() const override { return true; }
@@ -144,8 +149,11 @@ private:
     Game::FarmMap* _farmMap = nullptr;
     int _cols = GameConfig::MAP_COLS;
     int _rows = GameConfig::MAP_ROWS;
-    std::vector<Game::TileType> _tiles;
+    Game::TileGrid* _grid = nullptr;   // 指向 WorldState::farmTiles（唯一瓦片存储）
     cocos2d::DrawNode* _cursor = nullptr;
+    // 前方扇形候选缓存：targetTile 与光标共用，脚底瓦片/朝向不变时不重算
+    mutable ForwardFan _fan;
+    FanCursor _fanCursor; // 保留模式的扇形光标方框
     cocos2d::Vec2 _mapOrigin;
 
     // Prompts/regions
@@ -165,15 +173,30 @@ private:
     cocos2d::Node* _tileRoot = nullptr;
     std::unordered_map<long long, cocos2d::Sprite*> _tileSprites;
     std::unordered_map<long long, cocos2d::Sprite*> _waterSprites;
+    // 覆层脏区域：setTile 标记瓦片及四邻域，刷新时只重算这些瓦片的自动拼接
+    std::vector<int> _dirtyTiles;
+    std::vector<unsigned char> _tileDirtyMark;
+    bool _allTilesDirty = true;
+    bool _overlayWinter = false;
+    // 批量修改嵌套深度：批内只累积脏区域，最外层提交时统一刷新
+    int _tileBatchDepth = 0;
     cocos2d::Node* _actorsRoot = nullptr;
     Controllers::EnvironmentObstacleSystemBase* _treeSystem = nullptr;
     Controllers::EnvironmentObstacleSystemBase* _rockSystem = nullptr;
     Controllers::EnvironmentObstacleSystemBase* _weedSystem = nullptr;
+    // 树/石头/杂草共享的占用网格（按格子索引脚底矩形，碰撞查询与障碍数量无关）。
+    Controllers::ObstacleOccupancyGrid _obstacleGrid;
     cocos2d::Vec2 _lastClickWorldPos = cocos2d::Vec2::ZERO;
     bool _hasLastClick = false;
 
     // 应用静态不可耕作区域遮罩（建筑/道路等）。
     void applyStaticNotSoilMask();
+    // 标记瓦片及其四邻域的覆层为脏。
+    void markTileDirty(int c, int r);
+    // 重算单个瓦片的耕地/浇水覆层精灵。
+    void updateTileOverlay(int c, int r, const char* dirtFile, cocos2d::Texture2D* dirtTex);
+    // 刷新所有脏瓦片的覆层（不涉及箱子等其它可视）。
+    void flushDirtyTiles();
 };
 
 }
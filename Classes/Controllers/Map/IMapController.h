@@ -55,6 +55,10 @@ public:
     // Farm 专用：读写瓦片类型
     virtual Game::TileType getTile(int c, int r) const { return Game::TileType::Soil; }
     virtual void setTile(int c, int r, Game::TileType t) {}
+    // 批量瓦片修改：begin 与 commit 之间的 setTile 只改瓦片并累积脏区域，
+    // commit 时统一做一次增量可视刷新（可嵌套，最外层 commit 生效）。
+    virtual void beginTileBatch() {}
+    virtual void commitTileBatch() {}
     virtual cocos2d::Vec2 tileToWorld(int c, int r) const { return cocos2d::Vec2(); }
     virtual void worldToTileIndex(const cocos2d::Vec2& p, int& c, int& r) const { c = 0; r = 0; }
 
@@ -94,7 +98,8 @@ public:
     virtual void refreshCropsVisuals() {}
     virtual void refreshDropsVisuals() {}
     virtual void spawnDropAt(int c, int r, int itemType /*Game::ItemType*/ , int qty) {}
-    virtual void collectDropsNear(const cocos2d::Vec2& playerWorldPos, Game::Inventory* inv) {}
+    // 拾取玩家附近掉落；返回是否有掉落被拾取（背包内容发生变化）。
+    virtual bool collectDropsNear(const cocos2d::Vec2& playerWorldPos, Game::Inventory* inv) { return false; }
 
     // Chest 容器访问（Farm/Room 实现）
     virtual const std::vector<Game::Chest>& chests() const = 0;
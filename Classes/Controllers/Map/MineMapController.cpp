@@ -121,12 +121,17 @@ std::pair<int,int> MineMapController::targetTile(const Vec2& playerPos, const Ve
     // - tileToWorld：把瓦片索引转回世界坐标，用于绘制光标。
     // 这里的 [this](...) {...} 写法就是 lambda，类似把 this 指针和函数一起
     // 打包成回调，供工具系统在内部反复调用。
-    return TileSelector::selectForwardTile(
+    TileSelector::computeForwardFan(
         playerPos,
         lastDir,
         [this](const Vec2& p, int& c, int& r){ worldToTileIndex(p, c, r); },
         [this](int c, int r){ return inBounds(c, r); },
         tileSize(),
+        _fan);
+    return TileSelector::selectForwardTile(
+        _fan,
+        [this](int c, int r){ return inBounds(c, r); },
+        tileSize(),
         _hasLastClick,
         _lastClickWorldPos,
         [this](int c, int r){ return tileToWorld(c, r); });
@@ -152,17 +157,16 @@ void MineMapController::updateCursor(const Vec2& playerPos, const Vec2& lastDir)
             parent->addChild(_cursor, z);
         }
     }
-    // 使用 TileSelector::drawFanCursor 在 _cursor 上绘制扇形光标。
-    // 这里再次传入 worldToTileIndex / inBounds / tileToWorld 回调，让光标
-    // 的选中范围与 targetTile 使用的逻辑保持一致。
-    TileSelector::drawFanCursor(
-        _cursor,
+    // 与 targetTile 共用 _fan 扇形候选，让光标的选中范围与目标瓦片逻辑保持一致；
+    // 脚底瓦片与朝向不变时 _fanCursor 不会移动任何方框。
+    TileSelector::computeForwardFan(
         playerPos,
         lastDir,
         [this](const Vec2& p, int& c, int& r) { worldToTileIndex(p, c, r); },
         [this](int c, int r) { return inBounds(c, r); },
-        [this](int c, int r) { return tileToWorld(c, r); },
-        tileSize());
+        tileSize(),
+        _fan);
+    _fanCursor.update(_cursor, _fan, [this](int c, int r) { return tileToWorld(c, r); }, tileSize());
 }
 
 Game::TileType MineMapController::getTile(int c, int r) const {
@@ -259,8 +263,8 @@ void MineMapController::spawnDropAt(int c, int r, int itemType, int qty) {
     _dropSystem.spawnDropAt(this, c, r, itemType, qty);
 }
 
-void MineMapController::collectDropsNear(const cocos2d::Vec2& playerWorldPos, Game::Inventory* inv) {
-    _dropSystem.collectDropsNear(playerWorldPos, inv);
+bool MineMapController::collectDropsNear(const cocos2d::Vec2& playerWorldPos, Game::Inventory* inv) {
+    return _dropSystem.collectDropsNear(playerWorldPos, inv);
 }
 
 void MineMapController::addActorToMap(cocos2d::Node* node, int zOrder) {
@@ -286,6 +290,9 @@ void MineMapController::generateFloor(int floorIndex) {
         _cursor->removeFromParent();
         _cursor = nullptr;
     }
+    // 楼层边界随地图变化：扇形候选与光标方框都需重建。
+    _fan.invalidate();
+    _fanCursor.reset();
     _dropSystem.clear();
     _extraStairs.clear();
     _stairSystem.reset();
@@ -411,6 +418,9 @@ void MineMapController::loadEntrance() {
         _cursor->removeFromParent();
         _cursor = nullptr;
     }
+    // 楼层边界随地图变化：扇形候选与光标方框都需重建。
+    _fan.invalidate();
+    _fanCursor.reset();
     _dropSystem.clear();
     _extraStairs.clear();
     _stairSystem.reset();
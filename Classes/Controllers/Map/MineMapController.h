@@ -80,8 +80,8 @@ public:
     void refreshDropsVisuals() override;
     // 在指定瓦片生成掉落物。
     void spawnDropAt(int c, int r, int itemType, int qty) override;
-    // 收集玩家附近掉落物到背包。
-    void collectDropsNear(const cocos2d::Vec2& playerWorldPos, Game::Inventory* inv) override;
+    // 收集玩家附近掉落物到背包；返回是否有掉落被拾取。
+    bool collectDropsNear(const cocos2d::Vec2& playerWorldPos, Game::Inventory* inv) override;
     // 设置动态碰撞矩形（如采矿节点临时碰撞）。
     // 使用 std::vector<cocos2d::Rect> 存储一组轴对齐矩形，Rect 本质上是
     // 一个包含 x/y/width/height 的结构体，表示一块禁止通行区域。
@@ -147,7 +147,10 @@ public:
 private:
     cocos2d::Node* _worldNode = nullptr;          // 场景中的世界根节点（人物/地图都挂在下面）
     cocos2d::DrawNode* _mapDraw = nullptr;        // 简单地图渲染或调试绘制节点
-    cocos2d::DrawNode* _cursor = nullptr;         // 交互光标（扇形）绘制节点
+    cocos2d::DrawNode* _cursor = nullptr;         // 交互光标（扇形）方框的挂载节点
+    // 前方扇形候选缓存：targetTile 与光标共用，脚底瓦片/朝向不变时不重算
+    mutable ForwardFan _fan;
+    FanCursor _fanCursor; // 保留模式的扇形光标方框
     int _cols = 80;                               // 当前地图列数（瓦片数）
     int _rows = 60;                               // 当前地图行数（瓦片数）
     // 使用一维数组存储地图瓦片类型：索引 = r * _cols + c。
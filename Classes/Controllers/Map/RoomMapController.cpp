@@ -213,12 +213,17 @@ bool RoomMapController::isNearChest(const Vec2& playerWorldPos) const {
 }
 
 std::pair<int,int> RoomMapController::targetTile(const Vec2& playerPos, const Vec2& lastDir) const {
-    return TileSelector::selectForwardTile(
+    TileSelector::computeForwardFan(
         playerPos,
         lastDir,
         [this](const Vec2& p, int& c, int& r){ worldToTileIndex(p, c, r); },
         [this](int c, int r){ return inBounds(c, r); },
         tileSize(),
+        _fan);
+    return TileSelector::selectForwardTile(
+        _fan,
+        [this](int c, int r){ return inBounds(c, r); },
+        tileSize(),
         _hasLastClick,
         _lastClickWorldPos,
         [this](int c, int r){ return tileToWorld(c, r); });
@@ -267,8 +272,8 @@ void RoomMapController::spawnDropAt(int c, int r, int itemType, int qty) {
     _dropSystem.spawnDropAt(this, c, r, itemType, qty);
 }
 
-void RoomMapController::collectDropsNear(const Vec2& playerWorldPos, Game::Inventory* inv) {
-    _dropSystem.collectDropsNear(playerWorldPos, inv);
+bool RoomMapController::collectDropsNear(const Vec2& playerWorldPos, Game::Inventory* inv) {
+    return _dropSystem.collectDropsNear(playerWorldPos, inv);
 }
 
 // namespace Controllers
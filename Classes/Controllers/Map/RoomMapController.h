@@ -9,6 +9,7 @@
 #include "cocos2d.h"
 #include <vector>
 #include "Controllers/Map/IMapController.h"
+#include "Controllers/Interact/TileSelector.h"
 #include "Game/PlaceableItem/Chest.h"
 #include "Game/Map/RoomMap.h"
 #include "Controllers/Systems/ChestController.h"
@@ -95,7 +96,7 @@ public:
 
     void refreshDropsVisuals() override;
     void spawnDropAt(int c, int r, int itemType, int qty) override;
-    void collectDropsNear(const cocos2d::Vec2& playerWorldPos, Game::Inventory* inv) override;
+    bool collectDropsNear(const cocos2d::Vec2& playerWorldPos, Game::Inventory* inv) override;
 
 private:
     cocos2d::Node* _worldNode = nullptr;
@@ -105,6 +106,8 @@ private:
     int _rows = 0;
     std::vector<Game::TileType> _tiles;
     cocos2d::DrawNode* _cursor = nullptr;
+    // 前方扇形候选缓存：脚底瓦片/朝向不变时 targetTile 不重算
+    mutable ForwardFan _fan;
     cocos2d::Vec2 _lastClickWorldPos = cocos2d::Vec2::ZERO;
     bool _hasLastClick = false;
     cocos2d::Rect _roomRect;
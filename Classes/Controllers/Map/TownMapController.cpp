@@ -138,12 +138,17 @@ Vec2 TownMapController::clampPosition(const Vec2& current, const Vec2& next, flo
 }
 
 std::pair<int,int> TownMapController::targetTile(const Vec2& playerPos, const Vec2& lastDir) const {
-    return TileSelector::selectForwardTile(
+    TileSelector::computeForwardFan(
         playerPos,
         lastDir,
         [this](const Vec2& p, int& c, int& r){ worldToTileIndex(p, c, r); },
         [this](int c, int r){ return inBounds(c, r); },
         tileSize(),
+        _fan);
+    return TileSelector::selectForwardTile(
+        _fan,
+        [this](int c, int r){ return inBounds(c, r); },
+        tileSize(),
         _hasLastClick,
         _lastClickWorldPos,
         [this](int c, int r){ return tileToWorld(c, r); });
@@ -159,14 +164,14 @@ void TownMapController::updateCursor(const Vec2& playerPos, const Vec2& lastDir)
         }
     }
     if (!_cursor) return;
-    TileSelector::drawFanCursor(
-        _cursor,
+    TileSelector::computeForwardFan(
         playerPos,
         lastDir,
         [this](const Vec2& p, int& c, int& r) { worldToTileIndex(p, c, r); },
         [this](int c, int r) { return inBounds(c, r); },
-        [this](int c, int r) { return tileToWorld(c, r); },
-        tileSize());
+        tileSize(),
+        _fan);
+    _fanCursor.update(_cursor, _fan, [this](int c, int r) { return tileToWorld(c, r); }, tileSize());
 }
 
 bool TownMapController::collides(const Vec2& p, float radius) const {
@@ -220,8 +225,8 @@ void TownMapController::spawnDropAt(int c, int r, int itemType, int qty) {
     _dropSystem.spawnDropAt(this, c, r, itemType, qty);
 }
 
-void TownMapController::collectDropsNear(const cocos2d::Vec2& playerWorldPos, Game::Inventory* inv) {
-    _dropSystem.collectDropsNear(playerWorldPos, inv);
+bool TownMapController::collectDropsNear(const cocos2d::Vec2& playerWorldPos, Game::Inventory* inv) {
+    return _dropSystem.collectDropsNear(playerWorldPos, inv);
 }
 
 } // namespace Controllers
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "Controllers/Map/IMapController.h"
+#include "Controllers/Interact/TileSelector.h"
 #include "Game/Map/TownMap.h"
 #include "Controllers/Systems/DropSystem.h"
 #include "Controllers/Systems/ChestController.h"
@@ -87,8 +88,8 @@ public:
     void refreshDropsVisuals() override;
     // 在指定瓦片生成掉落物。
     void spawnDropAt(int c, int r, int itemType, int qty) override;
-    // 收集玩家附近掉落物到背包。
-    void collectDropsNear(const cocos2d::Vec2& playerWorldPos, Game::Inventory* inv) override;
+    // 收集玩家附近掉落物到背包；返回是否有掉落被拾取。
+    bool collectDropsNear(const cocos2d::Vec2& playerWorldPos, Game::Inventory* inv) override;
 
     // 从农场进入房间的出生点（城镇无此门，返回零向量）。
     cocos2d::Vec2 farmRoomDoorSpawnPos() const override { return cocos2d::Vec2::ZERO; }
@@ -125,6 +126,9 @@ private:
     int _rows = 0;
     std::vector<Game::TileType> _tiles;
     cocos2d::DrawNode* _cursor = nullptr;
+    // 前方扇形候选缓存：targetTile 与光标共用，脚底瓦片/朝向不变时不重算
+    mutable ForwardFan _fan;
+    FanCursor _fanCursor; // 保留模式的扇形光标方框
     Controllers::DropSystem _dropSystem;
     cocos2d::Vec2 _lastClickWorldPos = cocos2d::Vec2::ZERO;
     bool _hasLastClick = false;
@@ -30,15 +30,15 @@ namespace {
     int matureDays(Game::AnimalType type);
     // 获取某类动物成年且当日被喂食时产出的物品类型。
     Game::ItemType productFor(Game::AnimalType type);
-    // 获取某类动物当日产出数量（可能包含随机）。
-    int productQty(Game::AnimalType type);
+    // 获取某类动物当日产出数量（可能包含随机，随机数取自 eng）。
+    int productQty(Game::AnimalType type, std::mt19937& eng);
 
     // 推进单只动物的“离线一天”：
     // - 若 fedToday=true：年龄 +1，并在达到成熟天数后标记为成年。
     // - 若成年且 fedToday=true：生成当日产物（通过 producedDrop 输出）。
     // - 结尾统一清空 fedToday（跨日重置）。
     // 返回值：本日是否产生了可掉落的产物（qty>0）。
-    bool advanceAnimalOneDay(Game::Animal& animal, ProducedDrop* producedDrop) {
+    bool advanceAnimalOneDay(Game::Animal& animal, ProducedDrop* producedDrop, std::mt19937& eng) {
         if (producedDrop) {
             producedDrop->qty = 0;
             producedDrop->pos = animal.pos;
@@ -54,10 +54,11 @@ namespace {
         bool produced = false;
         if (animal.isAdult && animal.fedToday) {
             Game::ItemType prod = productFor(animal.type);
-            int qty = productQty(animal.type);
+            int qty = productQty(animal.type, eng);
             {
                 auto& skill = Game::SkillTreeSystem::getInstance();
-                qty = skill.adjustAnimalProductQuantityForHusbandry(prod, qty);
+                std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+                qty = skill.adjustAnimalProductQuantityForHusbandry(prod, qty, unit(eng));
                 skill.addXp(Game::SkillTreeType::AnimalHusbandry, skill.xpForAnimalProduct(prod, qty));
             }
             if (producedDrop) {
@@ -124,11 +125,11 @@ namespace {
     }
 
     // 动物产物数量规则：将动物类型映射为当日产物数量（部分带随机）。
-    int productQty(Game::AnimalType type) {
+    int productQty(Game::AnimalType type, std::mt19937& eng) {
         switch (type) {
-            case Game::AnimalType::Chicken: return randomInt(1, 3);
+            case Game::AnimalType::Chicken: return std::uniform_int_distribution<int>(1, 3)(eng);
             case Game::AnimalType::Cow: return 2;
-            case Game::AnimalType::Sheep: return randomInt(1, 2);
+            case Game::AnimalType::Sheep: return std::uniform_int_distribution<int>(1, 2)(eng);
         }
         return 1;
     }
@@ -339,9 +340,11 @@ void advanceAnimalsDaily(Controllers::IMapController* map) {
     auto& ws = Game::globalState();
     Controllers::IMapController* dropMap = (map && map->isFarm()) ? map : nullptr;
     float tileSize = dropMap ? dropMap->tileSize() : 0.0f;
+    // 产量随机取自当日的夜间随机流（与天气相同，按存档槽与日期派生）。
+    std::mt19937 eng(Game::nightlySeed(ws, Game::NightlyStream::Animals));
     for (auto& a : ws.farmAnimals) {
         ProducedDrop drop;
-        bool produced = advanceAnimalOneDay(a, &drop);
+        bool produced = advanceAnimalOneDay(a, &drop, eng);
         if (!produced) continue;
 
         auto appendWorldDrop = [&ws, &drop]() {
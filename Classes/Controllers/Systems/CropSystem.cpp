@@ -1,6 +1,6 @@
 // 作物系统实现：
-// - 管理农场上的作物列表与状态持久化
-// - 每日推进依赖 CropDefs::stageDays；回生/收获/加速由系统统一分支处理
+// - 直接操作 WorldState 中的农场作物列表（按列存储），按格子索引定位单条记录
+// - 单条操作（收获/加速）通过 Crop 视图读改写；每日推进按列分趟处理
 #include "Controllers/Systems/CropSystem.h"
 #include <algorithm>
 #include <cstdlib>
@@ -9,14 +9,14 @@
 
 namespace Controllers {
 
-// 构造：从全局状态加载农场作物列表到系统私有缓存。
-CropSystem::CropSystem() { syncLoad(); }
+// 构造：绑定全局状态中的农场作物列表，索引在第一次查找时建立。
+CropSystem::CropSystem() : _crops(Game::globalState().farmCrops) {}
 
 // 获取作物列表只读视图：供 UI/控制器遍历显示，不允许修改内部状态。
-const std::vector<Game::Crop>& CropSystem::crops() const { return _crops; }
+const Game::CropStore& CropSystem::crops() const { return _crops; }
 
 // 获取作物列表可写引用：仅供系统内部或受控逻辑使用，避免外部直接篡改唯一来源。
-std::vector<Game::Crop>& CropSystem::crops() { return _crops; }
+Game::CropStore& CropSystem::crops() { return _crops; }
 
 // 锄头收获：命中可收获作物时计算产物与数量，并执行收获状态变更。
 bool CropSystem::harvestByHoeAt(int c, int r, int toolLevel, Game::ItemType& outProduce, int& outQty, bool& outYields) {
@@ -25,10 +25,10 @@ bool CropSystem::harvestByHoeAt(int c, int r, int toolLevel, Game::ItemType& out
     outYields = false;
     int idx = findCropIndex(c, r);
     if (idx < 0) return false;
-    if (!canHarvestAt(c, r)) return false;
-    // static_cast：显式类型转换；这里把 int 下标转为 size_t 以匹配 vector::operator[] 的索引类型。
-    const auto& cp = _crops[static_cast<std::size_t>(idx)];
-    outYields = yieldsOnHarvestAt(c, r);
+    // static_cast：显式类型转换；这里把 int 下标转为 size_t 以匹配列数组的索引类型。
+    const Game::Crop cp = _crops.get(static_cast<std::size_t>(idx));
+    if (!canHarvest(cp)) return false;
+    outYields = yieldsOnHarvest(cp);
     if (outYields) {
         outProduce = Game::produceItemFor(cp.type);
         int minQty = 1;
@@ -55,38 +55,45 @@ bool CropSystem::harvestByHoeAt(int c, int r, int toolLevel, Game::ItemType& out
         skill.addXp(Game::SkillTreeType::Farming, skill.xpForFarmingHarvest(outProduce, qty));
         outQty = qty;
     }
-    harvestCropAt(c, r);
+    harvestAtIndex(idx);
     return true;
 }
 
-// 根据网格坐标查找作物索引；未找到返回 -1
+// 根据网格坐标查找作物索引；未找到返回 -1。
+// 命中后校验坐标：列表被外部改写过（例如读档）而长度恰好不变时，重建索引后再查一次。
 int CropSystem::findCropIndex(int c, int r) const {
-    for (int i = 0; i < static_cast<int>(_crops.size()); ++i) {
-        if (_crops[i].c == c && _crops[i].r == r) return i;
+    ensureIndex();
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        auto it = _indexByTile.find(tileKey(c, r));
+        if (it == _indexByTile.end()) return -1;
+        int idx = it->second;
+        if (idx >= 0 && idx < static_cast<int>(_crops.size()) &&
+            _crops.tileC()[idx] == c && _crops.tileR()[idx] == r) {
+            return idx;
+        }
+        rebuildIndex();
     }
     return -1;
 }
 
 // 种植：创建作物实例并初始化最大阶段
 void CropSystem::plantCrop(Game::CropType type, int c, int r) {
+    ensureIndex();
     Game::Crop cp; cp.c = c; cp.r = r; cp.type = type; cp.stage = 0; cp.progress = 0; cp.maxStage = Game::CropDefs::maxStage(type);
     _crops.push_back(cp);
-    syncSave();
+    _indexByTile[tileKey(c, r)] = static_cast<int>(_crops.size()) - 1;
+    _indexedSize = _crops.size();
 }
 
 // 标记浇水：用于当日推进时计算是否增长
 void CropSystem::markWateredAt(int c, int r) {
     int idx = findCropIndex(c, r);
     if (idx < 0) return;
-    _crops[idx].wateredToday = true;
-    syncSave();
+    _crops.watered()[idx] = 1;
 }
 
-// 是否可收获
-bool CropSystem::canHarvestAt(int c, int r) const {
-    int idx = findCropIndex(c, r);
-    if (idx < 0) return false;
-    const auto& cp = _crops[idx];
+// 单条作物是否可收获（回生作物在倒数第二阶段或占位阶段均可收）
+bool CropSystem::canHarvest(const Game::Crop& cp) {
     if (Game::CropDefs::isRegrow(cp.type)) {
         int penultimate = std::max(0, cp.maxStage - 1);
         return cp.stage == penultimate || cp.stage >= cp.maxStage;
@@ -94,11 +101,8 @@ bool CropSystem::canHarvestAt(int c, int r) const {
     return cp.stage >= cp.maxStage;
 }
 
-// 收获是否产出
-bool CropSystem::yieldsOnHarvestAt(int c, int r) const {
-    int idx = findCropIndex(c, r);
-    if (idx < 0) return false;
-    const auto& cp = _crops[idx];
+// 单条作物收获时是否产出（回生作物占位阶段只清除不产出）
+bool CropSystem::yieldsOnHarvest(const Game::Crop& cp) {
     if (Game::CropDefs::isRegrow(cp.type)) {
         int penultimate = std::max(0, cp.maxStage - 1);
         return cp.stage == penultimate;
@@ -106,75 +110,108 @@ bool CropSystem::yieldsOnHarvestAt(int c, int r) const {
     return cp.stage >= cp.maxStage;
 }
 
+// 是否可收获
+bool CropSystem::canHarvestAt(int c, int r) const {
+    int idx = findCropIndex(c, r);
+    return idx >= 0 && canHarvest(_crops.get(idx));
+}
+
+// 收获是否产出
+bool CropSystem::yieldsOnHarvestAt(int c, int r) const {
+    int idx = findCropIndex(c, r);
+    return idx >= 0 && yieldsOnHarvest(_crops.get(idx));
+}
+
 // 每日推进：
 // - 普通作物：浇水则按阶段天数推进到 maxStage
 // - 回生作物：浇水则推进到倒数第二阶段；收获后处于 maxStage 占位，再浇水从 maxStage 长回倒数第二阶段
 void CropSystem::advanceCropsDaily(IMapController* map) {
+    growCropsDaily(map);
+    dryWateredTiles(map);
+}
+
+// 作物部分分三趟处理：先逐条采集浇水/枯死/所需天数（需要查瓦片与静态定义），
+// 再对纯 int 列做无分支的增长循环（可自动向量化），最后按存活掩码原地压缩各列。
+void CropSystem::growCropsDaily(IMapController* map) {
     auto &ws = Game::globalState();
-    int cols = ws.farmCols;
-    int rows = ws.farmRows;
+    int cols = ws.farmTiles.cols();
+    int rows = ws.farmTiles.rows();
     bool canCheckTiles = (cols > 0 && rows > 0 && ws.farmTiles.size() == static_cast<size_t>(cols * rows));
 
-    std::vector<Game::Crop> kept;
-    kept.reserve(_crops.size());
-    for (auto& cp : _crops) {
-        Game::TileType t = Game::TileType::Soil;
-        int tileIdx = -1;
-        if (canCheckTiles && cp.c >= 0 && cp.c < cols && cp.r >= 0 && cp.r < rows) {
-            tileIdx = cp.r * cols + cp.c;
-            t = ws.farmTiles[tileIdx];
-        } else if (map && map->isFarm()) {
-            t = map->getTile(cp.c, cp.r);
-        }
+    // 未浇水枯死（15%）按格子取计数器散列：同一存档同一天、同一格子的结果固定，与遍历顺序无关。
+    const unsigned int seed = Game::nightlySeed(ws, Game::NightlyStream::Crops);
+    const int today = ws.seasonIndex * 30 + ws.dayOfSeason;
+    const unsigned int witherThreshold = 644245094u; // 0.15 * 2^32
 
-        bool watered = cp.wateredToday || (t == Game::TileType::Watered);
+    const std::size_t n = _crops.size();
+    const auto& tc = _crops.tileC();
+    const auto& tr = _crops.tileR();
+    const auto& maxStages = _crops.maxStages();
+    auto& stages = _crops.stages();
+    auto& progress = _crops.progress();
+    auto& watered = _crops.watered();
 
-        bool outOfSeason = !Game::CropDefs::isSeasonAllowed(cp.type, ws.seasonIndex);
-        bool died = outOfSeason;
-        if (!died && !watered) {
-            // std::rand：C 标准库随机数；这里用作低频“未浇水枯死”概率模拟。
-            double roll = static_cast<double>(std::rand()) / (static_cast<double>(RAND_MAX) + 1.0);
-            if (roll < 0.15) {
-                died = true;
-            }
-        }
+    std::vector<std::uint8_t> keep(n, 0);
+    std::vector<int> grow(n, 0);
+    std::vector<int> need(n, 1);
+    std::vector<int> target(n, 0);
 
-        if (died) {
-            cp.wateredToday = false;
-            continue;
+    // 第一趟：逐条采集
+    for (std::size_t i = 0; i < n; ++i) {
+        Game::TileType t = Game::TileType::Soil;
+        if (canCheckTiles && tc[i] >= 0 && tc[i] < cols && tr[i] >= 0 && tr[i] < rows) {
+            t = ws.farmTiles.at(static_cast<std::size_t>(tr[i] * cols + tc[i]));
+        } else if (map && map->isFarm()) {
+            t = map->getTile(tc[i], tr[i]);
         }
+        const Game::CropType type = _crops.typeAt(i);
+        const bool wet = watered[i] != 0 || t == Game::TileType::Watered;
+        const bool outOfSeason = !Game::CropDefs::isSeasonAllowed(type, ws.seasonIndex);
+        const bool withered = !wet && Game::nightlyTileHash(seed, today, tc[i], tr[i]) < witherThreshold;
+        keep[i] = (outOfSeason || withered) ? 0u : 1u;
 
-        bool regrow = Game::CropDefs::isRegrow(cp.type);
-        int penultimate = std::max(0, cp.maxStage - 1);
-        int growMaxStage = regrow ? penultimate : cp.maxStage;
-
-        if (regrow && cp.stage >= cp.maxStage) {
-            if (watered) {
-                cp.progress += 1;
-                const auto& days = Game::CropDefs::stageDays(cp.type);
-                int idx = cp.maxStage;
-                int need = (idx >= 0 && idx < static_cast<int>(days.size())) ? std::max(1, days[idx]) : 1;
-                if (cp.progress >= need) {
-                    cp.stage = penultimate;
-                    cp.progress = 0;
-                }
-            }
-        } else if (watered && cp.stage < growMaxStage) {
-            cp.progress += 1;
-            const auto& days = Game::CropDefs::stageDays(cp.type);
-            int need = (cp.stage >= 0 && cp.stage < static_cast<int>(days.size())) ? std::max(1, days[cp.stage]) : 1;
-            if (cp.progress >= need) { cp.stage += 1; cp.progress = 0; }
-        }
+        const bool regrow = _crops.isRegrow(i);
+        const int stage = stages[i];
+        const int maxStage = maxStages[i];
+        const int penultimate = std::max(0, maxStage - 1);
+        const int growMaxStage = regrow ? penultimate : maxStage;
+        const bool placeholder = regrow && stage >= maxStage;
+        const int needIdx = placeholder ? maxStage : stage;
+        const auto& days = Game::CropDefs::stageDays(type);
+        need[i] = (needIdx >= 0 && needIdx < static_cast<int>(days.size())) ? std::max(1, days[needIdx]) : 1;
+        grow[i] = (wet && (placeholder || stage < growMaxStage)) ? 1 : 0;
+        target[i] = placeholder ? penultimate : stage + 1;
+    }
 
-        cp.wateredToday = false;
-        kept.push_back(cp);
+    // 第二趟：增长（只有 int 列上的选择运算，无数据相关分支）
+    int* stageCol = stages.data();
+    int* progressCol = progress.data();
+    const int* growCol = grow.data();
+    const int* needCol = need.data();
+    const int* targetCol = target.data();
+    for (std::size_t i = 0; i < n; ++i) {
+        const int p = progressCol[i] + growCol[i];
+        const int advance = growCol[i] & (p >= needCol[i] ? 1 : 0);
+        stageCol[i] = advance ? targetCol[i] : stageCol[i];
+        progressCol[i] = advance ? 0 : p;
     }
-    // swap：常量时间交换容器内容；避免逐元素拷贝带来的额外开销。
-    _crops.swap(kept);
-    syncSave();
 
+    // 第三趟：复位浇水标记，按存活掩码压缩
+    std::fill(watered.begin(), watered.end(), static_cast<std::uint8_t>(0));
+    _crops.compact(keep);
+    rebuildIndex();
+}
+
+// 浇水瓦片回退为耕地：必须在作物推进读完浇水状态之后执行。
+void CropSystem::dryWateredTiles(IMapController* map) {
+    auto &ws = Game::globalState();
+    int cols = ws.farmTiles.cols();
+    int rows = ws.farmTiles.rows();
+    bool canCheckTiles = (cols > 0 && rows > 0 && ws.farmTiles.size() == static_cast<size_t>(cols * rows));
     if (map && map->isFarm()) {
         if (cols > 0 && rows > 0) {
+            // 批量回退：所有改动在 commit 时一次性同步与刷新
+            map->beginTileBatch();
             for (int r = 0; r < rows; ++r) {
                 for (int c = 0; c < cols; ++c) {
                     if (!map->inBounds(c, r)) continue;
@@ -184,16 +221,12 @@ void CropSystem::advanceCropsDaily(IMapController* map) {
                     }
                 }
             }
+            map->commitTileBatch();
         }
     } else if (canCheckTiles) {
-        for (int r = 0; r < rows; ++r) {
-            for (int c = 0; c < cols; ++c) {
-                int idx = r * cols + c;
-                if (idx >= 0 && idx < static_cast<int>(ws.farmTiles.size())) {
-                    if (ws.farmTiles[static_cast<std::size_t>(idx)] == Game::TileType::Watered) {
-                        ws.farmTiles[static_cast<std::size_t>(idx)] = Game::TileType::Tilled;
-                    }
-                }
+        for (std::size_t idx = 0; idx < ws.farmTiles.size(); ++idx) {
+            if (ws.farmTiles.at(idx) == Game::TileType::Watered) {
+                ws.farmTiles.setAt(idx, Game::TileType::Tilled);
             }
         }
     }
@@ -203,60 +236,78 @@ void CropSystem::advanceCropsDaily(IMapController* map) {
 void CropSystem::harvestCropAt(int c, int r) {
     int idx = findCropIndex(c, r);
     if (idx < 0) return;
-    auto& cp = _crops[idx];
-    if (Game::CropDefs::isRegrow(cp.type)) {
+    harvestAtIndex(idx);
+}
+
+void CropSystem::harvestAtIndex(int idx) {
+    const Game::Crop cp = _crops.get(idx);
+    if (_crops.isRegrow(idx)) {
         int penultimate = std::max(0, cp.maxStage - 1);
         if (cp.stage == penultimate) {
-            cp.stage = cp.maxStage;
-            cp.progress = 0;
+            _crops.stages()[idx] = cp.maxStage;
+            _crops.progress()[idx] = 0;
         } else if (cp.stage >= cp.maxStage) {
-            // erase：从 vector 中移除一个元素，后续元素会前移，索引会改变。
-            _crops.erase(_crops.begin() + idx);
+            removeAtIndex(idx);
         }
     } else {
-        if (cp.stage >= cp.maxStage) { _crops.erase(_crops.begin() + idx); }
+        if (cp.stage >= cp.maxStage) { removeAtIndex(idx); }
+    }
+}
+
+// swap-remove：O(1) 删除，只有被搬到 idx 的末尾作物需要更新索引。
+void CropSystem::removeAtIndex(int idx) {
+    ensureIndex();
+    std::size_t last = _crops.size() - 1;
+    auto it = _indexByTile.find(tileKey(_crops.tileC()[idx], _crops.tileR()[idx]));
+    if (it != _indexByTile.end() && it->second == idx) _indexByTile.erase(it);
+    _crops.swapRemove(static_cast<std::size_t>(idx));
+    if (static_cast<std::size_t>(idx) != last) {
+        _indexByTile[tileKey(_crops.tileC()[idx], _crops.tileR()[idx])] = idx;
     }
-    syncSave();
+    _indexedSize = _crops.size();
 }
 
 // 作弊：使所有作物瞬间成熟
 void CropSystem::instantMatureAllCrops() {
-    for (auto& cp : _crops) {
-        if (Game::CropDefs::isRegrow(cp.type)) {
-            cp.stage = std::max(0, cp.maxStage - 1);
-        } else {
-            cp.stage = cp.maxStage;
-        }
-        cp.progress = 0;
+    const auto& maxStages = _crops.maxStages();
+    auto& stages = _crops.stages();
+    for (std::size_t i = 0; i < _crops.size(); ++i) {
+        stages[i] = _crops.isRegrow(i) ? std::max(0, maxStages[i] - 1) : maxStages[i];
     }
-    syncSave();
+    std::fill(_crops.progress().begin(), _crops.progress().end(), 0);
 }
 
 // 加速一次
 void CropSystem::advanceCropOnceAt(int c, int r) {
     int idx = findCropIndex(c, r);
     if (idx < 0) return;
-    auto& cp = _crops[idx];
-    bool regrow = Game::CropDefs::isRegrow(cp.type);
+    Game::Crop cp = _crops.get(idx);
+    bool regrow = _crops.isRegrow(idx);
     int penultimate = std::max(0, cp.maxStage - 1);
     int growMaxStage = regrow ? penultimate : cp.maxStage;
 
-    bool changed = false;
     if (regrow && cp.stage >= cp.maxStage) {
         cp.stage = penultimate;
         cp.progress = 0;
-        changed = true;
     } else if (cp.stage < growMaxStage) {
         cp.stage += 1;
         cp.progress = 0;
-        changed = true;
     }
+    _crops.set(idx, cp);
+}
 
-    if (changed) { syncSave(); }
+void CropSystem::ensureIndex() const {
+    if (!_indexBuilt || _indexedSize != _crops.size()) rebuildIndex();
 }
 
-// 与全局状态同步（存/取）
-void CropSystem::syncLoad() { _crops = Game::globalState().farmCrops; }
-void CropSystem::syncSave() { Game::globalState().farmCrops = _crops; }
+void CropSystem::rebuildIndex() const {
+    _indexByTile.clear();
+    _indexByTile.reserve(_crops.size());
+    for (std::size_t i = 0; i < _crops.size(); ++i) {
+        _indexByTile[tileKey(_crops.tileC()[i], _crops.tileR()[i])] = static_cast<int>(i);
+    }
+    _indexedSize = _crops.size();
+    _indexBuilt = true;
+}
 
 }
@@ -4,6 +4,7 @@
 // - 与地图控制器协作读写瓦片（浇水后回退为 Tilled）并刷新可视化
 #pragma once
 
+#include <unordered_map>
 #include <vector>
 #include "Game/Crops/crop/CropBase.h"
 #include "Game/WorldState.h"
@@ -12,20 +13,21 @@
 namespace Controllers {
 
 // 作物系统（唯一来源）：
-// - 负责农场作物的运行时状态列表（位置/阶段/浇水等）与持久化同步。
+// - 直接读写 WorldState::farmCrops（按列存储的 CropStore，不再整表拷贝），每次操作只改动涉及的那条作物记录。
+// - 维护“格子 -> 下标”索引，按格子查找为 O(1)；拔除作物用末尾元素填洞（swap-remove）并同步修正索引。
 // - 通过 Game::CropDefs 查询静态定义（阶段天数/季节/回生）以推进作物。
 // - 协作对象：IMapController 提供瓦片/坐标与掉落刷新；UI/工具通过该系统查询与操作作物。
 class CropSystem {
 public:
     // 锄头收获：若可收获则计算产物数量（含技能树加成）并执行收获；返回是否发生收获动作。
     bool harvestByHoeAt(int c, int r, int toolLevel, Game::ItemType& outProduce, int& outQty, bool& outYields);
-    // 构造并从 WorldState 同步加载作物列表。
+    // 构造：绑定 WorldState 中的作物列表。
     CropSystem();
     // 只读访问作物列表（运行时状态由系统维护）。
-    const std::vector<Game::Crop>& crops() const;
-    // 可写访问作物列表（仅供系统内部/受控调用使用）。
-    std::vector<Game::Crop>& crops();
-    // 查找某格子上的作物索引；未找到返回 -1。
+    const Game::CropStore& crops() const;
+    // 可写访问作物列表（仅供系统内部/受控调用使用；增删元素后索引在下次查找时自动重建）。
+    Game::CropStore& crops();
+    // 查找某格子上的作物索引；未找到返回 -1。下标在下一次增删作物前有效。
     int findCropIndex(int c, int r) const;
     // 在指定格子种植作物（初始化 stage/progress/maxStage）。
     void plantCrop(Game::CropType type, int c, int r);
@@ -36,7 +38,13 @@ public:
     // 判断指定格子作物收获时是否产出（回生作物在占位成熟阶段可能只拔除）。
     bool yieldsOnHarvestAt(int c, int r) const;
     // 每日推进：处理浇水/枯死/阶段增长，并回退 Watered 瓦片为 Tilled。
+    // 枯死判定按 (存档种子, 日期, 格子) 散列，结果与作物在列表中的顺序无关。
+    // 等价于依次调用 growCropsDaily 与 dryWateredTiles；夜间流水线把两步拆开调度。
     void advanceCropsDaily(IMapController* map);
+    // 只推进作物（读瓦片、不写瓦片）；map 不是农场时不触碰 map，可在工作线程执行。
+    void growCropsDaily(IMapController* map);
+    // 把 Watered 瓦片回退为 Tilled（map 为农场时经批量接口刷新显示，否则直接写 WorldState）。
+    static void dryWateredTiles(IMapController* map);
     // 收获指定格子作物：可能拔除或将回生作物转为占位成熟阶段。
     void harvestCropAt(int c, int r);
     // 作弊接口：将所有作物瞬间推进到可收获阶段。
@@ -45,12 +53,25 @@ public:
     void advanceCropOnceAt(int c, int r);
 
 private:
-    // 作物运行时状态列表（std::vector：动态数组容器，会按需扩容）。
-    std::vector<Game::Crop> _crops;
-    // 从 WorldState 读取作物列表到本地缓存。
-    void syncLoad();
-    // 将本地作物列表写回 WorldState。
-    void syncSave();
+    static long long tileKey(int c, int r) {
+        return (static_cast<long long>(r) << 32) | static_cast<unsigned int>(c);
+    }
+    static bool canHarvest(const Game::Crop& cp);
+    static bool yieldsOnHarvest(const Game::Crop& cp);
+    // 收获下标 idx 处的作物（调用方已确认下标有效）。
+    void harvestAtIndex(int idx);
+    // 用末尾元素覆盖 idx 并弹出末尾，同步修正索引。
+    void removeAtIndex(int idx);
+    // 列表长度与索引记录的不一致（被外部增删过）时整表重建索引。
+    void ensureIndex() const;
+    void rebuildIndex() const;
+
+    // 作物列表：引用 WorldState::farmCrops（WorldState 为全局单例，读档时原地赋值，引用始终有效）。
+    Game::CropStore& _crops;
+    // 格子键 -> 作物下标；查找时顺带校验，发现不一致即重建。
+    mutable std::unordered_map<long long, int> _indexByTile;
+    mutable std::size_t _indexedSize = 0;
+    mutable bool _indexBuilt = false;
 };
 
 }
@@ -1,4 +1,6 @@
 #include "Controllers/Systems/DropSystem.h"
+#include <algorithm>
+#include <cmath>
 
 namespace Controllers {
 
@@ -8,6 +10,13 @@ void DropSystem::configureTargetProvider(std::function<AttachTarget()> provider)
 
 void DropSystem::setDrops(const std::vector<Game::Drop>& drops) {
     _drops = drops;
+    _dropIds.clear();
+    _dropIds.reserve(_drops.size());
+    for (std::size_t i = 0; i < _drops.size(); ++i) {
+        _dropIds.push_back(allocateDropId());
+    }
+    rebuildIndex();
+    _visualsDirty = true;
     notifyChanged();
     refreshVisuals();
 }
@@ -26,15 +35,82 @@ void DropSystem::notifyChanged() {
     }
 }
 
-void DropSystem::ensureAttached() {
-    if (!_targetProvider) return;
+int DropSystem::allocateDropId() {
+    return _nextDropId++;
+}
+
+long long DropSystem::bucketKeyOf(int bc, int br) {
+    return (static_cast<long long>(br) << 32) | static_cast<unsigned int>(bc);
+}
+
+int DropSystem::bucketCoordOf(float v) {
+    return static_cast<int>(std::floor(v / static_cast<float>(GameConfig::TILE_SIZE)));
+}
+
+void DropSystem::pushDrop(const Game::Drop& d) {
+    int id = allocateDropId();
+    _drops.push_back(d);
+    _dropIds.push_back(id);
+    _indexOfId[id] = _drops.size() - 1;
+    _buckets[bucketKeyOf(bucketCoordOf(d.pos.x), bucketCoordOf(d.pos.y))].push_back(id);
+}
+
+void DropSystem::removeDropAt(std::size_t index) {
+    if (index >= _drops.size()) return;
+    int id = _dropIds[index];
+    const auto& pos = _drops[index].pos;
+    auto bit = _buckets.find(bucketKeyOf(bucketCoordOf(pos.x), bucketCoordOf(pos.y)));
+    if (bit != _buckets.end()) {
+        auto& ids = bit->second;
+        auto it = std::find(ids.begin(), ids.end(), id);
+        if (it != ids.end()) {
+            *it = ids.back();
+            ids.pop_back();
+        }
+        if (ids.empty()) _buckets.erase(bit);
+    }
+    _indexOfId.erase(id);
+    std::size_t last = _drops.size() - 1;
+    if (index != last) {
+        _drops[index] = _drops[last];
+        _dropIds[index] = _dropIds[last];
+        _indexOfId[_dropIds[index]] = index;
+    }
+    _drops.pop_back();
+    _dropIds.pop_back();
+}
+
+void DropSystem::rebuildIndex() {
+    _buckets.clear();
+    _indexOfId.clear();
+    _indexOfId.reserve(_drops.size());
+    for (std::size_t i = 0; i < _drops.size(); ++i) {
+        const auto& pos = _drops[i].pos;
+        _indexOfId[_dropIds[i]] = i;
+        _buckets[bucketKeyOf(bucketCoordOf(pos.x), bucketCoordOf(pos.y))].push_back(_dropIds[i]);
+    }
+}
+
+void DropSystem::releaseVisuals() {
+    for (auto& kv : _visuals) {
+        if (kv.second.sprite) {
+            kv.second.sprite->removeFromParent();
+        }
+    }
+    _visuals.clear();
+    _visualsDirty = true;
+}
+
+bool DropSystem::ensureAttached() {
+    if (!_targetProvider) return false;
     AttachTarget tgt = _targetProvider();
-    if (!tgt.parent) return;
+    if (!tgt.parent) return false;
 
     bool parentChanged = (_attachedParent != tgt.parent);
     bool zChanged = (_attachedZOrder != tgt.zOrder);
     _attachedParent = tgt.parent;
     _attachedZOrder = tgt.zOrder;
+    bool rebuilt = false;
 
     if (!_dropsDraw || parentChanged || !_dropsDraw->getParent()) {
         if (_dropsDraw && _dropsDraw->getParent()) {
@@ -42,6 +118,7 @@ void DropSystem::ensureAttached() {
         }
         _dropsDraw = cocos2d::DrawNode::create();
         _attachedParent->addChild(_dropsDraw, _attachedZOrder);
+        rebuilt = true;
     } else if (zChanged) {
         _dropsDraw->setLocalZOrder(_attachedZOrder);
     }
@@ -50,37 +127,128 @@ void DropSystem::ensureAttached() {
         if (_dropsRoot && _dropsRoot->getParent()) {
             _dropsRoot->removeFromParent();
         }
+        // 旧根节点连同子精灵一起被移除，缓存的精灵指针全部失效。
+        _visuals.clear();
         _dropsRoot = cocos2d::Node::create();
         _attachedParent->addChild(_dropsRoot, _attachedZOrder);
+        rebuilt = true;
     } else if (zChanged) {
         _dropsRoot->setLocalZOrder(_attachedZOrder);
     }
+    return rebuilt;
 }
 
 void DropSystem::refreshVisuals() {
-    ensureAttached();
-    Game::Drop::renderDrops(_drops, _dropsRoot, _dropsDraw);
+    bool rebuilt = ensureAttached();
+    if (!_dropsRoot || !_dropsDraw) return;
+    if (!_visualsDirty && !rebuilt) return;
+    _visualsDirty = false;
+
+    unsigned int stamp = ++_visualStamp;
+    bool hasFallback = false;
+    for (std::size_t i = 0; i < _drops.size(); ++i) {
+        const auto& d = _drops[i];
+        auto it = _visuals.find(_dropIds[i]);
+        if (it == _visuals.end()) {
+            DropVisual v;
+            v.pos = d.pos;
+            v.sprite = Game::Drop::createSprite(d);
+            if (v.sprite) {
+                _dropsRoot->addChild(v.sprite);
+            }
+            it = _visuals.emplace(_dropIds[i], v).first;
+        } else if (it->second.pos != d.pos) {
+            it->second.pos = d.pos;
+            if (it->second.sprite) it->second.sprite->setPosition(d.pos);
+        }
+        it->second.stamp = stamp;
+        if (!it->second.sprite) hasFallback = true;
+    }
+
+    for (auto it = _visuals.begin(); it != _visuals.end();) {
+        if (it->second.stamp != stamp) {
+            if (it->second.sprite) it->second.sprite->removeFromParent();
+            it = _visuals.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    _dropsDraw->clear();
+    if (hasFallback) {
+        for (std::size_t i = 0; i < _drops.size(); ++i) {
+            auto it = _visuals.find(_dropIds[i]);
+            if (it != _visuals.end() && !it->second.sprite) {
+                Game::Drop::drawFallback(_drops[i], _dropsDraw);
+            }
+        }
+    }
 }
 
 void DropSystem::spawnDropAt(Controllers::IMapController* map, int c, int r, int itemType, int qty) {
     if (!map || qty <= 0) return;
     if (!map->inBounds(c, r)) return;
     Game::Drop d{ static_cast<Game::ItemType>(itemType), map->tileToWorld(c, r), qty };
-    _drops.push_back(d);
+    pushDrop(d);
+    _visualsDirty = true;
     notifyChanged();
     refreshVisuals();
 }
 
-void DropSystem::collectDropsNear(const cocos2d::Vec2& playerWorldPos, Game::Inventory* inv) {
-    if (!inv) return;
-    Game::Drop::collectDropsNear(playerWorldPos, _drops, inv);
+bool DropSystem::collectDropsNear(const cocos2d::Vec2& playerWorldPos, Game::Inventory* inv) {
+    if (!inv || _drops.empty()) return false;
+    float radius = GameConfig::DROP_PICK_RADIUS;
+    float r2 = radius * radius;
+    int bc0 = bucketCoordOf(playerWorldPos.x - radius);
+    int bc1 = bucketCoordOf(playerWorldPos.x + radius);
+    int br0 = bucketCoordOf(playerWorldPos.y - radius);
+    int br1 = bucketCoordOf(playerWorldPos.y + radius);
+
+    // 先收集候选 id：拾取过程中会修改桶内容。
+    std::vector<int> candidates;
+    for (int br = br0; br <= br1; ++br) {
+        for (int bc = bc0; bc <= bc1; ++bc) {
+            auto it = _buckets.find(bucketKeyOf(bc, br));
+            if (it == _buckets.end()) continue;
+            for (int id : it->second) {
+                auto idx = _indexOfId.find(id);
+                if (idx == _indexOfId.end()) continue;
+                if (playerWorldPos.distanceSquared(_drops[idx->second].pos) <= r2) {
+                    candidates.push_back(id);
+                }
+            }
+        }
+    }
+    if (candidates.empty()) return false;
+
+    bool changed = false;
+    for (int id : candidates) {
+        auto idx = _indexOfId.find(id);
+        if (idx == _indexOfId.end()) continue;
+        std::size_t index = idx->second;
+        auto& d = _drops[index];
+        int before = d.qty;
+        if (Game::Drop::tryPickup(d, inv)) {
+            removeDropAt(index);
+            changed = true;
+        } else if (d.qty != before) {
+            changed = true;
+        }
+    }
+    if (!changed) return false;
+    _visualsDirty = true;
     notifyChanged();
     refreshVisuals();
+    return true;
 }
 
 void DropSystem::clear() {
     _drops.clear();
+    _dropIds.clear();
+    _buckets.clear();
+    _indexOfId.clear();
     notifyChanged();
+    releaseVisuals();
     if (_dropsDraw) {
         _dropsDraw->removeFromParent();
         _dropsDraw = nullptr;
@@ -93,4 +261,3 @@ void DropSystem::clear() {
 }
 
 } // namespace Controllers
-
@@ -2,10 +2,13 @@
  * DropSystem: 掉落物系统（唯一来源）。
  * - 职责：维护地图掉落物列表（类型/数量/坐标）与拾取规则，并统一管理其渲染节点挂接与刷新。
  * - 协作对象：IMapController 提供 tileToWorld/inBounds 等坐标能力；Inventory 作为拾取目标；MapController 仅转发调用与提供挂载点解析。
+ * - 渲染：每个掉落分配稳定 id 并保留其精灵；刷新时只对新增/移动/移除的掉落做增量更新。
+ * - 拾取：掉落按 tile 分桶索引，拾取只检测玩家周围的桶；仅在确有拾取时才同步外部存储与渲染。
  */
 #pragma once
 
 #include <functional>
+#include <unordered_map>
 #include <vector>
 #include "cocos2d.h"
 #include "Controllers/Map/IMapController.h"
@@ -35,24 +38,50 @@ public:
     // 在指定 tile 上生成掉落（内部会校验 inBounds/qty，并自动刷新渲染与变更回调）。
     void spawnDropAt(Controllers::IMapController* map, int c, int r, int itemType, int qty);
 
-    // 拾取玩家附近掉落（拾取后自动刷新渲染与变更回调）。
-    void collectDropsNear(const cocos2d::Vec2& playerWorldPos, Game::Inventory* inv);
+    // 拾取玩家附近掉落；返回是否有掉落被拾取（仅此时刷新渲染并触发变更回调）。
+    bool collectDropsNear(const cocos2d::Vec2& playerWorldPos, Game::Inventory* inv);
 
-    // 刷新渲染（当挂载点或掉落列表变化时调用）。
+    // 刷新渲染：仅在挂载点或掉落列表变化后做增量同步，否则直接返回。
     void refreshVisuals();
 
     // 设置当掉落列表变化时的回调（用于持久化到 WorldState 等外部存储）。
     void setOnDropsChanged(std::function<void(const std::vector<Game::Drop>&)> cb);
 
 private:
-    void ensureAttached();
+    // 已渲染掉落的快照：用于与当前列表比对，决定新建/移动/移除精灵。
+    struct DropVisual {
+        cocos2d::Sprite* sprite = nullptr;   // 为空表示使用 DrawNode 回退绘制
+        cocos2d::Vec2 pos;
+        unsigned int stamp = 0;
+    };
+
+    // 确保渲染节点挂接；返回 true 表示节点被重建（需要全量重建精灵）。
+    bool ensureAttached();
     void notifyChanged();
+    int allocateDropId();
+    void releaseVisuals();
+
+    // 空间分桶索引：桶边长为一个 tile，key 由桶行列拼接。
+    static long long bucketKeyOf(int bc, int br);
+    static int bucketCoordOf(float v);
+    void pushDrop(const Game::Drop& d);
+    void removeDropAt(std::size_t index);
+    void rebuildIndex();
 
 private:
     std::function<AttachTarget()> _targetProvider;
     std::function<void(const std::vector<Game::Drop>&)> _onDropsChanged;
 
     std::vector<Game::Drop> _drops;
+    std::vector<int> _dropIds;                    // 与 _drops 一一对应的稳定 id
+    int _nextDropId = 1;
+
+    std::unordered_map<long long, std::vector<int>> _buckets; // 桶 -> 掉落 id
+    std::unordered_map<int, std::size_t> _indexOfId;          // id -> _drops 下标
+
+    std::unordered_map<int, DropVisual> _visuals; // id -> 已渲染精灵
+    unsigned int _visualStamp = 0;
+    bool _visualsDirty = true;
 
     cocos2d::Node* _attachedParent = nullptr;
     int _attachedZOrder = 19;
@@ -8,19 +8,10 @@ namespace Controllers {
 FestivalController::FestivalController(IMapController* map)
     : _map(map) {
     syncToMap(true);
-    auto& ws = Game::globalState();
-    _appliedSeasonIndex = ws.seasonIndex;
-    _appliedDayOfSeason = ws.dayOfSeason;
 }
 
-void FestivalController::update(float) {
-    auto& ws = Game::globalState();
-    bool isNewDay = (ws.seasonIndex != _appliedSeasonIndex) || (ws.dayOfSeason != _appliedDayOfSeason);
-    if (!isNewDay) return;
-
-    _appliedSeasonIndex = ws.seasonIndex;
-    _appliedDayOfSeason = ws.dayOfSeason;
-    syncToMap(true);
+void FestivalController::onNewDay() {
+    syncToMap(false);
 }
 
 bool FestivalController::isFestivalToday() const {
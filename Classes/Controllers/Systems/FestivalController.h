@@ -15,8 +15,8 @@ public:
     // 构造：绑定地图控制器，并立即按当前日期同步一次节日开关。
     explicit FestivalController(IMapController* map);
 
-    // 每帧更新：检测跨天并在需要时重新同步节日开关。
-    void update(float dt);
+    // 跨天时调用（由场景订阅 GameStateController 的“次日早晨”事件触发）：按新日期重新同步节日开关。
+    void onNewDay();
 
 private:
     // 从全局状态读取并判定当天是否为节日。
@@ -28,8 +28,6 @@ private:
 private:
     IMapController* _map = nullptr;
     bool _festivalActive = false;
-    int _appliedSeasonIndex = -1;
-    int _appliedDayOfSeason = -1;
 };
 
 } // namespace Controllers
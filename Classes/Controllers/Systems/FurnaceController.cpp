@@ -16,25 +16,41 @@ namespace Controllers {
 
 namespace {
 
-// 根据地图类型返回对应的熔炉容器指针（WorldState 中的 farm/house/town/beachFurnaces）。
-// 注意：这里只是“选择容器”的工具函数，不负责创建或删除熔炉。
-std::vector<Game::Furnace>* getFurnacesForMap(Controllers::IMapController* map) {
-    if (!map) return nullptr;
-    auto& ws = Game::globalState();
+// 根据地图类型确定熔炉区域；没有熔炉的地图返回 false。
+bool getFurnaceAreaForMap(Controllers::IMapController* map, Game::FurnaceArea& area) {
+    if (!map) return false;
     if (map->isFarm()) {
-        return &ws.farmFurnaces;
+        area = Game::FurnaceArea::Farm;
+        return true;
     }
-    if (auto* room = dynamic_cast<Controllers::RoomMapController*>(map)) {
-        (void)room;
-        return &ws.houseFurnaces;
+    if (dynamic_cast<Controllers::RoomMapController*>(map)) {
+        area = Game::FurnaceArea::House;
+        return true;
     }
     if (dynamic_cast<Controllers::TownMapController*>(map)) {
-        return &ws.townFurnaces;
+        area = Game::FurnaceArea::Town;
+        return true;
     }
     if (dynamic_cast<Controllers::BeachMapController*>(map)) {
-        return &ws.beachFurnaces;
+        area = Game::FurnaceArea::Beach;
+        return true;
+    }
+    return false;
+}
+
+// 根据地图类型返回对应的熔炉容器指针（WorldState 中的 farm/house/town/beachFurnaces）。
+// 注意：这里只是“选择容器”的工具函数，不负责创建或删除熔炉。
+std::vector<Game::Furnace>* getFurnacesForMap(Controllers::IMapController* map) {
+    Game::FurnaceArea area = Game::FurnaceArea::Farm;
+    if (!getFurnaceAreaForMap(map, area)) return nullptr;
+    auto& ws = Game::globalState();
+    switch (area) {
+        case Game::FurnaceArea::House: return &ws.houseFurnaces;
+        case Game::FurnaceArea::Town: return &ws.townFurnaces;
+        case Game::FurnaceArea::Beach: return &ws.beachFurnaces;
+        case Game::FurnaceArea::Farm:
+        default: return &ws.farmFurnaces;
     }
-    return nullptr;
 }
 
 }
@@ -73,6 +89,7 @@ void FurnaceController::bindContext(Controllers::IMapController* map,
 // 从 WorldState 拿到当前地图对应的熔炉列表，并补齐 dropOffset。
 // - _runtime 指向 WorldState 中的某个 vector（农场/房屋/城镇/海滩）。
 // - dropOffset 表示“锭掉落”相对熔炉中心的偏移量，这里统一设为向上半格。
+// - 注册完成回调时，FurnaceScheduler 会立即交付离开期间完成的熔炉。
 void FurnaceController::syncLoad() {
     if (!_runtime && _map) {
         _runtime = getFurnacesForMap(_map);
@@ -85,42 +102,45 @@ void FurnaceController::syncLoad() {
         }
     }
     refreshVisuals();
+    if (_schedulerToken == 0 && getFurnaceAreaForMap(_map, _area)) {
+        _schedulerToken = Game::FurnaceScheduler::getInstance().bindArea(
+            _area,
+            [this](const std::vector<Game::Furnace*>& done) { onSmeltingDone(done); });
+    }
 }
 
-// 每帧更新熔炉状态：推进 remainingSeconds，完成时生成掉落并提示。
-// - dt：上一帧到这一帧经过的时间（秒），由场景 update 传入。
-// - 当某个熔炉计时从 >0 降到 <=0 时，视为一次熔炼完成，生成对应锭。
-void FurnaceController::update(float dt) {
-    if (!_runtime || !_map) return;
-    bool changedState = false;
-    for (auto& f : *_runtime) {
-        if (f.remainingSeconds > 0.0f) {
-            float before = f.remainingSeconds;
-            f.remainingSeconds -= dt;
-            if (f.remainingSeconds <= 0.0f && before > 0.0f) {
-                f.remainingSeconds = 0.0f;
-                changedState = true;
-                auto recipe = Game::furnaceRecipeFor(f.oreType);
-                if (!Game::isValidFurnaceRecipe(recipe)) {
-                    continue;
-                }
-                Game::ItemType ingot = recipe.output;
-                Vec2 dropPos = f.pos + f.dropOffset;
-                int c = 0;
-                int r = 0;
-                _map->worldToTileIndex(dropPos, c, r);
-                _map->spawnDropAt(c, r, static_cast<int>(ingot), 1);
-                _map->refreshDropsVisuals();
-                if (_ui) {
-                    Vec2 uiPos = _map->getPlayerPosition(dropPos);
-                    _ui->popTextAt(uiPos, "Smelted", Color3B::YELLOW);
-                }
-            }
+void FurnaceController::detach() {
+    if (_schedulerToken == 0) return;
+    Game::FurnaceScheduler::getInstance().unbindArea(_area, _schedulerToken);
+    _schedulerToken = 0;
+}
+
+// 熔炼完成：在每个熔炉的掉落点生成对应锭并提示，最后统一刷新掉落与熔炉贴图。
+// - done 可能是刚到期的一个熔炉，也可能是进入地图时积压的一批。
+void FurnaceController::onSmeltingDone(const std::vector<Game::Furnace*>& done) {
+    if (!_map) return;
+    bool spawned = false;
+    for (auto* f : done) {
+        auto recipe = Game::furnaceRecipeFor(f->oreType);
+        if (!Game::isValidFurnaceRecipe(recipe)) {
+            continue;
+        }
+        Game::ItemType ingot = recipe.output;
+        Vec2 dropPos = f->pos + f->dropOffset;
+        int c = 0;
+        int r = 0;
+        _map->worldToTileIndex(dropPos, c, r);
+        _map->spawnDropAt(c, r, static_cast<int>(ingot), 1);
+        spawned = true;
+        if (_ui) {
+            Vec2 uiPos = _map->getPlayerPosition(dropPos);
+            _ui->popTextAt(uiPos, "Smelted", Color3B::YELLOW);
         }
     }
-    if (changedState) {
-        refreshVisuals();
+    if (spawned) {
+        _map->refreshDropsVisuals();
     }
+    refreshVisuals();
 }
 
 // 重新绘制所有熔炉精灵：根据 remainingSeconds 选择冷/热贴图。
@@ -385,6 +405,10 @@ bool FurnaceController::tryInteractExisting(Controllers::IMapController* map,
     }
     f.oreType = recipe.ore;
     f.remainingSeconds = recipe.seconds;
+    Game::FurnaceArea area = Game::FurnaceArea::Farm;
+    if (getFurnaceAreaForMap(map, area)) {
+        Game::FurnaceScheduler::getInstance().start(area, f);
+    }
     if (ui) {
         ui->refreshHotbar();
         Vec2 uiPos = map->getPlayerPosition(playerWorldPos);
@@ -5,6 +5,7 @@
 #include <memory>
 #include "Controllers/Systems/PlaceableItemSystemBase.h"
 #include "Game/PlaceableItem/Furnace.h"
+#include "Game/PlaceableItem/FurnaceScheduler.h"
 #include "Game/Inventory.h"
 
 namespace Controllers {
@@ -15,7 +16,7 @@ class UIController;
 // FurnaceController：熔炉系统控制器，负责管理当前地图上的所有熔炉状态与交互。
 // - 职责：
 //   1. 维护运行时熔炉列表（_runtime，指向 WorldState 中对应容器）。
-//   2. 负责熔炉的放置规则、交互判定（投入矿石/燃料）、计时更新与锭掉落。
+//   2. 负责熔炉的放置规则、交互判定（投入矿石/燃料）与锭掉落；计时由 Game::FurnaceScheduler 统一负责。
 //   3. 驱动熔炉的视觉刷新（冷却/加热贴图切换）。
 // - 协作对象：
 //   - IMapController：提供地图坐标转换、掉落生成、边界/碰撞信息。
@@ -34,10 +35,11 @@ public:
                      Controllers::UIController* ui,
                      std::shared_ptr<Game::Inventory> inventory);
 
-    // 从 WorldState 同步当前地图的熔炉列表，并修正缺失的 dropOffset。
+    // 从 WorldState 同步当前地图的熔炉列表，修正缺失的 dropOffset，
+    // 并向 FurnaceScheduler 注册本区域的完成回调（离开期间完成的熔炉在此一次性生成锭）。
     void syncLoad();
-    // 每帧更新：推进各熔炉 remainingSeconds，完成时生成掉落并弹出提示。
-    void update(float dt);
+    // 解除 FurnaceScheduler 中的回调注册；场景析构时调用。
+    void detach();
     // 重新绘制所有熔炉的精灵（冷/热两套贴图）。
     void refreshVisuals();
 
@@ -73,6 +75,9 @@ private:
                              const cocos2d::Vec2& playerWorldPos,
                              const cocos2d::Vec2& lastDir) override;
 
+    // FurnaceScheduler 回调：为本区域完成的熔炉生成锭、弹出提示并刷新贴图。
+    void onSmeltingDone(const std::vector<Game::Furnace*>& done);
+
     // 在视野内查找距离玩家最近的熔炉索引。
     int findNearestFurnace(const cocos2d::Vec2& playerWorldPos, float maxDist) const;
 
@@ -84,6 +89,9 @@ private:
     std::shared_ptr<Game::Inventory> _inventory;
     // 当前地图对应的熔炉列表指针（指向 WorldState 中的容器）。
     std::vector<Game::Furnace>* _runtime = nullptr;
+    // 当前地图对应的熔炉区域与 FurnaceScheduler 绑定令牌（0 表示未绑定）。
+    Game::FurnaceArea _area = Game::FurnaceArea::Farm;
+    int _schedulerToken = 0;
 };
 
 }
@@ -6,11 +6,24 @@
 #include "Game/GameConfig.h"
 #include "Game/WorldState.h"
 #include "Game/Save/SaveSystem.h"
-#include <unordered_set>
+#include "Game/PlaceableItem/FurnaceScheduler.h"
+#include "Game/WorkerPool.h"
 
 namespace Controllers {
 
-static bool ensureWeatherChosenForToday() {
+namespace {
+
+const long long kMinutesPerDay = 24 * 60;
+const long long kMorningMinute = 6 * 60;
+
+}
+
+GameStateController::GameStateController(Controllers::IMapController* map, Controllers::UIController* ui, Controllers::CropSystem* crop)
+: _map(map), _ui(ui), _crop(crop) {
+    ensureWeatherChosenForToday();
+}
+
+bool GameStateController::ensureWeatherChosenForToday() {
     auto& ws = Game::globalState();
     bool mismatch = (ws.weatherSeasonIndex != ws.seasonIndex) || (ws.weatherDayOfSeason != ws.dayOfSeason);
     if (!mismatch) return false;
@@ -18,10 +31,7 @@ static bool ensureWeatherChosenForToday() {
     if (ws.seasonIndex == 1 && ws.dayOfSeason == GameConfig::FESTIVAL_DAY) {
         ws.isRaining = false;
     } else {
-        unsigned int seed = 0u;
-        seed ^= static_cast<unsigned int>(ws.lastSaveSlot * 73856093);
-        seed ^= static_cast<unsigned int>(ws.seasonIndex * 19349663);
-        seed ^= static_cast<unsigned int>(ws.dayOfSeason * 83492791);
+        unsigned int seed = Game::daySeed(ws);
         int roll = static_cast<int>(seed % 100u);
 
         ws.isRaining = (roll < 30);
@@ -37,29 +47,73 @@ void GameStateController::update(float dt) {
         if (_ui) _ui->refreshHUD();
         return;
     }
-    ensureWeatherChosenForToday();
     bool timeChanged = false;
     ws.timeAccum += dt;
-    while (ws.timeAccum >= GameConfig::REAL_SECONDS_PER_GAME_MINUTE) {
-        ws.timeAccum -= GameConfig::REAL_SECONDS_PER_GAME_MINUTE;
-        ws.timeMinute += 1;
-        if (ws.timeMinute >= 60) {
+    if (ws.timeAccum >= GameConfig::REAL_SECONDS_PER_GAME_MINUTE) {
+        int minutes = static_cast<int>(ws.timeAccum / GameConfig::REAL_SECONDS_PER_GAME_MINUTE);
+        ws.timeAccum -= static_cast<float>(minutes) * GameConfig::REAL_SECONDS_PER_GAME_MINUTE;
+        int total = ws.timeHour * 60 + ws.timeMinute + minutes;
+        if (total >= 24 * 60) {
+            ws.timeHour = 24;
             ws.timeMinute = 0;
-            ws.timeHour += 1;
-            if (ws.timeHour >= 24) {
-                ws.timeHour = 24;
-                ws.pendingPassOut = true;
-                timeChanged = true;
-                ws.timeAccum = 0.0f;
-                break;
-            }
+            ws.pendingPassOut = true;
+            ws.timeAccum = 0.0f;
+        } else {
+            ws.timeHour = total / 60;
+            ws.timeMinute = total % 60;
         }
         timeChanged = true;
     }
+    dispatchDueEvents();
     if (timeChanged && _ui) _ui->refreshHUD();
 }
 
-void GameStateController::sleepToNextMorning() {
+long long GameStateController::nowMinutes() const {
+    const auto& ws = Game::globalState();
+    return _dayIndex * kMinutesPerDay + ws.timeHour * 60 + ws.timeMinute;
+}
+
+GameStateController::EventId GameStateController::pushEvent(long long due, GameEvent fn) {
+    EventId id = ++_nextEventId;
+    _eventHandlers[id] = std::move(fn);
+    _events.push(ScheduledEvent{ due, id });
+    return id;
+}
+
+GameStateController::EventId GameStateController::scheduleAt(int hour, int minute, GameEvent fn) {
+    long long now = nowMinutes();
+    long long due = _dayIndex * kMinutesPerDay + hour * 60 + minute;
+    if (due <= now) due += kMinutesPerDay;
+    return pushEvent(due, std::move(fn));
+}
+
+GameStateController::EventId GameStateController::scheduleInMinutes(int minutes, GameEvent fn) {
+    return pushEvent(nowMinutes() + (minutes > 1 ? minutes : 1), std::move(fn));
+}
+
+GameStateController::EventId GameStateController::scheduleNextMorning(GameEvent fn) {
+    return pushEvent((_dayIndex + 1) * kMinutesPerDay + kMorningMinute, std::move(fn));
+}
+
+bool GameStateController::cancelEvent(EventId id) {
+    return _eventHandlers.erase(id) > 0;
+}
+
+// 只看堆顶：没有到期事件时为 O(1)。回调中新调度的事件时刻一定晚于当前时刻，不会在本轮重复触发。
+void GameStateController::dispatchDueEvents() {
+    const long long now = nowMinutes();
+    while (!_events.empty() && _events.top().due <= now) {
+        EventId id = _events.top().id;
+        _events.pop();
+        auto it = _eventHandlers.find(id);
+        if (it == _eventHandlers.end()) continue;
+        GameEvent fn = std::move(it->second);
+        _eventHandlers.erase(it);
+        if (fn) fn();
+    }
+}
+
+void GameStateController::advanceCalendarDay() {
     auto &ws = Game::globalState();
     ws.energy = ws.maxEnergy;
     ws.dayOfSeason += 1;
@@ -70,50 +124,89 @@ void GameStateController::sleepToNextMorning() {
     ws.timeHour = 6;
     ws.timeMinute = 0;
     ws.timeAccum = 0.0f;
-    ensureWeatherChosenForToday();
-    if (_crop) {
-        _crop->advanceCropsDaily(_map);
+}
+
+// 空闲土壤集合由 farmTiles 随瓦片与障碍物增删增量维护；登记总数与障碍物列表不符
+// （存在未经 addBlocker/removeBlocker 的整表替换）时先整体重建一次。
+void GameStateController::regrowFarmObstaclesNightly() {
+    auto &ws = Game::globalState();
+    if (ws.farmTiles.empty() || ws.farmTiles.cols() <= 0 || ws.farmTiles.rows() <= 0) return;
+    std::size_t obstacles = ws.farmTrees.size() + ws.farmRocks.size() + ws.farmWeeds.size();
+    if (ws.farmTiles.blockerCount() != obstacles) Game::syncFarmBlockers(ws);
+
+    TreeSystem::regrowNightlyWorldOnly(ws.farmTiles);
+    RockSystem::regrowNightlyWorldOnly(ws.farmTiles);
+    WeedSystem::regrowNightlyWorldOnly(ws.farmTiles);
+}
+
+void GameStateController::runNightPipeline(NightPipeline& pipeline, CropSystem* crop, IMapController* map, Game::WorkerPool* pool) {
+    const bool onFarm = map && map->isFarm();
+    auto calendar = pipeline.addStage("calendar", []() { advanceCalendarDay(); });
+    pipeline.addStage("weather", []() { ensureWeatherChosenForToday(); }, { calendar });
+    NightPipeline::StageId crops = -1;
+    if (crop) crops = pipeline.addStage("crops", [crop, map]() { crop->growCropsDaily(map); }, { calendar }, onFarm);
+    pipeline.addStage("animals", [map]() { advanceAnimalsDaily(map); }, { calendar }, onFarm);
+    auto regrow = pipeline.addStage("regrow", []() { regrowFarmObstaclesNightly(); }, { calendar });
+    if (crop) pipeline.addStage("dryTiles", [map]() { CropSystem::dryWateredTiles(map); }, { crops, regrow }, onFarm);
+    pipeline.run(pool);
+}
+
+// 订阅了“次日早晨”等事件的系统在下一次 update 中被唤醒；昏倒时旧场景不再 update，由新场景按新日期初始化。
+void GameStateController::sleepToNextMorning() {
+    ++_dayIndex;
+    _lastNight = NightPipeline();
+    runNightPipeline(_lastNight, _crop, _map, &Game::WorkerPool::shared());
+    if (_ui) _ui->refreshHUD();
+    submitAutosave();
+}
+
+int GameStateController::advanceDaysWorldOnly(int days, CropSystem* crop, Game::WorkerPool* pool,
+                                              const std::function<void(const NightPipeline&)>& afterNight) {
+    if (days <= 0) return 0;
+    auto& ws = Game::globalState();
+    std::unique_ptr<CropSystem> localCrop;
+    if (!crop) {
+        localCrop.reset(new CropSystem());
+        crop = localCrop.get();
     }
-    advanceAnimalsDaily(_map);
-    if (!ws.farmTiles.empty() && ws.farmCols > 0 && ws.farmRows > 0) {
-        const int cols = ws.farmCols;
-        const int rows = ws.farmRows;
-
-        auto keyOf = [](int c, int r) -> long long {
-            return (static_cast<long long>(r) << 32) | static_cast<unsigned long long>(c);
-        };
-
-        std::unordered_set<long long> occupied;
-        occupied.reserve(static_cast<size_t>(ws.farmTrees.size() + ws.farmRocks.size() + ws.farmWeeds.size()) + 16u);
-        for (const auto& tp : ws.farmTrees) occupied.insert(keyOf(tp.c, tp.r));
-        for (const auto& rp : ws.farmRocks) occupied.insert(keyOf(rp.c, rp.r));
-        for (const auto& wp : ws.farmWeeds) occupied.insert(keyOf(wp.c, wp.r));
-
-        auto getTile = [&ws, cols, rows](int c, int r) -> Game::TileType {
-            if (c < 0 || r < 0 || c >= cols || r >= rows) return Game::TileType::NotSoil;
-            size_t idx = static_cast<size_t>(r) * static_cast<size_t>(cols) + static_cast<size_t>(c);
-            if (idx >= ws.farmTiles.size()) return Game::TileType::NotSoil;
-            return ws.farmTiles[idx];
-        };
-        auto isOccupiedTile = [&occupied, &keyOf](int c, int r) -> bool {
-            return occupied.count(keyOf(c, r)) != 0;
-        };
-        auto markOccupiedTile = [&occupied, &keyOf](int c, int r) {
-            occupied.insert(keyOf(c, r));
-        };
-
-        TreeSystem::regrowNightlyWorldOnly(cols, rows, getTile, isOccupiedTile, markOccupiedTile);
-        RockSystem::regrowNightlyWorldOnly(cols, rows, getTile, isOccupiedTile, markOccupiedTile);
-        WeedSystem::regrowNightlyWorldOnly(cols, rows, getTile, isOccupiedTile, markOccupiedTile);
+    auto& furnaces = Game::FurnaceScheduler::getInstance();
+    for (int day = 0; day < days; ++day) {
+        long long minutesLeft = kMinutesPerDay - (ws.timeHour * 60 + ws.timeMinute);
+        if (minutesLeft > 0) {
+            furnaces.advance(static_cast<float>(minutesLeft) * GameConfig::REAL_SECONDS_PER_GAME_MINUTE);
+        }
+        NightPipeline night;
+        runNightPipeline(night, crop, nullptr, pool);
+        if (afterNight) afterNight(night);
     }
+    ws.pendingPassOut = false;
+    return days;
+}
+
+// 整段快进期间不派发事件、不刷新场景；“次日早晨”等事件在下一次 update 中补发一次。
+void GameStateController::sleepDays(int days) {
+    int advanced = advanceDaysWorldOnly(days > 0 ? days : 1, _crop, &Game::WorkerPool::shared(),
+                                        [this](const NightPipeline& night) { _lastNight = night; });
+    _dayIndex += advanced;
     if (_ui) _ui->refreshHUD();
+    submitAutosave();
+}
+
+void GameStateController::submitAutosave() {
+    auto &ws = Game::globalState();
     std::string path = Game::currentSavePath();
     if (path.empty()) {
         if (ws.lastSaveSlot < 1) ws.lastSaveSlot = 1;
         if (ws.lastSaveSlot > 50) ws.lastSaveSlot = 50;
         path = Game::savePathForSlot(ws.lastSaveSlot);
     }
-    Game::saveToFile(path);
+    // 自动存档在后台线程写盘；完成回调回到主线程时，若本控制器（及其 UI）仍存活则提示失败。
+    std::weak_ptr<int> alive = _aliveToken;
+    UIController* ui = _ui;
+    Game::saveToFileAsync(path, [alive, ui](bool ok, const std::string&) {
+        if (ok || alive.expired() || !ui) return;
+        ui->popCenterBigText("Autosave Failed", cocos2d::Color3B::RED);
+    });
 }
 
 }
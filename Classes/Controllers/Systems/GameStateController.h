@@ -1,11 +1,21 @@
 /**
- * GameStateController: 管理时间推进与每日事件（作物生长）。
+ * GameStateController: 管理时间推进与每日事件（作物生长），并提供按游戏时间触发的事件调度。
  */
 #pragma once
 
 #include "Controllers/Map/IMapController.h"
 #include "Controllers/UI/UIController.h"
 #include "Controllers/Systems/CropSystem.h"
+#include "Controllers/Systems/NightPipeline.h"
+#include <functional>
+#include <memory>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+namespace Game {
+class WorkerPool;
+}
 
 namespace Controllers {
 
@@ -13,17 +23,84 @@ class AnimalSystem;
 
 class GameStateController {
 public:
-    GameStateController(Controllers::IMapController* map, Controllers::UIController* ui, Controllers::CropSystem* crop)
-    : _map(map), _ui(ui), _crop(crop) {}
+    using EventId = unsigned long long;
+    using GameEvent = std::function<void()>;
 
+    // 构造时确定当天天气（新游戏/读档后第一次进入场景时可能尚未选择）。
+    GameStateController(Controllers::IMapController* map, Controllers::UIController* ui, Controllers::CropSystem* crop);
+
+    // 按 dt 一次性推进游戏分钟（到 24:00 时标记昏倒），随后派发所有已到期的事件。
     void update(float dt);
+    // 推进到次日早晨并结算每日事件（经夜间流水线并行执行），随后提交后台自动存档（不阻塞主线程）。
     void sleepToNextMorning();
+    // 快进 days 天（至少 1 天）：整段结算只写 WorldState，结束后提交一次后台自动存档。
+    // 调用方随后应重建场景一次（场景内的地图/掉落/作物显示不会逐日刷新）。
+    void sleepDays(int days);
+    // 最近一次夜间结算的各步骤计时。
+    const NightPipeline& lastNight() const { return _lastNight; }
+
+    // 组装并执行夜间结算流水线：日期推进之后，天气/作物/动物/障碍物再生互不依赖、并行执行；
+    // 浇水瓦片回退须等作物读完浇水状态、再生读完土壤类型之后。map 为农场时触碰地图的步骤留在当前线程。
+    // pool 为空时按添加顺序串行执行。无头模拟（WorldSimulation）也使用同一条流水线。
+    static void runNightPipeline(NightPipeline& pipeline, CropSystem* crop, IMapController* map, Game::WorkerPool* pool);
+    // 连续结算 days 个整天，不绑定地图、不存档：每天先让熔炉走完当天剩余的清醒时间（到 24:00），
+    // 再运行一次夜间流水线（日期/节日日期、天气、作物、动物产出、障碍物再生）。
+    // crop 为空时使用临时 CropSystem；afterNight 在每晚流水线结束后调用（可用于统计计时）。返回推进的天数。
+    static int advanceDaysWorldOnly(int days, CropSystem* crop, Game::WorkerPool* pool,
+                                    const std::function<void(const NightPipeline&)>& afterNight = nullptr);
+
+    // 以下为夜间流水线中的步骤，只读写 WorldState、不依赖场景。作物与动物的推进见 CropSystem / AnimalSystem。
+    // 日期 +1（跨季节）、恢复体力、时间回到 06:00。
+    static void advanceCalendarDay();
+    // 当天尚未选择天气时按存档槽与日期确定是否下雨；返回是否重新选择。
+    static bool ensureWeatherChosenForToday();
+    // 树/石头/杂草低于阈值时从空闲土壤集合中抽取位置补充生成（仅写 WorldState，含 farmTiles 的占用层）。
+    static void regrowFarmObstaclesNightly();
+
+    // 事件调度：订阅者只在事件到期时被唤醒，不必每帧检查日期/时间。
+    // - 时刻以“本控制器创建以来经过的天数 × 1440 + 当天分钟数”计，只增不减；
+    // - 到期事件在 update 中按时刻先后（同一时刻按调度顺序）触发，每个事件只触发一次，需要重复时在回调中重新调度；
+    // - 时间被跳过（T 键快进、睡觉到次日）时，跳过区间内的事件在下一次 update 中依次补发。
+    // 当前游戏时刻（分钟）。
+    long long nowMinutes() const;
+    // 在 hour:minute 触发；今天该时刻已到或已过则改为次日同一时刻。
+    EventId scheduleAt(int hour, int minute, GameEvent fn);
+    // 在 minutes 个游戏分钟后触发（至少 1 分钟）。
+    EventId scheduleInMinutes(int minutes, GameEvent fn);
+    // 在下一个早晨（次日 06:00，即 sleepToNextMorning 之后）触发。
+    EventId scheduleNextMorning(GameEvent fn);
+    // 取消尚未触发的事件；已触发或不存在时返回 false。
+    bool cancelEvent(EventId id);
 
 private:
+    struct ScheduledEvent {
+        long long due;
+        EventId id;
+    };
+    // priority_queue 默认大根堆：比较“更晚”者为小，堆顶即最早到期的事件。
+    struct LaterFirst {
+        bool operator()(const ScheduledEvent& a, const ScheduledEvent& b) const {
+            return a.due != b.due ? a.due > b.due : a.id > b.id;
+        }
+    };
+
+    EventId pushEvent(long long due, GameEvent fn);
+    // 提交后台自动存档（失败时若控制器仍存活则提示）。
+    void submitAutosave();
+    void dispatchDueEvents();
+
     Controllers::IMapController* _map = nullptr;
     Controllers::UIController* _ui = nullptr;
     Controllers::CropSystem* _crop = nullptr;
     Controllers::AnimalSystem* _animals = nullptr;
+    // 存活标记：后台存档回调持有其 weak_ptr，控制器销毁后回调不再访问 UI。
+    std::shared_ptr<int> _aliveToken = std::make_shared<int>(0);
+    // 事件队列：堆中只存时刻与编号，回调在 _eventHandlers 中；取消即删除回调，堆中条目出堆时跳过。
+    std::priority_queue<ScheduledEvent, std::vector<ScheduledEvent>, LaterFirst> _events;
+    std::unordered_map<EventId, GameEvent> _eventHandlers;
+    EventId _nextEventId = 0;
+    long long _dayIndex = 0;
+    NightPipeline _lastNight;
 
 public:
     void setAnimalSystem(Controllers::AnimalSystem* animals) { _animals = animals; }
@@ -0,0 +1,111 @@
+// 夜间结算流水线实现：
+// - 调度只在调用 run() 的线程上进行：工作线程完成步骤后把编号放回完成队列并唤醒调度线程，
+//   调度线程据此递减后继步骤的剩余依赖数，变为 0 的步骤再提交到线程池（或留给自己执行）；
+// - 每个步骤只写自己的计时槽，计时数组无需加锁。
+#include "Controllers/Systems/NightPipeline.h"
+#include "Game/WorkerPool.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace Controllers {
+
+namespace {
+
+using PipelineClock = std::chrono::steady_clock;
+
+double msBetween(PipelineClock::time_point a, PipelineClock::time_point b) {
+    return std::chrono::duration<double, std::milli>(b - a).count();
+}
+
+}
+
+NightPipeline::StageId NightPipeline::addStage(const std::string& name, StageFn fn, const std::vector<StageId>& deps, bool mainThread) {
+    StageId id = static_cast<StageId>(_stages.size());
+    Stage stage;
+    stage.fn = std::move(fn);
+    stage.mainThread = mainThread;
+    for (StageId dep : deps) {
+        if (dep < 0 || dep >= id) continue;
+        _stages[static_cast<std::size_t>(dep)].dependents.push_back(id);
+        stage.pendingDeps += 1;
+    }
+    _stages.push_back(std::move(stage));
+    StageTiming timing;
+    timing.name = name;
+    timing.mainThread = mainThread;
+    _timings.push_back(timing);
+    return id;
+}
+
+void NightPipeline::run(Game::WorkerPool* pool) {
+    const auto t0 = PipelineClock::now();
+    auto runStage = [this, t0](StageId id) {
+        auto start = PipelineClock::now();
+        auto& stage = _stages[static_cast<std::size_t>(id)];
+        if (stage.fn) stage.fn();
+        auto& timing = _timings[static_cast<std::size_t>(id)];
+        timing.startMs = msBetween(t0, start);
+        timing.ms = msBetween(start, PipelineClock::now());
+    };
+
+    const int count = static_cast<int>(_stages.size());
+    if (!pool || pool->size() == 0) {
+        for (StageId id = 0; id < count; ++id) {
+            _timings[static_cast<std::size_t>(id)].mainThread = true;
+            runStage(id);
+        }
+        _totalMs = msBetween(t0, PipelineClock::now());
+        return;
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<StageId> finished;
+    std::deque<StageId> mainReady;
+
+    // 调用时持有 mutex。工作线程在持锁状态下通知，保证 run() 返回（局部同步对象析构）前通知已完成。
+    auto dispatch = [&](StageId id) {
+        if (_stages[static_cast<std::size_t>(id)].mainThread) {
+            mainReady.push_back(id);
+            return;
+        }
+        pool->submit([&, id]() {
+            runStage(id);
+            std::lock_guard<std::mutex> lock(mutex);
+            finished.push_back(id);
+            cv.notify_all();
+        });
+    };
+
+    std::unique_lock<std::mutex> lock(mutex);
+    for (StageId id = 0; id < count; ++id) {
+        if (_stages[static_cast<std::size_t>(id)].pendingDeps == 0) dispatch(id);
+    }
+    int done = 0;
+    while (done < count) {
+        if (!mainReady.empty()) {
+            StageId id = mainReady.front();
+            mainReady.pop_front();
+            lock.unlock();
+            runStage(id);
+            lock.lock();
+            finished.push_back(id);
+        }
+        if (finished.empty()) {
+            cv.wait(lock, [&finished, &mainReady]() { return !finished.empty() || !mainReady.empty(); });
+        }
+        std::vector<StageId> batch;
+        batch.swap(finished);
+        for (StageId id : batch) {
+            ++done;
+            for (StageId next : _stages[static_cast<std::size_t>(id)].dependents) {
+                if (--_stages[static_cast<std::size_t>(next)].pendingDeps == 0) dispatch(next);
+            }
+        }
+    }
+    _totalMs = msBetween(t0, PipelineClock::now());
+}
+
+}
@@ -0,0 +1,55 @@
+/**
+ * NightPipeline：夜间结算的依赖图执行器。
+ */
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Game {
+class WorkerPool;
+}
+
+namespace Controllers {
+
+// 夜间结算流水线：
+// - 每个步骤声明其依赖的前序步骤，互不依赖的步骤在 WorkerPool 上并行执行，run() 在全部完成后返回；
+// - 依赖只能指向先添加的步骤，因此图天然无环；添加顺序同时是串行执行（无线程池）时的顺序；
+// - mainThread 标记的步骤（会触碰 cocos2d 节点，如绑定农场地图时的瓦片/掉落刷新）总在调用 run() 的线程上执行；
+// - 每个步骤记录开始时刻（相对 run() 开始）与耗时，供调试与无头模拟报告使用。
+class NightPipeline {
+public:
+    using StageId = int;
+    using StageFn = std::function<void()>;
+
+    struct StageTiming {
+        std::string name;
+        double startMs = 0.0;
+        double ms = 0.0;
+        bool mainThread = false;
+    };
+
+    StageId addStage(const std::string& name, StageFn fn, const std::vector<StageId>& deps = {}, bool mainThread = false);
+
+    // pool 为空（或没有线程）时按添加顺序在当前线程串行执行。每个流水线对象只运行一次。
+    void run(Game::WorkerPool* pool);
+
+    const std::vector<StageTiming>& timings() const { return _timings; }
+    // run() 的墙钟总耗时（毫秒）。
+    double totalMs() const { return _totalMs; }
+
+private:
+    struct Stage {
+        StageFn fn;
+        std::vector<StageId> dependents;
+        int pendingDeps = 0;
+        bool mainThread = false;
+    };
+
+    std::vector<Stage> _stages;
+    std::vector<StageTiming> _timings;
+    double _totalMs = 0.0;
+};
+
+}
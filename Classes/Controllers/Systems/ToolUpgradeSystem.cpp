@@ -76,6 +76,7 @@ bool ToolUpgradeSystem::upgradeToolOnce(const std::shared_ptr<Game::Inventory>&
                 return false;
             }
             t->setLevel(lv + 1);
+            inv->markSlotChanged(i);
             return true;
         }
     }
@@ -0,0 +1,236 @@
+// 无头多日模拟实现：
+// - 只操作 Game::globalState()，不创建任何节点；作物推进通过不绑定地图的 CropSystem 完成；
+// - 夜间结算走 GameStateController::runNightPipeline，各步骤计时取自流水线，报告中的“单日最长”便于发现换季等尖峰；
+// - 状态哈希为二进制存档各段内容的 FNV-1a（段内容对同一世界状态逐字节确定）。
+#include "Controllers/Systems/WorldSimulation.h"
+#include "Controllers/Systems/GameStateController.h"
+#include "Controllers/Systems/CropSystem.h"
+#include "Controllers/Systems/AnimalSystem.h"
+#include "Game/WorldState.h"
+#include "Game/GameConfig.h"
+#include "Game/Save/SaveSystem.h"
+#include "Game/Save/SaveBinary.h"
+#include "Game/WorkerPool.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+namespace Controllers {
+
+namespace {
+
+using SimClock = std::chrono::steady_clock;
+
+double msSince(SimClock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(SimClock::now() - t0).count();
+}
+
+// 一个被计时的步骤：累计总耗时与单日最长耗时。
+struct SimStage {
+    const char* name;
+    double totalMs = 0.0;
+    double maxMs = 0.0;
+
+    explicit SimStage(const char* n) : name(n) {}
+
+    void record(double ms) {
+        totalMs += ms;
+        maxMs = std::max(maxMs, ms);
+    }
+
+    template <typename Fn>
+    void run(Fn&& fn) {
+        auto t0 = SimClock::now();
+        fn();
+        record(msSince(t0));
+    }
+};
+
+const Game::CropType kSimCropTypes[] = {
+    Game::CropType::Parsnip, Game::CropType::Blueberry, Game::CropType::Eggplant,
+    Game::CropType::Corn, Game::CropType::Strawberry,
+};
+
+// 当季可种的作物类型；没有当季作物时返回空列表。
+std::vector<Game::CropType> cropsForSeason(int seasonIndex) {
+    std::vector<Game::CropType> types;
+    for (auto t : kSimCropTypes) {
+        if (Game::CropDefs::isSeasonAllowed(t, seasonIndex)) types.push_back(t);
+    }
+    return types;
+}
+
+Game::Crop makeSimCrop(Game::CropType type, int c, int r) {
+    Game::Crop cp;
+    cp.c = c;
+    cp.r = r;
+    cp.type = type;
+    cp.maxStage = Game::CropDefs::maxStage(type);
+    return cp;
+}
+
+// 压力测试农场：约一半土壤为耕地并种满当季作物，其余土壤上散布树/石头/杂草，另有若干成年动物。
+void buildStressWorld(const WorldSimOptions& options) {
+    auto& ws = Game::globalState();
+    ws = Game::WorldState();
+    ws.lastSaveSlot = 1 + static_cast<int>(options.seed % 50u);
+    std::mt19937 rng(options.seed);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    const int cols = std::max(1, options.stressCols);
+    const int rows = std::max(1, options.stressRows);
+    const float tile = static_cast<float>(GameConfig::TILE_SIZE);
+    ws.farmTiles.reset(cols, rows, Game::TileType::Soil);
+    std::vector<Game::CropType> types = cropsForSeason(ws.seasonIndex);
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            int roll = percent(rng);
+            if (roll < 50) {
+                ws.farmTiles.set(c, r, Game::TileType::Tilled);
+                if (types.empty()) continue;
+                Game::Crop cp = makeSimCrop(types[static_cast<std::size_t>(roll) % types.size()], c, r);
+                cp.stage = std::uniform_int_distribution<int>(0, std::max(0, cp.maxStage - 1))(rng);
+                ws.farmCrops.push_back(cp);
+            } else if (roll < 53) {
+                ws.farmTrees.push_back(Game::TreePos{ c, r, (roll & 1) ? Game::TreeKind::Tree1 : Game::TreeKind::Tree2 });
+            } else if (roll < 56) {
+                ws.farmRocks.push_back(Game::RockPos{ c, r, (roll & 1) ? Game::RockKind::Rock1 : Game::RockKind::Rock2 });
+            } else if (roll < 59) {
+                ws.farmWeeds.push_back(Game::WeedPos{ c, r });
+            }
+        }
+    }
+    ws.farmTiles.clearJournal();
+    Game::syncFarmBlockers(ws);
+
+    for (int i = 0; i < options.stressAnimals; ++i) {
+        Game::Animal a;
+        a.type = static_cast<Game::AnimalType>(i % 3);
+        a.pos = cocos2d::Vec2(static_cast<float>(percent(rng) % cols) * tile, static_cast<float>(percent(rng) % rows) * tile);
+        a.target = a.pos;
+        a.isAdult = true;
+        a.ageDays = 10;
+        ws.farmAnimals.push_back(a);
+    }
+}
+
+// 玩家杂务：给所有作物浇水、喂所有动物、在没有作物的耕地上补种当季作物。
+// 补种直接追加到 CropSystem 的列表（即 WorldState::farmCrops），索引在下次查找时自动重建。
+void doDailyChores(CropSystem& crops) {
+    auto& ws = Game::globalState();
+    auto& list = crops.crops();
+    std::fill(list.watered().begin(), list.watered().end(), static_cast<std::uint8_t>(1));
+    for (auto& a : ws.farmAnimals) a.fedToday = true;
+
+    const int cols = ws.farmTiles.cols();
+    const int rows = ws.farmTiles.rows();
+    std::vector<Game::CropType> types = cropsForSeason(ws.seasonIndex);
+    if (types.empty() || cols <= 0 || rows <= 0) return;
+    std::vector<char> planted(ws.farmTiles.size(), 0);
+    for (std::size_t i = 0; i < list.size(); ++i) {
+        int c = list.tileC()[i];
+        int r = list.tileR()[i];
+        if (c >= 0 && c < cols && r >= 0 && r < rows) {
+            planted[static_cast<std::size_t>(r) * cols + c] = 1;
+        }
+    }
+    for (std::size_t idx = 0; idx < planted.size(); ++idx) {
+        if (planted[idx] || ws.farmTiles.at(idx) != Game::TileType::Tilled) continue;
+        int c = static_cast<int>(idx % static_cast<std::size_t>(cols));
+        int r = static_cast<int>(idx / static_cast<std::size_t>(cols));
+        Game::Crop cp = makeSimCrop(types[idx % types.size()], c, r);
+        cp.wateredToday = true;
+        list.push_back(cp);
+    }
+}
+
+std::uint64_t worldStateHash(const Game::WorldState& ws) {
+    std::uint64_t h = 1469598103934665603ull;
+    for (const auto& section : encodeSaveSections(ws)) {
+        std::uint64_t sectionHash = fnv1a64(section.second.buffer().data(), section.second.size());
+        h = (h ^ section.first) * 1099511628211ull;
+        h = (h ^ sectionHash) * 1099511628211ull;
+    }
+    return h;
+}
+
+std::string hex64(std::uint64_t v) {
+    char buf[17];
+    std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(v));
+    return std::string(buf);
+}
+
+} // namespace
+
+int runWorldSimulation(const WorldSimOptions& options) {
+    auto& ws = Game::globalState();
+    if (!options.savePath.empty()) {
+        if (!Game::loadFromFile(options.savePath)) return 1;
+    } else {
+        buildStressWorld(options);
+    }
+    const std::uint64_t initialHash = worldStateHash(ws);
+
+    CropSystem crops;
+    SimStage chores("chores");
+    SimStage calendar("calendar");
+    SimStage weather("weather");
+    SimStage cropStage("crops");
+    SimStage animals("animals");
+    SimStage regrow("regrow");
+    SimStage dryTiles("dryTiles");
+    SimStage night("night");
+    SimStage* nightStages[] = { &calendar, &weather, &cropStage, &animals, &regrow, &dryTiles };
+    std::unique_ptr<Game::WorkerPool> pool;
+    if (options.workers > 0) pool.reset(new Game::WorkerPool(static_cast<unsigned int>(options.workers)));
+    int rainyDays = 0;
+
+    auto t0 = SimClock::now();
+    for (int day = 0; day < options.days; ++day) {
+        if (options.chores) chores.run([&crops]() { doDailyChores(crops); });
+        GameStateController::advanceDaysWorldOnly(1, &crops, pool.get(), [&](const NightPipeline& pipeline) {
+            night.record(pipeline.totalMs());
+            for (const auto& timing : pipeline.timings()) {
+                for (SimStage* stage : nightStages) {
+                    if (timing.name == stage->name) stage->record(timing.ms);
+                }
+            }
+        });
+        if (ws.isRaining) ++rainyDays;
+    }
+    const double totalMs = msSince(t0);
+
+    std::ostringstream report;
+    report << "{\"source\":\"" << (options.savePath.empty() ? "stress" : "save") << "\""
+           << ",\"days\":" << options.days << ",\"workers\":" << options.workers
+           << ",\"cols\":" << ws.farmTiles.cols() << ",\"rows\":" << ws.farmTiles.rows()
+           << ",\"totalMs\":" << totalMs
+           << ",\"msPerDay\":" << (options.days > 0 ? totalMs / options.days : 0.0)
+           << ",\"stages\":[";
+    const SimStage* stages[] = { &chores, &calendar, &weather, &cropStage, &animals, &regrow, &dryTiles, &night };
+    for (std::size_t i = 0; i < sizeof(stages) / sizeof(stages[0]); ++i) {
+        if (i > 0) report << ",";
+        report << "{\"name\":\"" << stages[i]->name << "\",\"totalMs\":" << stages[i]->totalMs
+               << ",\"maxMs\":" << stages[i]->maxMs << "}";
+    }
+    report << "],\"final\":{\"seasonIndex\":" << ws.seasonIndex << ",\"dayOfSeason\":" << ws.dayOfSeason
+           << ",\"rainyDays\":" << rainyDays
+           << ",\"crops\":" << ws.farmCrops.size() << ",\"drops\":" << ws.farmDrops.size()
+           << ",\"trees\":" << ws.farmTrees.size() << ",\"rocks\":" << ws.farmRocks.size()
+           << ",\"weeds\":" << ws.farmWeeds.size() << ",\"animals\":" << ws.farmAnimals.size() << "}"
+           << ",\"initialHash\":\"" << hex64(initialHash) << "\""
+           << ",\"stateHash\":\"" << hex64(worldStateHash(ws)) << "\"}\n";
+
+    std::ofstream out(options.reportPath, std::ios::trunc);
+    if (!out) return 1;
+    out << report.str();
+    out.close();
+    return out ? 0 : 1;
+}
+
+}
@@ -0,0 +1,33 @@
+/**
+ * WorldSimulation：无头多日模拟（开发者工具，不创建窗口与 Director）。
+ */
+#pragma once
+
+#include <string>
+
+namespace Controllers {
+
+// 模拟参数：
+// - savePath 非空时载入该存档，否则按 stressCols × stressRows 生成压力测试农场（约一半耕地种满作物）；
+// - 每天早上先做“玩家杂务”（给作物浇水、喂动物、在空耕地补种当季作物，可用 chores 关闭），
+//   再经 GameStateController::advanceDaysWorldOnly 结算一天：熔炉走完当天剩余时间，随后执行与 sleepToNextMorning
+//   相同的夜间结算流水线（workers > 0 时在该数量的线程上并行，否则串行；两种方式的状态哈希相同）；
+// - 结果以 JSON 写入 reportPath：各步骤总耗时/单日最长耗时、最终实体数量与状态哈希。
+//   night 为整条流水线的墙钟耗时。夜间结算的随机数由存档槽与日期派生，同一输入的状态哈希可直接用于回归比较。
+// 由启动参数 --simulate-days 触发，见 CommandLineModes.h。
+struct WorldSimOptions {
+    int days = 28;
+    std::string savePath;
+    int stressCols = 256;
+    int stressRows = 256;
+    int stressAnimals = 500;
+    bool chores = true;
+    unsigned int seed = 20240601u;
+    int workers = 0;
+    std::string reportPath = "world_sim_report.json";
+};
+
+// 返回 0 表示模拟完成且报告写入成功；存档载入失败或报告无法写入时返回 1。
+int runWorldSimulation(const WorldSimOptions& options);
+
+}
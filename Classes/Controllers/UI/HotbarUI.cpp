@@ -10,6 +10,7 @@ namespace Controllers {
 
 void HotbarUI::setInventoryBackground(const std::string& path) {
     _inventoryBgPath = path;
+    _layoutDirty = true;
     if (_hotbarNode) {
         if (_hotbarBgSprite) {
             _hotbarBgSprite->removeFromParent();
@@ -154,34 +155,70 @@ void HotbarUI::buildHotbar() {
         }
     }
 
+    _layoutDirty = true;
     refreshHotbar();
 }
 
+float HotbarUI::SlotLayout::centerX(int i) const {
+    return imageBg
+        ? (-innerW/2 + (i + 0.5f) * cellW)
+        : (-totalWidth/2 + i * (slotW + padding) + slotW/2);
+}
+
+HotbarUI::SlotLayout HotbarUI::computeLayout(int slots) const {
+    SlotLayout layout;
+    float slotH = 32.0f * _hotbarScale;
+    layout.slotW = 80.0f * _hotbarScale;
+    layout.padding = 6.0f * _hotbarScale;
+    layout.totalWidth = slots * layout.slotW + (slots - 1) * layout.padding;
+    layout.imageBg = (_hotbarBgSprite != nullptr);
+    float innerH = 0.0f;
+    if (layout.imageBg) {
+        auto cs = _hotbarBgSprite->getContentSize();
+        float bgScaledW = cs.width * _hotbarBgSprite->getScaleX();
+        float bgScaledH = cs.height * _hotbarBgSprite->getScaleY();
+        layout.innerW = bgScaledW * 0.96f;
+        innerH = bgScaledH * (64.0f / 96.0f);
+    }
+    layout.cellW = layout.imageBg ? (layout.innerW / std::max(1, slots)) : layout.slotW;
+    layout.cellH = layout.imageBg ? innerH : slotH;
+    return layout;
+}
+
 void HotbarUI::refreshHotbar() {
     if (!_hotbarNode || !_hotbarHighlight || !_inventory) return;
     int slots = static_cast<int>(_inventory->size());
     if (slots <= 0) return;
-    float slotW = 80.0f * _hotbarScale, slotH = 32.0f * _hotbarScale, padding = 6.0f * _hotbarScale;
-    float totalWidth = slots * slotW + (slots - 1) * padding;
-    bool imageBg = (_hotbarBgSprite != nullptr);
-    float bgScaledW = 0.0f, bgScaledH = 0.0f;
-    float innerW = 0.0f, innerH = 0.0f;
-    if (imageBg) {
-        auto cs = _hotbarBgSprite->getContentSize();
-        bgScaledW = cs.width * _hotbarBgSprite->getScaleX();
-        bgScaledH = cs.height * _hotbarBgSprite->getScaleY();
-        innerW = bgScaledW * 0.96f;
-        innerH = bgScaledH * (64.0f / 96.0f);
-    }
-    float cellW = imageBg ? (innerW / std::max(1, slots)) : slotW;
-    float cellH = imageBg ? innerH : slotH;
     int sel = _inventory->selectedIndex();
-    float x = imageBg
-        ? (-innerW/2 + (sel + 0.5f) * cellW)
-        : (-totalWidth/2 + sel * (slotW + padding) + slotW/2);
+    unsigned long long revision = _inventory->revision();
+    bool selChanged = (sel != _shownSelected);
+    if (!_layoutDirty && !selChanged && revision == _shownRevision) return;
+
+    SlotLayout layout = computeLayout(slots);
+    bool fullRedraw = _layoutDirty || _shownSlotRevisions.size() != static_cast<std::size_t>(slots);
+    if (fullRedraw) _shownSlotRevisions.assign(slots, 0);
+    if (fullRedraw || selChanged) refreshHighlight(sel, layout);
+
+    bool selSlotChanged = false;
+    for (int i = 0; i < slots && i < static_cast<int>(_hotbarLabels.size()); ++i) {
+        unsigned int slotRev = _inventory->slotRevision(i);
+        if (!fullRedraw && _shownSlotRevisions[i] == slotRev) continue;
+        refreshSlot(i, layout);
+        _shownSlotRevisions[i] = slotRev;
+        if (i == sel) selSlotChanged = true;
+    }
+    if (fullRedraw || selChanged || selSlotChanged) refreshSelectedHint(sel, layout);
+
+    _layoutDirty = false;
+    _shownSelected = sel;
+    _shownRevision = revision;
+}
+
+void HotbarUI::refreshHighlight(int sel, const SlotLayout& layout) {
+    float x = layout.centerX(sel);
     _hotbarHighlight->clear();
     // 选一个正方形边长（用较小的那个，避免越出槽位太多）
-    float side = std::min(cellW, cellH);
+    float side = std::min(layout.cellW, layout.cellH);
     float half = side * 0.5f;
 
     Vec2 a(x - half, -half);
@@ -194,153 +231,150 @@ void HotbarUI::refreshHotbar() {
     _hotbarHighlight->drawLine(b, c, col);
     _hotbarHighlight->drawLine(c, d, col);
     _hotbarHighlight->drawLine(d, a, col);
+}
 
-    std::string selectedHint;
-    float hintY = cellH * 0.5f + 10.0f;
+void HotbarUI::refreshSlot(int i, const SlotLayout& layout) {
+    float cellW = layout.cellW;
+    float cellH = layout.cellH;
+    auto label = _hotbarLabels[i];
+    auto icon = (i < static_cast<int>(_hotbarIcons.size())) ? _hotbarIcons[i] : nullptr;
+    auto qtyLabel = (i < static_cast<int>(_hotbarQtyLabels.size())) ? _hotbarQtyLabels[i] : nullptr;
+    float cx = layout.centerX(i);
 
-    for (int i = 0; i < slots && i < static_cast<int>(_hotbarLabels.size()); ++i) {
-        auto label = _hotbarLabels[i];
-        auto icon = (i < static_cast<int>(_hotbarIcons.size())) ? _hotbarIcons[i] : nullptr;
-        auto qtyLabel = (i < static_cast<int>(_hotbarQtyLabels.size())) ? _hotbarQtyLabels[i] : nullptr;
-        float cx = imageBg
-            ? (-innerW/2 + (i + 0.5f) * cellW)
-            : (-totalWidth/2 + i * (slotW + padding) + slotW/2);
-
-        if (auto tConst = _inventory->toolAt(i)) {
-            auto t = _inventory->toolAtMutable(i);
-            if (label) label->setVisible(false);
-            if (qtyLabel) qtyLabel->setVisible(false);
-            if (icon) {
-                std::string path = tConst->iconPath();
-                if (!path.empty()) {
-                    icon->setTexture(path);
-                    if (icon->getTexture()) {
-                        auto cs = icon->getContentSize();
-                        float targetH = cellH;
-                        float targetW = cellW;
-                        float sx = (cs.width > 0) ? (targetW / cs.width) : 1.0f;
-                        float sy = (cs.height > 0) ? (targetH / cs.height) : 1.0f;
-                        float scale = std::min(sx, sy)* 0.8f;
-                        icon->setScale(scale);
-                        icon->setPosition(Vec2(cx, 0));
-                        icon->setVisible(true);
-                        if (t) t->attachHotbarOverlay(icon, cellW, cellH);
-                    } else {
-                        icon->setVisible(false);
-                        if (t) t->detachHotbarOverlay();
-                        if (label) { // 回退显示工具名称
-                            label->setString(tConst->displayName());
-                            label->setPosition(Vec2(cx, 0));
-                            label->setVisible(true);
-                        }
-                    }
+    if (auto tConst = _inventory->toolAt(i)) {
+        auto t = _inventory->toolAtMutable(i);
+        if (label) label->setVisible(false);
+        if (qtyLabel) qtyLabel->setVisible(false);
+        if (icon) {
+            std::string path = tConst->iconPath();
+            if (!path.empty()) {
+                icon->setTexture(path);
+                if (icon->getTexture()) {
+                    auto cs = icon->getContentSize();
+                    float targetH = cellH;
+                    float targetW = cellW;
+                    float sx = (cs.width > 0) ? (targetW / cs.width) : 1.0f;
+                    float sy = (cs.height > 0) ? (targetH / cs.height) : 1.0f;
+                    float scale = std::min(sx, sy)* 0.8f;
+                    icon->setScale(scale);
+                    icon->setPosition(Vec2(cx, 0));
+                    icon->setVisible(true);
+                    if (t) t->attachHotbarOverlay(icon, cellW, cellH);
                 } else {
                     icon->setVisible(false);
                     if (t) t->detachHotbarOverlay();
-                    if (label) { // 无图标路径时回退显示工具名称
+                    if (label) { // 回退显示工具名称
                         label->setString(tConst->displayName());
                         label->setPosition(Vec2(cx, 0));
                         label->setVisible(true);
                     }
                 }
-            }
-            if (i == sel) {
-                selectedHint = tConst->displayName();
-            }
-        } else if (_inventory->isItem(i)) {
-            auto st = _inventory->itemAt(i);
-            std::string text = StringUtils::format("%s x%d", Game::itemName(st.type), st.quantity);
-            bool hasIconTexture = !Game::itemIconPath(st.type).empty();
-            if (label) {
-                if (hasIconTexture) {
-                    label->setVisible(false);
-                } else {
-                    label->setString(text);
+            } else {
+                icon->setVisible(false);
+                if (t) t->detachHotbarOverlay();
+                if (label) { // 无图标路径时回退显示工具名称
+                    label->setString(tConst->displayName());
                     label->setPosition(Vec2(cx, 0));
                     label->setVisible(true);
-                    if (Game::isFish(st.type)) {
-                        label->setColor(Color3B(64, 200, 255));
-                    } else {
-                        label->setColor(Color3B::WHITE);
-                    }
                 }
             }
-            if (qtyLabel) {
-                if (st.quantity > 1) {
-                    qtyLabel->setString(StringUtils::format("%d", st.quantity));
-                    float offsetX = cellW * 0.5f - 6.0f;
-                    float offsetY = -cellH * 0.5f + 4.0f;
-                    qtyLabel->setPosition(Vec2(cx + offsetX, offsetY));
-                    qtyLabel->setVisible(true);
+        }
+    } else if (_inventory->isItem(i)) {
+        auto st = _inventory->itemAt(i);
+        bool hasIconTexture = !Game::itemIconPath(st.type).empty();
+        if (label) {
+            if (hasIconTexture) {
+                label->setVisible(false);
+            } else {
+                label->setString(StringUtils::format("%s x%d", Game::itemName(st.type), st.quantity));
+                label->setPosition(Vec2(cx, 0));
+                label->setVisible(true);
+                if (Game::isFish(st.type)) {
+                    label->setColor(Color3B(64, 200, 255));
                 } else {
-                    qtyLabel->setVisible(false);
+                    label->setColor(Color3B::WHITE);
                 }
             }
-            if (icon) {
-                if (st.quantity > 0) {
-                    std::string path = Game::itemIconPath(st.type);
-                    if (path.empty()) {
-                        if (Game::isFish(st.type)) {
-                            path = "fish/globefish.png";
-                        } else {
-                            switch (st.type) {
-                                case Game::ItemType::Coal:         path = "Mineral/Coal.png"; break;
-                                case Game::ItemType::CopperGrain: path = "Mineral/copperGrain.png"; break;
-                                case Game::ItemType::CopperIngot: path = "Mineral/copperIngot.png"; break;
-                                case Game::ItemType::IronGrain:   path = "Mineral/ironGrain.png"; break;
-                                case Game::ItemType::IronIngot:   path = "Mineral/ironIngot.png"; break;
-                                case Game::ItemType::GoldGrain:   path = "Mineral/goldGrain.png"; break;
-                                case Game::ItemType::GoldIngot:   path = "Mineral/goldIngot.png"; break;
-                                default: break;
-                            }
+        }
+        if (qtyLabel) {
+            if (st.quantity > 1) {
+                qtyLabel->setString(StringUtils::format("%d", st.quantity));
+                float offsetX = cellW * 0.5f - 6.0f;
+                float offsetY = -cellH * 0.5f + 4.0f;
+                qtyLabel->setPosition(Vec2(cx + offsetX, offsetY));
+                qtyLabel->setVisible(true);
+            } else {
+                qtyLabel->setVisible(false);
+            }
+        }
+        if (icon) {
+            if (st.quantity > 0) {
+                std::string path = Game::itemIconPath(st.type);
+                if (path.empty()) {
+                    if (Game::isFish(st.type)) {
+                        path = "fish/globefish.png";
+                    } else {
+                        switch (st.type) {
+                            case Game::ItemType::Coal:         path = "Mineral/Coal.png"; break;
+                            case Game::ItemType::CopperGrain: path = "Mineral/copperGrain.png"; break;
+                            case Game::ItemType::CopperIngot: path = "Mineral/copperIngot.png"; break;
+                            case Game::ItemType::IronGrain:   path = "Mineral/ironGrain.png"; break;
+                            case Game::ItemType::IronIngot:   path = "Mineral/ironIngot.png"; break;
+                            case Game::ItemType::GoldGrain:   path = "Mineral/goldGrain.png"; break;
+                            case Game::ItemType::GoldIngot:   path = "Mineral/goldIngot.png"; break;
+                            default: break;
                         }
                     }
-                    if (!path.empty()) {
-                        icon->setTexture(path);
-                        if (icon->getTexture()) {
-                            auto cs = icon->getContentSize();
-                            float targetH = cellH;
-                            float targetW = cellW;
-                            float sx = (cs.width > 0) ? (targetW / cs.width) : 1.0f;
-                            float sy = (cs.height > 0) ? (targetH / cs.height) : 1.0f;
-                            float scale = std::min(sx, sy) * 0.8;
-                            icon->setScale(scale);
-                            icon->setPosition(Vec2(cx, 0));
-                            icon->setVisible(true);
-                        } else {
-                            icon->setVisible(false);
-                        }
+                }
+                if (!path.empty()) {
+                    icon->setTexture(path);
+                    if (icon->getTexture()) {
+                        auto cs = icon->getContentSize();
+                        float targetH = cellH;
+                        float targetW = cellW;
+                        float sx = (cs.width > 0) ? (targetW / cs.width) : 1.0f;
+                        float sy = (cs.height > 0) ? (targetH / cs.height) : 1.0f;
+                        float scale = std::min(sx, sy) * 0.8;
+                        icon->setScale(scale);
+                        icon->setPosition(Vec2(cx, 0));
+                        icon->setVisible(true);
                     } else {
                         icon->setVisible(false);
                     }
                 } else {
                     icon->setVisible(false);
                 }
+            } else {
+                icon->setVisible(false);
             }
-
-            if (i == sel) {
-                selectedHint = StringUtils::format("%s x%d", Game::itemName(st.type), st.quantity);
-            }
-        } else {
-            if (label) {
-                label->setString("-");
-                label->setPosition(Vec2(cx, 0));
-                label->setVisible(true);
-                label->setColor(Color3B::WHITE);
-            }
-            if (icon) icon->setVisible(false);
-            if (qtyLabel) qtyLabel->setVisible(false);
         }
+    } else {
+        if (label) {
+            label->setString("-");
+            label->setPosition(Vec2(cx, 0));
+            label->setVisible(true);
+            label->setColor(Color3B::WHITE);
+        }
+        if (icon) icon->setVisible(false);
+        if (qtyLabel) qtyLabel->setVisible(false);
     }
+}
 
-    if (_selectedHintLabel) {
-        if (!selectedHint.empty()) {
-            _selectedHintLabel->setString(selectedHint);
-            _selectedHintLabel->setPosition(Vec2(0.0f, hintY));
-            _selectedHintLabel->setVisible(true);
-        } else {
-            _selectedHintLabel->setVisible(false);
-        }
+void HotbarUI::refreshSelectedHint(int sel, const SlotLayout& layout) {
+    if (!_selectedHintLabel) return;
+    std::string selectedHint;
+    if (auto t = _inventory->toolAt(sel)) {
+        selectedHint = t->displayName();
+    } else if (_inventory->isItem(sel)) {
+        auto st = _inventory->itemAt(sel);
+        selectedHint = StringUtils::format("%s x%d", Game::itemName(st.type), st.quantity);
+    }
+    if (!selectedHint.empty()) {
+        _selectedHintLabel->setString(selectedHint);
+        _selectedHintLabel->setPosition(Vec2(0.0f, layout.cellH * 0.5f + 10.0f));
+        _selectedHintLabel->setVisible(true);
+    } else {
+        _selectedHintLabel->setVisible(false);
     }
 }
 
@@ -12,6 +12,7 @@ namespace Controllers {
 // - 作用：构建并刷新热键栏（物品图标/数量/选中高亮），并处理点击与滚轮切换。
 // - 职责边界：只做 UI 呈现与输入命中检测，不实现背包规则；物品数据来自 Inventory。
 // - 主要协作对象：UIController 负责统一调度；Inventory 提供槽位物品与数量；输入事件由 Scene/Controller 转发。
+// - 刷新策略：记录每个槽位上次显示时的版本号与选中索引，只重绘内容或选中状态发生变化的部分。
 class HotbarUI {
 public:
     // 构造：绑定场景与背包引用；节点在 buildHotbar 中创建。
@@ -23,7 +24,7 @@ public:
     void setInventoryBackground(const std::string& path);
     // 构建热键栏节点（只创建一次，后续复用）。
     void buildHotbar();
-    // 刷新热键栏内容（图标/数量/选中提示）。
+    // 刷新热键栏内容（图标/数量/选中提示）；背包与选中均无变化时直接返回。
     void refreshHotbar();
     // 选中指定热键栏索引并刷新高亮。
     void selectHotbarIndex(int idx);
@@ -37,9 +38,26 @@ public:
     // 获取热键栏缩放。
     float getScale() const { return _hotbarScale; }
     // 设置热键栏缩放。
-    void setScale(float s) { _hotbarScale = s; }
+    void setScale(float s) { _hotbarScale = s; _layoutDirty = true; }
 
 private:
+    // 槽位布局：由缩放与背景贴图决定，布局变化时需全量重绘。
+    struct SlotLayout {
+        bool imageBg = false;
+        float slotW = 0.0f;
+        float padding = 0.0f;
+        float totalWidth = 0.0f;
+        float innerW = 0.0f;
+        float cellW = 0.0f;
+        float cellH = 0.0f;
+        float centerX(int i) const;
+    };
+
+    SlotLayout computeLayout(int slots) const;
+    void refreshHighlight(int sel, const SlotLayout& layout);
+    void refreshSlot(int i, const SlotLayout& layout);
+    void refreshSelectedHint(int sel, const SlotLayout& layout);
+
     cocos2d::Scene* _scene = nullptr;
     std::shared_ptr<Game::Inventory> _inventory;
 
@@ -52,6 +70,11 @@ private:
     cocos2d::Sprite* _hotbarBgSprite = nullptr;
     std::string _inventoryBgPath;
     float _hotbarScale = 1.0f;
+
+    bool _layoutDirty = true;
+    int _shownSelected = -1;
+    unsigned long long _shownRevision = 0;
+    std::vector<unsigned int> _shownSlotRevisions;
 };
 
 }
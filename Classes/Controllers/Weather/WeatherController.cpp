@@ -9,29 +9,10 @@ namespace Controllers {
 WeatherController::WeatherController(IMapController* map, cocos2d::Node* worldNode, PlayerController* playerController)
     : _map(map), _worldNode(worldNode), _playerController(playerController) {
     syncFromWorldState(true);
-    auto& ws = Game::globalState();
-    _appliedSeasonIndex = ws.seasonIndex;
-    _appliedDayOfSeason = ws.dayOfSeason;
 }
 
-void WeatherController::update(float dt) {
-    auto& ws = Game::globalState();
-    bool isNewDay = (ws.seasonIndex != _appliedSeasonIndex) || (ws.dayOfSeason != _appliedDayOfSeason);
-
-    WeatherKind desired = ws.isRaining ? WeatherKind::Rainy : WeatherKind::Sunny;
-    if (isNewDay || desired != _weather) {
-        _weather = desired;
-        _appliedSeasonIndex = ws.seasonIndex;
-        _appliedDayOfSeason = ws.dayOfSeason;
-        syncFromWorldState(isNewDay || _weather == WeatherKind::Rainy);
-    }
-
-    if (_weather == WeatherKind::Rainy && _map && _worldNode && _map->supportsWeather()) {
-        if (_rainLayer) {
-            _rainLayer->setPosition(_map->getOrigin());
-            _rainLayer->setArea(_map->getContentSize());
-        }
-    }
+void WeatherController::onNewDay() {
+    syncFromWorldState(true);
 }
 
 void WeatherController::setWeather(WeatherKind w) {
@@ -40,8 +21,6 @@ void WeatherController::setWeather(WeatherKind w) {
     ws.weatherSeasonIndex = ws.seasonIndex;
     ws.weatherDayOfSeason = ws.dayOfSeason;
     _weather = w;
-    _appliedSeasonIndex = ws.seasonIndex;
-    _appliedDayOfSeason = ws.dayOfSeason;
     syncFromWorldState(true);
 }
 
@@ -60,7 +39,11 @@ void WeatherController::syncFromWorldState(bool forceApplyRainWatering) {
         ensureDimLayer();
         if (_dimLayer) _dimLayer->setVisible(true);
         ensureRainLayer();
-        if (_rainLayer) _rainLayer->setActive(true);
+        if (_rainLayer) {
+            _rainLayer->setPosition(_map->getOrigin());
+            _rainLayer->setArea(_map->getContentSize());
+            _rainLayer->setActive(true);
+        }
 
         if (forceApplyRainWatering) {
             _map->setAllPlantableTilesWatered();
@@ -24,8 +24,8 @@ public:
     // 绑定地图/世界节点/玩家控制器；会立即按当前全局状态应用一次天气效果。
     WeatherController(IMapController* map, cocos2d::Node* worldNode, PlayerController* playerController);
 
-    // 每帧更新：检测“跨天”并刷新天气，同时把效果同步到地图/玩家/亮度。
-    void update(float dt);
+    // 跨天时调用（由场景订阅 GameStateController 的“次日早晨”事件触发）：按新一天的天气重新同步效果。
+    void onNewDay();
 
     // 强制设置天气（同时写入全局状态并同步效果）。
     void setWeather(WeatherKind w);
@@ -46,8 +46,6 @@ private:
     RainLayer* _rainLayer = nullptr;
 
     WeatherKind _weather = WeatherKind::Sunny;
-    int _appliedSeasonIndex = -1;
-    int _appliedDayOfSeason = -1;
 };
 
 } // namespace Controllers
@@ -10,7 +10,7 @@ namespace Game {
 // 作物类型：用于索引作物静态定义（CropDefs）与行为实现（CropBase 派生类）。
 enum class CropType { Parsnip, Blueberry, Eggplant, Corn, Strawberry };
 
-// 作物运行时状态：由 CropSystem 作为唯一来源持有并推进。
+// 作物运行时状态（单条记录视图）：实际按列存放在 CropStore 中，由 CropSystem 推进。
 struct Crop {
     int c = 0; // 网格列坐标（tile c）
     int r = 0; // 网格行坐标（tile r）
@@ -0,0 +1,103 @@
+#include "Game/Crops/crop/CropStore.h"
+
+namespace Game {
+
+namespace {
+
+template <typename T>
+void moveLastInto(std::vector<T>& v, std::size_t i) {
+    v[i] = v.back();
+    v.pop_back();
+}
+
+template <typename T>
+void compactColumn(std::vector<T>& v, const std::vector<std::uint8_t>& keep) {
+    std::size_t out = 0;
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        v[out] = v[i];
+        out += keep[i] ? 1u : 0u;
+    }
+    v.resize(out);
+}
+
+} // namespace
+
+void CropStore::clear() {
+    _c.clear();
+    _r.clear();
+    _type.clear();
+    _stage.clear();
+    _progress.clear();
+    _maxStage.clear();
+    _watered.clear();
+    _flags.clear();
+}
+
+void CropStore::reserve(std::size_t n) {
+    _c.reserve(n);
+    _r.reserve(n);
+    _type.reserve(n);
+    _stage.reserve(n);
+    _progress.reserve(n);
+    _maxStage.reserve(n);
+    _watered.reserve(n);
+    _flags.reserve(n);
+}
+
+void CropStore::push_back(const Crop& cp) {
+    _c.push_back(cp.c);
+    _r.push_back(cp.r);
+    _type.push_back(static_cast<std::uint8_t>(cp.type));
+    _stage.push_back(cp.stage);
+    _progress.push_back(cp.progress);
+    _maxStage.push_back(cp.maxStage);
+    _watered.push_back(cp.wateredToday ? 1u : 0u);
+    _flags.push_back(CropDefs::isRegrow(cp.type) ? static_cast<std::uint8_t>(FlagRegrow) : std::uint8_t{0});
+}
+
+Crop CropStore::get(std::size_t i) const {
+    Crop cp;
+    cp.c = _c[i];
+    cp.r = _r[i];
+    cp.type = static_cast<CropType>(_type[i]);
+    cp.stage = _stage[i];
+    cp.progress = _progress[i];
+    cp.maxStage = _maxStage[i];
+    cp.wateredToday = _watered[i] != 0;
+    return cp;
+}
+
+void CropStore::set(std::size_t i, const Crop& cp) {
+    _c[i] = cp.c;
+    _r[i] = cp.r;
+    _type[i] = static_cast<std::uint8_t>(cp.type);
+    _stage[i] = cp.stage;
+    _progress[i] = cp.progress;
+    _maxStage[i] = cp.maxStage;
+    _watered[i] = cp.wateredToday ? 1u : 0u;
+    _flags[i] = CropDefs::isRegrow(cp.type) ? static_cast<std::uint8_t>(FlagRegrow) : std::uint8_t{0};
+}
+
+void CropStore::swapRemove(std::size_t i) {
+    moveLastInto(_c, i);
+    moveLastInto(_r, i);
+    moveLastInto(_type, i);
+    moveLastInto(_stage, i);
+    moveLastInto(_progress, i);
+    moveLastInto(_maxStage, i);
+    moveLastInto(_watered, i);
+    moveLastInto(_flags, i);
+}
+
+void CropStore::compact(const std::vector<std::uint8_t>& keep) {
+    compactColumn(_c, keep);
+    compactColumn(_r, keep);
+    compactColumn(_type, keep);
+    compactColumn(_stage, keep);
+    compactColumn(_progress, keep);
+    compactColumn(_maxStage, keep);
+    compactColumn(_watered, keep);
+    compactColumn(_flags, keep);
+}
+
+} // namespace Game
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Game/Crops/crop/CropBase.h"
+
+namespace Game {
+
+// CropStore：农场作物的按列存储（structure-of-arrays）。
+// - 每个字段一条连续数组，夜间推进可以对整列做无分支循环，便于编译器自动向量化。
+// - Crop 结构体仍作为单条记录的读写视图（get/set/push_back），存档与 UI 按条访问。
+// - 列访问器返回的数组可以原地修改取值，但不得改变长度；增删一律走 push_back/swapRemove/compact。
+class CropStore {
+public:
+    // flags 列的位定义：种植时由 CropDefs 缓存，夜间推进不再按类型查询。
+    enum Flag : std::uint8_t { FlagRegrow = 1u << 0 };
+
+    std::size_t size() const { return _c.size(); }
+    bool empty() const { return _c.empty(); }
+    void clear();
+    void reserve(std::size_t n);
+
+    void push_back(const Crop& cp);
+    Crop get(std::size_t i) const;
+    void set(std::size_t i, const Crop& cp);
+    // 用末尾记录覆盖 i 并弹出末尾（O(1)，不保持顺序）。
+    void swapRemove(std::size_t i);
+    // 只保留 keep[i] != 0 的记录，保持原有顺序；keep 长度须等于 size()。
+    void compact(const std::vector<std::uint8_t>& keep);
+
+    const std::vector<int>& tileC() const { return _c; }
+    const std::vector<int>& tileR() const { return _r; }
+    const std::vector<std::uint8_t>& types() const { return _type; }
+    const std::vector<int>& stages() const { return _stage; }
+    const std::vector<int>& progress() const { return _progress; }
+    const std::vector<int>& maxStages() const { return _maxStage; }
+    const std::vector<std::uint8_t>& watered() const { return _watered; }
+    const std::vector<std::uint8_t>& flags() const { return _flags; }
+
+    std::vector<int>& stages() { return _stage; }
+    std::vector<int>& progress() { return _progress; }
+    std::vector<std::uint8_t>& watered() { return _watered; }
+
+    CropType typeAt(std::size_t i) const { return static_cast<CropType>(_type[i]); }
+    bool isRegrow(std::size_t i) const { return (_flags[i] & FlagRegrow) != 0; }
+
+private:
+    std::vector<int> _c;
+    std::vector<int> _r;
+    std::vector<std::uint8_t> _type;
+    std::vector<int> _stage;
+    std::vector<int> _progress;
+    std::vector<int> _maxStage;
+    std::vector<std::uint8_t> _watered;
+    std::vector<std::uint8_t> _flags;
+};
+
+} // namespace Game
@@ -14,6 +14,42 @@ static std::string toolDropIconPath(Game::ToolKind tk, int level) {
     return tool->iconPath();
 }
 
+static std::string dropIconPath(const Drop& d) {
+    int raw = static_cast<int>(d.type);
+    if (isToolDropRaw(raw)) {
+        return toolDropIconPath(toolKindFromDropRaw(raw), toolLevelFromDropRaw(raw));
+    }
+    return Game::itemIconPath(d.type);
+}
+
+cocos2d::Sprite* Drop::createSprite(const Drop& d) {
+    std::string path = dropIconPath(d);
+    if (path.empty()) return nullptr;
+    auto spr = cocos2d::Sprite::create(path);
+    if (!spr || !spr->getTexture()) return nullptr;
+    float radius = GameConfig::DROP_DRAW_RADIUS;
+    auto cs = spr->getContentSize();
+    if (cs.width > 0 && cs.height > 0) {
+        float targetSize = radius * 2.0f;
+        float sx = targetSize / cs.width;
+        float sy = targetSize / cs.height;
+        float scale = std::min(sx, sy);
+        spr->setScale(scale);
+    }
+    spr->setPosition(d.pos);
+    return spr;
+}
+
+void Drop::drawFallback(const Drop& d, cocos2d::DrawNode* draw) {
+    if (!draw) return;
+    cocos2d::Color4F color = Game::itemColor(d.type);
+    if (isToolDropRaw(static_cast<int>(d.type))) {
+        color = cocos2d::Color4F(0.95f, 0.95f, 0.95f, 1.0f);
+    }
+    draw->drawSolidCircle(d.pos, GameConfig::DROP_DRAW_RADIUS, 0.0f, 12, color);
+    draw->drawCircle(d.pos, GameConfig::DROP_DRAW_RADIUS, 0.0f, 12, false, cocos2d::Color4F(0, 0, 0, 0.4f));
+}
+
 void Drop::renderDrops(const std::vector<Drop>& drops, cocos2d::Node* root, cocos2d::DrawNode* draw) {
     if (!draw) return;
     draw->clear();
@@ -21,44 +57,40 @@ void Drop::renderDrops(const std::vector<Drop>& drops, cocos2d::Node* root, coco
         root->removeAllChildren();
     }
     for (const auto& d : drops) {
-        bool usedSprite = false;
-        int raw = static_cast<int>(d.type);
-        std::string path;
-        if (isToolDropRaw(raw)) {
-            Game::ToolKind tk = toolKindFromDropRaw(raw);
-            int level = toolLevelFromDropRaw(raw);
-            path = toolDropIconPath(tk, level);
+        cocos2d::Sprite* spr = root ? createSprite(d) : nullptr;
+        if (spr) {
+            root->addChild(spr);
         } else {
-            path = Game::itemIconPath(d.type);
+            drawFallback(d, draw);
         }
-        if (root) {
-            if (!path.empty()) {
-                auto spr = cocos2d::Sprite::create(path);
-                if (spr && spr->getTexture()) {
-                    float radius = GameConfig::DROP_DRAW_RADIUS;
-                    auto cs = spr->getContentSize();
-                    if (cs.width > 0 && cs.height > 0) {
-                        float targetSize = radius * 2.0f;
-                        float sx = targetSize / cs.width;
-                        float sy = targetSize / cs.height;
-                        float scale = std::min(sx, sy);
-                        spr->setScale(scale);
-                    }
-                    spr->setPosition(d.pos);
-                    root->addChild(spr);
-                    usedSprite = true;
+    }
+}
+
+bool Drop::tryPickup(Drop& d, Game::Inventory* inv) {
+    if (!inv) return false;
+    int raw = static_cast<int>(d.type);
+    if (isToolDropRaw(raw)) {
+        Game::ToolKind tk = toolKindFromDropRaw(raw);
+        int level = toolLevelFromDropRaw(raw);
+        std::size_t sz = inv->size();
+        for (std::size_t i = 0; i < sz; ++i) {
+            if (inv->isEmpty(i)) {
+                auto tool = Game::makeTool(tk);
+                if (tool) {
+                    tool->setLevel(level);
                 }
+                inv->setTool(i, tool);
+                return true;
             }
         }
-        if (!usedSprite) {
-            cocos2d::Color4F color = Game::itemColor(d.type);
-            if (isToolDropRaw(raw)) {
-                color = cocos2d::Color4F(0.95f, 0.95f, 0.95f, 1.0f);
-            }
-            draw->drawSolidCircle(d.pos, GameConfig::DROP_DRAW_RADIUS, 0.0f, 12, color);
-            draw->drawCircle(d.pos, GameConfig::DROP_DRAW_RADIUS, 0.0f, 12, false, cocos2d::Color4F(0, 0, 0, 0.4f));
-        }
+        return false;
     }
+    int leftover = inv->addItems(d.type, d.qty);
+    if (leftover > 0) {
+        d.qty = leftover;
+        return false;
+    }
+    return true;
 }
 
 void Drop::collectDropsNear(const cocos2d::Vec2& playerWorldPos, std::vector<Drop>& drops, Game::Inventory* inv) {
@@ -70,33 +102,9 @@ void Drop::collectDropsNear(const cocos2d::Vec2& playerWorldPos, std::vector<Dro
     for (auto& d : drops) {
         float dist2 = playerWorldPos.distanceSquared(d.pos);
         if (dist2 <= r2) {
-            int raw = static_cast<int>(d.type);
-            if (isToolDropRaw(raw)) {
-                Game::ToolKind tk = toolKindFromDropRaw(raw);
-                int level = toolLevelFromDropRaw(raw);
-                bool placed = false;
-                std::size_t sz = inv->size();
-                for (std::size_t i = 0; i < sz; ++i) {
-                    if (inv->isEmpty(i)) {
-                        auto tool = Game::makeTool(tk);
-                        if (tool) {
-                            tool->setLevel(level);
-                        }
-                        inv->setTool(i, tool);
-                        placed = true;
-                        break;
-                    }
-                }
-                if (!placed) {
-                    kept.push_back(d);
-                }
-            } else {
-                int leftover = inv->addItems(d.type, d.qty);
-                if (leftover > 0) {
-                    Drop nd = d;
-                    nd.qty = leftover;
-                    kept.push_back(nd);
-                }
+            Drop nd = d;
+            if (!tryPickup(nd, inv)) {
+                kept.push_back(nd);
             }
         } else {
             kept.push_back(d);
@@ -13,6 +13,9 @@ namespace Game {
 // - pos ：世界坐标位置，通常位于地图上的某个点；
 // - qty ：堆叠数量。
 // renderDrops      ：根据掉落列表在场景中渲染对应精灵/调试形状；
+// createSprite     ：为单个掉落创建已缩放的精灵（供保留式渲染复用）；
+// drawFallback     ：贴图缺失时以圆点绘制单个掉落；
+// tryPickup        ：尝试将单个掉落吸入背包；
 // collectDropsNear ：检测玩家附近掉落并尝试吸入背包。
 class Drop {
 public:
@@ -24,6 +27,15 @@ public:
                             cocos2d::Node* root,
                             cocos2d::DrawNode* draw);
 
+    // 创建掉落精灵（已按 DROP_DRAW_RADIUS 缩放并定位）；贴图不可用时返回 nullptr。
+    static cocos2d::Sprite* createSprite(const Drop& d);
+
+    // 在 DrawNode 上以圆点绘制掉落（精灵不可用时的回退）。
+    static void drawFallback(const Drop& d, cocos2d::DrawNode* draw);
+
+    // 尝试拾取单个掉落：全部吸入返回 true；否则 d.qty 更新为剩余数量并返回 false。
+    static bool tryPickup(Drop& d, Game::Inventory* inv);
+
     static void collectDropsNear(const cocos2d::Vec2& playerWorldPos,
                                  std::vector<Drop>& drops,
                                  Game::Inventory* inv);
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace Game {
+
+// FreeTileSet：瓦片下标的集合，插入/删除/随机抽取均为 O(1)。
+// - _members 紧凑存放成员（无序），_slot[idx] 记录 idx 在 _members 中的位置（不在集合中为 -1）；
+// - 删除时用末尾成员填洞（swap-remove），只需修正被搬动成员的位置。
+class FreeTileSet {
+public:
+    // 重置为容纳 [0, capacity) 的空集合。
+    void reset(std::size_t capacity) {
+        _members.clear();
+        _slot.assign(capacity, -1);
+    }
+
+    std::size_t size() const { return _members.size(); }
+    bool empty() const { return _members.empty(); }
+    bool contains(int idx) const {
+        return idx >= 0 && static_cast<std::size_t>(idx) < _slot.size() && _slot[idx] >= 0;
+    }
+    // 第 k 个成员（0 <= k < size()）；成员顺序随增删变化，仅用于随机抽取。
+    int at(std::size_t k) const { return _members[k]; }
+
+    void insert(int idx) {
+        if (idx < 0 || static_cast<std::size_t>(idx) >= _slot.size() || _slot[idx] >= 0) return;
+        _slot[idx] = static_cast<int>(_members.size());
+        _members.push_back(idx);
+    }
+
+    void erase(int idx) {
+        if (!contains(idx)) return;
+        int pos = _slot[idx];
+        int last = _members.back();
+        _members[pos] = last;
+        _slot[last] = pos;
+        _members.pop_back();
+        _slot[idx] = -1;
+    }
+
+private:
+    std::vector<int> _members;
+    std::vector<int> _slot;
+};
+
+} // namespace Game
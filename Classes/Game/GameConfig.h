@@ -28,6 +28,10 @@ namespace GameConfig {
     static const int FARM_WEED_REGEN_THRESHOLD_DIV = 50;
     static const int FARM_NIGHTLY_REGEN_COUNT = 2;
 
+    // 存档压缩：0 不压缩，1 zlib；等级 1~9（越大文件越小、写入越慢）
+    static const int SAVE_CODEC = 1;
+    static const int SAVE_COMPRESSION_LEVEL = 6;
+
     // 掉落与拾取相关参数
     static const float DROP_DRAW_RADIUS = 8.0f;   // 掉落渲染圆点半径
     static const float DROP_PICK_RADIUS = 20.0f;  // 玩家拾取距离阈值
@@ -51,6 +55,9 @@ namespace GameConfig {
     // 节日：夏季第几天为钓鱼节（1..30）。
     static const int FESTIVAL_DAY = 6;
 
+    // 快进：在床边按 N 连续睡过的天数。
+    static const int FAST_FORWARD_DAYS = 7;
+
     // Tileset 配置（spring_outdoors）
     static const int SPRING_OUTDOORS_COLUMNS = 25; // tileset 列数（tsx 定义为 25）
 
@@ -1,9 +1,11 @@
 #include "Game/Inventory.h"
 #include "Game/WorldState.h"
+#include <algorithm>
 
 namespace Game {
 
 namespace {
+// 以下辅助函数只用于全局箱子扩展的槽位；背包自身槽位通过类型索引增量维护。
 int addToExistingStacks(std::vector<Slot>& slots, ItemType type, int qty) {
     if (qty <= 0) return 0;
     for (auto& s : slots) {
@@ -33,16 +35,6 @@ int addToEmptySlots(std::vector<Slot>& slots, ItemType type, int qty) {
     return qty;
 }
 
-int countInSlots(const std::vector<Slot>& slots, ItemType type) {
-    int total = 0;
-    for (auto const& s : slots) {
-        if (s.kind == SlotKind::Item && s.itemType == type) {
-            total += s.itemQty;
-        }
-    }
-    return total;
-}
-
 void removeFromSlots(std::vector<Slot>& slots, ItemType type, int& qty) {
     if (qty <= 0) return;
     for (auto& s : slots) {
@@ -61,13 +53,146 @@ void removeFromSlots(std::vector<Slot>& slots, ItemType type, int& qty) {
 }
 }
 
-Inventory::Inventory(std::size_t slots) : _slots(slots) {}
+Inventory::Inventory(std::size_t slots) : _slots(slots), _slotRevisions(slots, 0) {}
+
+unsigned int Inventory::slotRevision(std::size_t index) const {
+    return index < _slotRevisions.size() ? _slotRevisions[index] : 0;
+}
+
+void Inventory::markSlotChanged(std::size_t index) {
+    if (index >= _slotRevisions.size()) return;
+    ++_slotRevisions[index];
+    ++_revision;
+}
+
+void Inventory::unindexSlot(std::size_t index) {
+    const Slot& s = _slots[index];
+    if (s.kind != SlotKind::Item) return;
+    auto it = _typeIndex.find(static_cast<int>(s.itemType));
+    if (it == _typeIndex.end()) return;
+    TypeIndex& ti = it->second;
+    auto pos = std::lower_bound(ti.stacks.begin(), ti.stacks.end(), index);
+    if (pos == ti.stacks.end() || *pos != index) return;
+    std::size_t at = static_cast<std::size_t>(pos - ti.stacks.begin());
+    ti.stacks.erase(pos);
+    ti.total -= s.itemQty;
+    if (at < ti.roomFrom) ti.roomFrom = at;
+}
+
+void Inventory::indexSlot(std::size_t index) {
+    const Slot& s = _slots[index];
+    if (s.kind == SlotKind::Empty) {
+        if (index < _emptyFrom) _emptyFrom = index;
+        return;
+    }
+    if (s.kind != SlotKind::Item) return;
+    TypeIndex& ti = _typeIndex[static_cast<int>(s.itemType)];
+    auto pos = std::lower_bound(ti.stacks.begin(), ti.stacks.end(), index);
+    std::size_t at = static_cast<std::size_t>(pos - ti.stacks.begin());
+    ti.stacks.insert(pos, index);
+    ti.total += s.itemQty;
+    if (at < ti.roomFrom) ti.roomFrom = at;
+}
+
+std::size_t Inventory::firstEmptySlot() {
+    while (_emptyFrom < _slots.size() && _slots[_emptyFrom].kind != SlotKind::Empty) {
+        ++_emptyFrom;
+    }
+    return _emptyFrom;
+}
+
+int Inventory::addToOwnStacks(ItemType type, int qty) {
+    auto it = _typeIndex.find(static_cast<int>(type));
+    if (it == _typeIndex.end()) return qty;
+    TypeIndex& ti = it->second;
+    while (qty > 0 && ti.roomFrom < ti.stacks.size()) {
+        std::size_t index = ti.stacks[ti.roomFrom];
+        auto& s = _slots[index];
+        if (s.itemQty < ItemStack::MAX_STACK) {
+            int canAdd = ItemStack::MAX_STACK - s.itemQty;
+            int add = qty < canAdd ? qty : canAdd;
+            s.itemQty += add;
+            ti.total += add;
+            qty -= add;
+            markSlotChanged(index);
+        }
+        if (s.itemQty >= ItemStack::MAX_STACK) ++ti.roomFrom;
+    }
+    return qty;
+}
+
+int Inventory::addToOwnEmptySlots(ItemType type, int qty) {
+    while (qty > 0) {
+        std::size_t index = firstEmptySlot();
+        if (index >= _slots.size()) break;
+        auto& s = _slots[index];
+        s.kind = SlotKind::Item;
+        s.itemType = type;
+        int add = qty < ItemStack::MAX_STACK ? qty : ItemStack::MAX_STACK;
+        s.itemQty = add;
+        qty -= add;
+        indexSlot(index);
+        markSlotChanged(index);
+    }
+    return qty;
+}
+
+void Inventory::removeFromOwnSlots(ItemType type, int& qty) {
+    while (qty > 0) {
+        auto it = _typeIndex.find(static_cast<int>(type));
+        if (it == _typeIndex.end() || it->second.stacks.empty()) break;
+        std::size_t index = it->second.stacks.front();
+        unindexSlot(index);
+        auto& s = _slots[index];
+        int take = (s.itemQty >= qty) ? qty : s.itemQty;
+        s.itemQty -= take;
+        qty -= take;
+        if (s.itemQty <= 0) {
+            s.kind = SlotKind::Empty;
+            s.itemType = ItemType::Wood;
+            s.itemQty = 0;
+        }
+        indexSlot(index);
+        markSlotChanged(index);
+    }
+}
+
+int Inventory::ownCount(ItemType type) const {
+    auto it = _typeIndex.find(static_cast<int>(type));
+    return it == _typeIndex.end() ? 0 : it->second.total;
+}
+
+int Inventory::chestCount(const Chest& chest, ItemType type) const {
+    if (_chestCounts.chest != &chest || _chestCounts.revision != chest.revision) {
+        _chestCounts.chest = &chest;
+        _chestCounts.revision = chest.revision;
+        _chestCounts.totals.clear();
+        for (const auto& s : chest.slots) {
+            if (s.kind == SlotKind::Item) {
+                _chestCounts.totals[static_cast<int>(s.itemType)] += s.itemQty;
+            }
+        }
+    }
+    auto it = _chestCounts.totals.find(static_cast<int>(type));
+    return it == _chestCounts.totals.end() ? 0 : it->second;
+}
+
+void Inventory::applyChestDelta(Chest& chest, ItemType type, int delta) {
+    // 调用前缓存已通过 chestCount 对齐；refreshChestEmpty 会推进版本号，这里同步增量。
+    bool fresh = (_chestCounts.chest == &chest && _chestCounts.revision == chest.revision);
+    refreshChestEmpty(chest);
+    if (!fresh) return;
+    _chestCounts.revision = chest.revision;
+    _chestCounts.totals[static_cast<int>(type)] += delta;
+}
 
 void Inventory::setTool(std::size_t index, std::shared_ptr<ToolBase> tool) {
     if (index < _slots.size()) {
+        unindexSlot(index);
         _slots[index].kind = SlotKind::Tool;
         _slots[index].tool = std::move(tool);
         _slots[index].itemQty = 0;
+        markSlotChanged(index);
     }
 }
 
@@ -111,32 +236,39 @@ int Inventory::addItems(ItemType type, int qty) {
     auto& ws = globalState();
     Inventory* wsInv = ws.inventory.get();
     bool useChest = (this == wsInv);
-    std::vector<Slot>* chestSlots = nullptr;
+    Chest* chest = nullptr;
     if (useChest) {
-        auto& chest = ws.globalChest;
-        if (chest.slots.empty()) {
-            chest.slots.resize(static_cast<std::size_t>(Chest::CAPACITY));
+        chest = &ws.globalChest;
+        if (chest->slots.empty()) {
+            chest->slots.resize(static_cast<std::size_t>(Chest::CAPACITY));
         }
-        chestSlots = &chest.slots;
+        chestCount(*chest, type);
     }
-    qty = addToExistingStacks(_slots, type, qty);
-    if (useChest && qty > 0 && chestSlots) {
-        qty = addToExistingStacks(*chestSlots, type, qty);
+    int chestAdded = 0;
+    qty = addToOwnStacks(type, qty);
+    if (chest && qty > 0) {
+        int before = qty;
+        qty = addToExistingStacks(chest->slots, type, qty);
+        chestAdded += before - qty;
     }
-    qty = addToEmptySlots(_slots, type, qty);
-    if (useChest && qty > 0 && chestSlots) {
-        qty = addToEmptySlots(*chestSlots, type, qty);
-        refreshChestEmpty(ws.globalChest);
+    qty = addToOwnEmptySlots(type, qty);
+    if (chest && qty > 0) {
+        int before = qty;
+        qty = addToEmptySlots(chest->slots, type, qty);
+        chestAdded += before - qty;
+    }
+    if (chestAdded > 0) {
+        applyChestDelta(*chest, type, chestAdded);
     }
     return qty;
 }
 
 int Inventory::countItems(ItemType type) const {
-    int total = countInSlots(_slots, type);
+    int total = ownCount(type);
     auto& ws = globalState();
     const Inventory* wsInv = ws.inventory.get();
     if (this == wsInv) {
-        total += countInSlots(ws.globalChest.slots, type);
+        total += chestCount(ws.globalChest, type);
     }
     return total;
 }
@@ -146,15 +278,14 @@ bool Inventory::removeItems(ItemType type, int qty) {
     auto& ws = globalState();
     Inventory* wsInv = ws.inventory.get();
     bool useChest = (this == wsInv);
-    int have = countInSlots(_slots, type);
-    if (useChest) {
-        have += countInSlots(ws.globalChest.slots, type);
-    }
-    if (have < qty) return false;
-    removeFromSlots(_slots, type, qty);
+    int own = ownCount(type);
+    int inChest = useChest ? chestCount(ws.globalChest, type) : 0;
+    if (own + inChest < qty) return false;
+    removeFromOwnSlots(type, qty);
     if (useChest && qty > 0) {
+        int before = qty;
         removeFromSlots(ws.globalChest.slots, type, qty);
-        refreshChestEmpty(ws.globalChest);
+        applyChestDelta(ws.globalChest, type, -(before - qty));
     }
     return qty <= 0;
 }
@@ -164,6 +295,8 @@ bool Inventory::consumeSelectedItem(int qty) {
     if (_slots.empty()) return false;
     auto &s = _slots[_selected];
     if (s.kind != SlotKind::Item || s.itemQty <= 0) return false;
+    std::size_t index = static_cast<std::size_t>(_selected);
+    unindexSlot(index);
     int consume = qty <= s.itemQty ? qty : s.itemQty;
     s.itemQty -= consume;
     if (s.itemQty <= 0) {
@@ -171,6 +304,8 @@ bool Inventory::consumeSelectedItem(int qty) {
         s.itemType = ItemType::Wood; // reset default
         s.itemQty = 0;
     }
+    indexSlot(index);
+    markSlotChanged(index);
     return consume > 0;
 }
 
@@ -181,10 +316,15 @@ bool Inventory::addOneItemToSlot(std::size_t index, ItemType type) {
         s.kind = SlotKind::Item;
         s.itemType = type;
         s.itemQty = 1;
+        indexSlot(index);
+        markSlotChanged(index);
         return true;
     }
     if (s.kind == SlotKind::Item && s.itemType == type && s.itemQty < ItemStack::MAX_STACK) {
+        unindexSlot(index);
         s.itemQty += 1;
+        indexSlot(index);
+        markSlotChanged(index);
         return true;
     }
     return false;
@@ -194,24 +334,30 @@ bool Inventory::removeOneItemFromSlot(std::size_t index) {
     if (index >= _slots.size()) return false;
     auto& s = _slots[index];
     if (s.kind != SlotKind::Item || s.itemQty <= 0) return false;
+    unindexSlot(index);
     s.itemQty -= 1;
     if (s.itemQty <= 0) {
         s.kind = SlotKind::Empty;
         s.itemType = ItemType::Wood;
         s.itemQty = 0;
     }
+    indexSlot(index);
+    markSlotChanged(index);
     return true;
 }
 
 bool Inventory::clearSlot(std::size_t index) {
     if (index >= _slots.size()) return false;
     auto& s = _slots[index];
+    unindexSlot(index);
     if (s.kind == SlotKind::Tool) {
         s.tool.reset();
     }
     s.kind = SlotKind::Empty;
     s.itemType = ItemType::Wood;
     s.itemQty = 0;
+    indexSlot(index);
+    markSlotChanged(index);
     return true;
 }
 
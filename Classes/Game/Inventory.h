@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <utility>
 #include <memory>
+#include <unordered_map>
 #include "Game/Tool/ToolBase.h"
 #include "Game/Item.h"
 
@@ -36,10 +37,14 @@ struct Slot {
     int itemQty = 0;      
 };
 
+struct Chest;
+
 // Inventory：玩家与系统使用的通用背包容器。
 // - 内部使用 Slot 向量顺序存储每个格子的状态；
 // - 提供添加/移除物品、放入/取出工具、计数与查询等接口；
-// - 通过 selectedIndex 记录当前选中的槽位，供 UI 与控制器协作。
+// - 通过 selectedIndex 记录当前选中的槽位，供 UI 与控制器协作；
+// - 每次槽位内容变化都会递增该槽位与整体的版本号，UI 据此只重绘变化的格子；
+// - 按物品类型增量维护总数与物品槽列表，计数为 O(1)，增删只触及该类型相关的槽位。
 class Inventory {
 public:
     explicit Inventory(std::size_t slots);
@@ -55,10 +60,13 @@ public:
     bool isEmpty(std::size_t index) const;
     bool isTool(std::size_t index) const;
 
+    // 添加物品：先叠加已有堆，再放入空槽；玩家背包会溢出到全局箱子。返回放不下的数量。
     int addItems(ItemType type, int qty);
 
+    // 统计物品总数（玩家背包包含全局箱子扩展）。
     int countItems(ItemType type) const;
     
+    // 移除物品：总数不足时不做任何修改并返回 false。
     bool removeItems(ItemType type, int qty);
 
     // 消耗当前选中槽位中的物品（当选中为物品槽）
@@ -77,9 +85,50 @@ public:
     bool removeOneItemFromSlot(std::size_t index);
     bool clearSlot(std::size_t index);
 
+    // 版本号：任意槽位内容变化时递增（不含选中变化）。
+    unsigned long long revision() const { return _revision; }
+    // 单个槽位的版本号：该槽位内容变化时递增；越界返回 0。
+    unsigned int slotRevision(std::size_t index) const;
+    // 槽位中的工具状态在背包外被修改（如升级改变图标）时，由调用方标记该槽位已变化。
+    void markSlotChanged(std::size_t index);
+
 private:
+    // 单个物品类型的索引：
+    // - total：该类型在背包槽位中的总数量；
+    // - stacks：存放该类型的槽位下标（升序）；
+    // - roomFrom：stacks 中该位置之前的槽位均已堆满（“首个有空间的槽位”提示，只会偏小）。
+    struct TypeIndex {
+        int total = 0;
+        std::vector<std::size_t> stacks;
+        std::size_t roomFrom = 0;
+    };
+    // 全局箱子的按类型计数缓存：箱子版本号变化（被外部修改）时整体重建。
+    struct ChestCountCache {
+        const Chest* chest = nullptr;
+        unsigned long long revision = 0;
+        std::unordered_map<int, int> totals;
+    };
+
+    // 槽位内容修改前后分别调用，维护类型索引与空槽提示。
+    void unindexSlot(std::size_t index);
+    void indexSlot(std::size_t index);
+    std::size_t firstEmptySlot();
+    int addToOwnStacks(ItemType type, int qty);
+    int addToOwnEmptySlots(ItemType type, int qty);
+    void removeFromOwnSlots(ItemType type, int& qty);
+    int ownCount(ItemType type) const;
+    int chestCount(const Chest& chest, ItemType type) const;
+    // 本背包修改了箱子槽位后调用：刷新箱子状态并把数量变化同步进缓存。
+    void applyChestDelta(Chest& chest, ItemType type, int delta);
+
     std::vector<Slot> _slots;
+    std::vector<unsigned int> _slotRevisions;
+    unsigned long long _revision = 0;
     int _selected = 0;
+    std::unordered_map<int, TypeIndex> _typeIndex;
+    // 该下标之前的槽位均非空（空槽查找提示，只会偏小）。
+    std::size_t _emptyFrom = 0;
+    mutable ChestCountCache _chestCounts;
 };
 
 } // namespace Game
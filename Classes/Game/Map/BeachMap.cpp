@@ -31,7 +31,7 @@ bool BeachMap::initWithFile(const std::string& tmxFile) {
 }
 
 bool BeachMap::collides(const Vec2& p, float radius) const {
-    if (MapBase::collidesAt(p, radius, _wallRects, _wallPolys)) return true;
+    if (_wallRaster.collides(p, radius)) return true;
     return false;
 }
 
@@ -73,6 +73,7 @@ void BeachMap::setFestivalActive(bool active) {
 
 void BeachMap::parseWalls() {
     MapBase::parseWalls(_tmx, _wallRects, _wallPolys, nullptr, { "Wall","wall" });
+    buildCollisionRaster(_wallRaster, _wallRects, _wallPolys);
 }
 
 void BeachMap::parseWater() {
@@ -32,6 +32,7 @@ private:
 
     std::vector<cocos2d::Rect> _wallRects;
     std::vector<std::vector<cocos2d::Vec2>> _wallPolys;
+    CollisionRaster _wallRaster; // 墙体静态碰撞栅格
 
     std::vector<cocos2d::Rect> _waterRects;
     std::vector<std::vector<cocos2d::Vec2>> _waterPolys;
@@ -0,0 +1,226 @@
+// 静态碰撞栅格实现：
+// - build：逐形状遍历包围盒覆盖的格子，判定相交/完全覆盖并写入候选列表
+// - 精确检测与 MapBase::collidesAt / FarmMap::nearWater 的几何规则保持一致
+#include "Game/Map/CollisionRaster.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace cocos2d;
+
+namespace Game {
+
+namespace {
+    // 判定格子是否与形状相交时的外扩量，避免边界浮点误差漏掉候选。
+    const float kCellEpsilon = 0.01f;
+
+    bool pointInPolygon(const Vec2& p, const std::vector<Vec2>& poly) {
+        bool inside = false; size_t j = poly.size() - 1;
+        for (size_t i = 0; i < poly.size(); ++i) {
+            if (((poly[i].y > p.y) != (poly[j].y > p.y)) &&
+                (p.x < (poly[j].x - poly[i].x) * (p.y - poly[i].y) / (poly[j].y - poly[i].y) + poly[i].x)) {
+                inside = !inside;
+            }
+            j = i;
+        }
+        return inside;
+    }
+
+    bool nearPolygonEdges(const Vec2& p, const std::vector<Vec2>& poly, float r2) {
+        size_t j = poly.size() - 1;
+        for (size_t i = 0; i < poly.size(); ++i) {
+            Vec2 p1 = poly[j]; Vec2 p2 = poly[i]; Vec2 d = p2 - p1;
+            if (d.lengthSquared() > 0) {
+                float t = (p - p1).dot(d) / d.lengthSquared(); t = std::max(0.0f, std::min(1.0f, t));
+                Vec2 close = p1 + d * t; if (p.distanceSquared(close) <= r2) return true;
+            }
+            j = i;
+        }
+        return false;
+    }
+
+    bool circleHitsRect(const Vec2& p, float r2, const Rect& r) {
+        float cx = std::max(r.getMinX(), std::min(p.x, r.getMaxX()));
+        float cy = std::max(r.getMinY(), std::min(p.y, r.getMaxY()));
+        float dx = p.x - cx; float dy = p.y - cy;
+        return dx*dx + dy*dy <= r2;
+    }
+
+    // 线段与闭矩形相交（Liang-Barsky 裁剪）。
+    bool segmentHitsRect(const Vec2& a, const Vec2& b, const Rect& r) {
+        float t0 = 0.0f, t1 = 1.0f;
+        float dx = b.x - a.x, dy = b.y - a.y;
+        const float p[4] = { -dx, dx, -dy, dy };
+        const float q[4] = { a.x - r.getMinX(), r.getMaxX() - a.x, a.y - r.getMinY(), r.getMaxY() - a.y };
+        for (int k = 0; k < 4; ++k) {
+            if (p[k] == 0.0f) {
+                if (q[k] < 0.0f) return false;
+                continue;
+            }
+            float t = q[k] / p[k];
+            if (p[k] < 0.0f) { if (t > t1) return false; t0 = std::max(t0, t); }
+            else { if (t < t0) return false; t1 = std::min(t1, t); }
+        }
+        return true;
+    }
+
+    bool polygonEdgesHitRect(const std::vector<Vec2>& poly, const Rect& r) {
+        size_t j = poly.size() - 1;
+        for (size_t i = 0; i < poly.size(); ++i) {
+            if (segmentHitsRect(poly[j], poly[i], r)) return true;
+            j = i;
+        }
+        return false;
+    }
+}
+
+void CollisionRaster::clear() {
+    _cols = 0;
+    _rows = 0;
+    _tileSize = 0.0f;
+    _rects.clear();
+    _polys.clear();
+    _cells.clear();
+    _candStart.clear();
+    _candIds.clear();
+    _outsideIds.clear();
+}
+
+void CollisionRaster::build(const std::vector<Rect>& rects,
+                            const std::vector<std::vector<Vec2>>& polys,
+                            int cols, int rows, float tileSize) {
+    clear();
+    _rects = rects;
+    _polys = polys;
+    int shapeCount = static_cast<int>(_rects.size() + _polys.size());
+    if (cols <= 0 || rows <= 0 || tileSize <= 0.0f) {
+        // 无有效栅格：全部形状走越界列表，退化为逐个精确检测。
+        for (int id = 0; id < shapeCount; ++id) _outsideIds.push_back(id);
+        return;
+    }
+    _cols = cols;
+    _rows = rows;
+    _tileSize = tileSize;
+    _cells.assign(static_cast<std::size_t>(cols) * rows, CellFree);
+    std::vector<std::vector<int>> perCell(_cells.size());
+    float mapW = cols * tileSize;
+    float mapH = rows * tileSize;
+    int nRects = static_cast<int>(_rects.size());
+
+    for (int id = 0; id < shapeCount; ++id) {
+        const std::vector<Vec2>* poly = (id >= nRects) ? &_polys[id - nRects] : nullptr;
+        if (poly && poly->empty()) continue;
+        Rect bounds;
+        if (poly) {
+            float minX = (*poly)[0].x, maxX = minX, minY = (*poly)[0].y, maxY = minY;
+            for (const auto& v : *poly) {
+                minX = std::min(minX, v.x); maxX = std::max(maxX, v.x);
+                minY = std::min(minY, v.y); maxY = std::max(maxY, v.y);
+            }
+            bounds = Rect(minX, minY, maxX - minX, maxY - minY);
+        } else {
+            bounds = _rects[id];
+        }
+        if (bounds.getMinX() < 0.0f || bounds.getMinY() < 0.0f ||
+            bounds.getMaxX() > mapW || bounds.getMaxY() > mapH) {
+            _outsideIds.push_back(id);
+        }
+        int c0 = std::max(0, static_cast<int>(std::floor((bounds.getMinX() - kCellEpsilon) / tileSize)));
+        int c1 = std::min(cols - 1, static_cast<int>(std::floor((bounds.getMaxX() + kCellEpsilon) / tileSize)));
+        int r0 = std::max(0, static_cast<int>(std::floor((bounds.getMinY() - kCellEpsilon) / tileSize)));
+        int r1 = std::min(rows - 1, static_cast<int>(std::floor((bounds.getMaxY() + kCellEpsilon) / tileSize)));
+        for (int r = r0; r <= r1; ++r) {
+            for (int c = c0; c <= c1; ++c) {
+                Rect cell(c * tileSize, r * tileSize, tileSize, tileSize);
+                Rect loose(cell.origin.x - kCellEpsilon, cell.origin.y - kCellEpsilon,
+                           tileSize + kCellEpsilon * 2.0f, tileSize + kCellEpsilon * 2.0f);
+                bool touches = false;
+                bool covers = false;
+                if (poly) {
+                    bool edgeHit = polygonEdgesHitRect(*poly, loose);
+                    bool centerInside = poly->size() >= 3 &&
+                        pointInPolygon(Vec2(cell.getMidX(), cell.getMidY()), *poly);
+                    touches = edgeHit || centerInside;
+                    covers = centerInside && !edgeHit;
+                } else {
+                    const Rect& rc = _rects[id];
+                    touches = rc.intersectsRect(loose);
+                    covers = rc.getMinX() <= cell.getMinX() && rc.getMaxX() >= cell.getMaxX() &&
+                             rc.getMinY() <= cell.getMinY() && rc.getMaxY() >= cell.getMaxY();
+                }
+                if (!touches) continue;
+                std::size_t idx = static_cast<std::size_t>(r) * cols + c;
+                perCell[idx].push_back(id);
+                if (covers) _cells[idx] = CellBlocked;
+                else if (_cells[idx] == CellFree) _cells[idx] = CellExact;
+            }
+        }
+    }
+
+    _candStart.assign(_cells.size() + 1, 0);
+    for (std::size_t i = 0; i < perCell.size(); ++i) {
+        _candStart[i + 1] = _candStart[i] + static_cast<int>(perCell[i].size());
+    }
+    _candIds.reserve(static_cast<std::size_t>(_candStart.back()));
+    for (const auto& ids : perCell) {
+        _candIds.insert(_candIds.end(), ids.begin(), ids.end());
+    }
+}
+
+bool CollisionRaster::collides(const Vec2& p, float radius) const {
+    return query(p, radius, false);
+}
+
+bool CollisionRaster::nearEdges(const Vec2& p, float radius) const {
+    return query(p, radius, true);
+}
+
+bool CollisionRaster::testShape(int id, const Vec2& p, float radius, bool edgesOnly) const {
+    float r2 = radius * radius;
+    int nRects = static_cast<int>(_rects.size());
+    if (id < nRects) return circleHitsRect(p, r2, _rects[id]);
+    const auto& poly = _polys[id - nRects];
+    if (edgesOnly) {
+        return poly.size() >= 2 && nearPolygonEdges(p, poly, r2);
+    }
+    if (poly.size() < 3) return false;
+    return pointInPolygon(p, poly) || nearPolygonEdges(p, poly, r2);
+}
+
+bool CollisionRaster::query(const Vec2& p, float radius, bool edgesOnly) const {
+    if (empty()) return false;
+    bool outside = true;
+    if (!_cells.empty()) {
+        float mapW = _cols * _tileSize;
+        float mapH = _rows * _tileSize;
+        outside = (p.x - radius < 0.0f || p.y - radius < 0.0f ||
+                   p.x + radius > mapW || p.y + radius > mapH);
+        int c0 = std::max(0, static_cast<int>(std::floor((p.x - radius) / _tileSize)));
+        int c1 = std::min(_cols - 1, static_cast<int>(std::floor((p.x + radius) / _tileSize)));
+        int r0 = std::max(0, static_cast<int>(std::floor((p.y - radius) / _tileSize)));
+        int r1 = std::min(_rows - 1, static_cast<int>(std::floor((p.y + radius) / _tileSize)));
+        float r2 = radius * radius;
+        for (int r = r0; r <= r1; ++r) {
+            for (int c = c0; c <= c1; ++c) {
+                std::size_t idx = static_cast<std::size_t>(r) * _cols + c;
+                unsigned char state = _cells[idx];
+                if (state == CellFree) continue;
+                if (state == CellBlocked && !edgesOnly) {
+                    Rect cell(c * _tileSize, r * _tileSize, _tileSize, _tileSize);
+                    if (circleHitsRect(p, r2, cell)) return true;
+                    continue;
+                }
+                for (int k = _candStart[idx]; k < _candStart[idx + 1]; ++k) {
+                    if (testShape(_candIds[k], p, radius, edgesOnly)) return true;
+                }
+            }
+        }
+    }
+    if (outside) {
+        for (int id : _outsideIds) {
+            if (testShape(id, p, radius, edgesOnly)) return true;
+        }
+    }
+    return false;
+}
+
+} // namespace Game
@@ -0,0 +1,46 @@
+// 静态碰撞栅格：
+// - 在地图加载时把 TMX 墙体/水域等静态几何按瓦片栅格化一次
+// - 每个格子分为：完全空闲 / 完全阻挡 / 需精确检测（附带与该格相交的候选形状列表）
+// - 查询时只看探测圆覆盖的少数格子，大多数情况一次数组查表即可得出结果
+#pragma once
+
+#include "cocos2d.h"
+#include <vector>
+
+namespace Game {
+
+class CollisionRaster {
+public:
+    // 以 cols x rows、边长 tileSize 的栅格（原点为地图左下角）栅格化给定形状。
+    void build(const std::vector<cocos2d::Rect>& rects,
+               const std::vector<std::vector<cocos2d::Vec2>>& polys,
+               int cols, int rows, float tileSize);
+    void clear();
+    bool empty() const { return _rects.empty() && _polys.empty(); }
+
+    // 与 MapBase::collidesAt 等价：圆与矩形/实心多边形相交。
+    bool collides(const cocos2d::Vec2& p, float radius) const;
+    // 邻近检测：圆与矩形相交，或与多边形边的距离不超过 radius（不判断多边形内部）。
+    bool nearEdges(const cocos2d::Vec2& p, float radius) const;
+
+private:
+    enum CellState : unsigned char { CellFree = 0, CellBlocked = 1, CellExact = 2 };
+
+    bool query(const cocos2d::Vec2& p, float radius, bool edgesOnly) const;
+    bool testShape(int id, const cocos2d::Vec2& p, float radius, bool edgesOnly) const;
+
+    int _cols = 0;
+    int _rows = 0;
+    float _tileSize = 0.0f;
+    std::vector<cocos2d::Rect> _rects;
+    std::vector<std::vector<cocos2d::Vec2>> _polys;
+    std::vector<unsigned char> _cells;
+    // 候选形状（CSR 布局）：格子 i 的候选为 _candIds[_candStart[i], _candStart[i+1])；
+    // 形状 id < _rects.size() 为矩形，否则为多边形下标 + _rects.size()。
+    std::vector<int> _candStart;
+    std::vector<int> _candIds;
+    // 包围盒超出栅格范围的形状：查询越界时逐个精确检测。
+    std::vector<int> _outsideIds;
+};
+
+} // namespace Game
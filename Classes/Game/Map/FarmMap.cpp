@@ -44,11 +44,12 @@ void FarmMap::setupLayerOrder() {
 
 void FarmMap::parseWalls() {
     MapBase::parseWalls(_tmx, _wallRects, _wallPolygons, nullptr, { "Wall", "wall" });
+    buildCollisionRaster(_wallRaster, _wallRects, _wallPolygons);
 }
 
 bool FarmMap::collides(const cocos2d::Vec2& p, float radius) const {
-    if (MapBase::collidesAt(p, radius, _wallRects, _wallPolygons)) return true;
-    if (MapBase::collidesAt(p, radius, _waterRects, _waterPolygons)) return true;
+    if (_wallRaster.collides(p, radius)) return true;
+    if (_waterRaster.collides(p, radius)) return true;
     return false;
 }
 
@@ -88,6 +89,7 @@ void FarmMap::worldToTileIndex(const cocos2d::Vec2& p, int& c, int& r) const {
 void FarmMap::parseWater() {
     _waterRects.clear();
     _waterPolygons.clear();
+    _waterRaster.clear();
     if (!_tmx) return;
     auto group = _tmx->getObjectGroup("Water");
     if (!group) group = _tmx->getObjectGroup("water");
@@ -121,34 +123,11 @@ void FarmMap::parseWater() {
             _waterRects.push_back(r);
         }
     }
+    buildCollisionRaster(_waterRaster, _waterRects, _waterPolygons);
 }
 
 bool FarmMap::nearWater(const cocos2d::Vec2& p, float radius) const {
-    for (const auto& r : _waterRects) {
-        float cx = std::max(r.getMinX(), std::min(p.x, r.getMaxX()));
-        float cy = std::max(r.getMinY(), std::min(p.y, r.getMaxY()));
-        float dx = p.x - cx;
-        float dy = p.y - cy;
-        if (dx*dx + dy*dy <= radius*radius) return true;
-    }
-    for (const auto& poly : _waterPolygons) {
-        if (poly.size() < 2) continue;
-        size_t j = poly.size() - 1;
-        float r2 = radius * radius;
-        for (size_t i = 0; i < poly.size(); i++) {
-            cocos2d::Vec2 p1 = poly[j];
-            cocos2d::Vec2 p2 = poly[i];
-            cocos2d::Vec2 d = p2 - p1;
-            if (d.lengthSquared() > 0) {
-                float t = (p - p1).dot(d) / d.lengthSquared();
-                t = std::max(0.0f, std::min(1.0f, t));
-                cocos2d::Vec2 closest = p1 + d * t;
-                if (p.distanceSquared(closest) <= r2) return true;
-            }
-            j = i;
-        }
-    }
-    return false;
+    return _waterRaster.nearEdges(p, radius);
 }
 
 void FarmMap::parseDoorToRoom() {
@@ -51,6 +51,9 @@ private:
     std::vector<std::vector<cocos2d::Vec2>> _wallPolygons;
     std::vector<cocos2d::Rect> _waterRects;
     std::vector<std::vector<cocos2d::Vec2>> _waterPolygons;
+    // 墙体/水域的静态碰撞栅格（加载时构建，collides/nearWater 走栅格查询）
+    CollisionRaster _wallRaster;
+    CollisionRaster _waterRaster;
     std::vector<cocos2d::Rect> _doorToRoomRects;
     std::vector<cocos2d::Rect> _doorToMineRects;
     std::vector<cocos2d::Rect> _doorToBeachRects;
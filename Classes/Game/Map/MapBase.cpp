@@ -76,6 +76,14 @@ bool MapBase::collidesAt(const Vec2& p, float radius,
     return false;
 }
 
+void MapBase::buildCollisionRaster(CollisionRaster& out,
+                                   const std::vector<Rect>& rects,
+                                   const std::vector<std::vector<Vec2>>& polys) const {
+    Size mapSize = getMapSize();
+    float s = _tmx ? _tmx->getTileSize().width : (float)GameConfig::TILE_SIZE;
+    out.build(rects, polys, static_cast<int>(mapSize.width), static_cast<int>(mapSize.height), s);
+}
+
 Vec2 MapBase::centerFromRectsPoints(const std::vector<Rect>& rects,
                                     const std::vector<Vec2>& points) {
     if (!rects.empty()) { const auto& r = rects.front(); return Vec2(r.getMidX(), r.getMidY()); }
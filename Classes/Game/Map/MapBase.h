@@ -6,6 +6,7 @@
 
 #include "cocos2d.h"
 #include "Game/GameConfig.h"
+#include "Game/Map/CollisionRaster.h"
 #include <vector>
 #include <string>
 
@@ -49,6 +50,11 @@ public:
                            const std::vector<std::string>& groupNames);
 
 protected:
+    // 按本地图的瓦片尺寸把静态几何栅格化到 out（加载/几何变化时调用一次）。
+    void buildCollisionRaster(CollisionRaster& out,
+                              const std::vector<cocos2d::Rect>& rects,
+                              const std::vector<std::vector<cocos2d::Vec2>>& polys) const;
+
     cocos2d::TMXTiledMap* _tmx = nullptr;
 };
 
@@ -48,6 +48,7 @@ bool MineMap::initWithFile(const std::string& tmxFile) {
 
 void MineMap::parseCollision() {
     MapBase::parseWalls(_tmx, _collisionRects, _collisionPolygons, nullptr, { "Wall","wall" });
+    buildCollisionRaster(_collisionRaster, _collisionRects, _collisionPolygons);
 }
 
 void MineMap::parseStairs() {
@@ -95,7 +96,7 @@ void MineMap::parseAppear() {
 }
 
 bool MineMap::collides(const Vec2& p, float radius) const {
-    return MapBase::collidesAt(p, radius, _collisionRects, _collisionPolygons);
+    return _collisionRaster.collides(p, radius);
 }
 
 bool MineMap::nearStairs(const Vec2& p, float radius) const {
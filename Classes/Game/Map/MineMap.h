@@ -50,6 +50,7 @@ private:
     // Collision data
     std::vector<cocos2d::Rect> _collisionRects;
     std::vector<std::vector<cocos2d::Vec2>> _collisionPolygons;
+    CollisionRaster _collisionRaster; // 墙体静态碰撞栅格
     cocos2d::DrawNode* _debugNode = nullptr;
     // Stairs objects (rects or points)
     std::vector<cocos2d::Rect> _stairRects;
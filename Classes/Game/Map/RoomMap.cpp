@@ -55,10 +55,11 @@ void RoomMap::parseObjects() {
 
 void RoomMap::parseCollision() {
     MapBase::parseWalls(_tmx, _collisionRects, _collisionPolys, nullptr, { "Wall","wall" });
+    buildCollisionRaster(_collisionRaster, _collisionRects, _collisionPolys);
 }
 
 bool RoomMap::collides(const Vec2& p, float radius) const {
-    return MapBase::collidesAt(p, radius, _collisionRects, _collisionPolys);
+    return _collisionRaster.collides(p, radius);
 }
 
 void RoomMap::parseDoorToFarm() {
@@ -38,6 +38,7 @@ private:
     // Collision data
     std::vector<cocos2d::Rect> _collisionRects;
     std::vector<std::vector<cocos2d::Vec2>> _collisionPolys;
+    CollisionRaster _collisionRaster; // 墙体静态碰撞栅格
 
     // DoorToFarm objects
     std::vector<cocos2d::Rect> _doorToFarmRects;
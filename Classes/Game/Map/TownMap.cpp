@@ -31,9 +31,9 @@ bool TownMap::initWithFile(const std::string& tmxFile) {
 
 bool TownMap::collides(const Vec2& p, float radius) const {
     if (_festivalActive) {
-        if (MapBase::collidesAt(p, radius, _festivalWallRects, _festivalWallPolys)) return true;
+        if (_festivalWallRaster.collides(p, radius)) return true;
     }
-    if (MapBase::collidesAt(p, radius, _wallRects, _wallPolys)) return true;
+    if (_wallRaster.collides(p, radius)) return true;
     return false;
 }
 
@@ -56,11 +56,15 @@ void TownMap::setFestivalActive(bool active) {
     if (_festivalActive == active) return;
     _festivalActive = active;
     if (_festivalLayer) _festivalLayer->setVisible(_festivalActive);
-    if (_festivalActive) MapBase::parseWalls(_tmx, _festivalWallRects, _festivalWallPolys, nullptr, { "FestivalWall", "FestivalWall" });
+    if (_festivalActive) {
+        MapBase::parseWalls(_tmx, _festivalWallRects, _festivalWallPolys, nullptr, { "FestivalWall", "FestivalWall" });
+        buildCollisionRaster(_festivalWallRaster, _festivalWallRects, _festivalWallPolys);
+    }
 }
 
 void TownMap::parseWalls() {
     MapBase::parseWalls(_tmx, _wallRects, _wallPolys, nullptr, { "Wall","wall" });
+    buildCollisionRaster(_wallRaster, _wallRects, _wallPolys);
 }
 
 void TownMap::parseDoorToFarm() {
@@ -35,6 +35,9 @@ private:
     std::vector<std::vector<cocos2d::Vec2>> _wallPolys;
     std::vector<cocos2d::Rect> _festivalWallRects;
     std::vector<std::vector<cocos2d::Vec2>> _festivalWallPolys;
+    // 墙体/节日围栏的静态碰撞栅格
+    CollisionRaster _wallRaster;
+    CollisionRaster _festivalWallRaster;
     bool _festivalActive = false;
 
     std::vector<cocos2d::Rect> _doorToFarmRects;
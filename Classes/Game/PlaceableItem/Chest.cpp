@@ -4,7 +4,13 @@ using namespace cocos2d;
 
 namespace Game {
 
+unsigned long long nextChestRevision() {
+    static unsigned long long counter = 0;
+    return ++counter;
+}
+
 void refreshChestEmpty(Chest& chest) {
+    chest.revision = nextChestRevision();
     bool e = true;
     for (const auto& s : chest.slots) {
         if (s.kind == SlotKind::Item && s.itemQty > 0) {
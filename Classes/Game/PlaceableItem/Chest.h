@@ -21,6 +21,9 @@ class RoomMapController;
 
 namespace Game {
 
+// 生成全局唯一的箱子槽位版本号。
+unsigned long long nextChestRevision();
+
 // Chest：单个箱子实例的数据结构。
 // - slots       ：内部 3x12 固定容量的槽位数组（托管物品/工具）。
 // - MAX_PER_AREA：用于限制同一地图区域内可放置的箱子数量。
@@ -35,6 +38,9 @@ struct Chest : public PlaceableItemBase {
     std::vector<Slot> slots;
     bool empty = true;
     int hp = 1;
+    // 槽位版本号：构造与每次 refreshChestEmpty 时取一个全局唯一的新值，
+    // Inventory 据此判断箱子计数缓存是否失效。修改 slots 后需调用 refreshChestEmpty。
+    unsigned long long revision = nextChestRevision();
 
     // 构造函数：
     // - 调用 PlaceableItemBase 默认构造，把 pos 设为 Vec2::ZERO。
@@ -57,6 +63,7 @@ cocos2d::Rect chestRect(const Chest& chest);
 cocos2d::Rect chestCollisionRect(const Chest& chest);
 // 判断玩家在 worldPos 附近是否“接近任意箱子”，由 ChestController/IMapController 等调用。
 bool isNearAnyChest(const cocos2d::Vec2& playerWorldPos, const std::vector<Chest>& chests);
+// 槽位变化后调用：重新计算 empty 标记并推进版本号。
 void refreshChestEmpty(Chest& chest);
 
 } // namespace Game
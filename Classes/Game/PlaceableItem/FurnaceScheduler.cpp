@@ -0,0 +1,153 @@
+#include "Game/PlaceableItem/FurnaceScheduler.h"
+#include "Game/WorldState.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Game {
+
+const float FurnaceScheduler::kTickSeconds = 0.1f;
+
+namespace {
+
+const FurnaceArea kAllAreas[] = { FurnaceArea::Farm, FurnaceArea::House, FurnaceArea::Town, FurnaceArea::Beach };
+
+std::size_t areaIndex(FurnaceArea area) {
+    return static_cast<std::size_t>(area);
+}
+
+// 剩余秒数向上取整为刻数，至少 1 刻。
+std::uint64_t secondsToTicks(float seconds) {
+    double ticks = std::ceil(static_cast<double>(seconds) / FurnaceScheduler::kTickSeconds - 1e-6);
+    return ticks < 1.0 ? 1 : static_cast<std::uint64_t>(ticks);
+}
+
+}
+
+FurnaceScheduler& FurnaceScheduler::getInstance() {
+    static FurnaceScheduler inst;
+    return inst;
+}
+
+std::vector<Furnace>& FurnaceScheduler::furnacesIn(FurnaceArea area) {
+    auto& ws = globalState();
+    switch (area) {
+        case FurnaceArea::House: return ws.houseFurnaces;
+        case FurnaceArea::Town: return ws.townFurnaces;
+        case FurnaceArea::Beach: return ws.beachFurnaces;
+        case FurnaceArea::Farm:
+        default: return ws.farmFurnaces;
+    }
+}
+
+Furnace* FurnaceScheduler::findFurnace(FurnaceArea area, unsigned int timerId) {
+    for (auto& f : furnacesIn(area)) {
+        if (f.timerId == timerId) return &f;
+    }
+    return nullptr;
+}
+
+void FurnaceScheduler::advance(float dt) {
+    if (dt > 0.0f) _carrySeconds += dt;
+    std::uint64_t ticks = 0;
+    if (_carrySeconds >= kTickSeconds) {
+        ticks = static_cast<std::uint64_t>(_carrySeconds / kTickSeconds);
+        _carrySeconds -= static_cast<float>(ticks) * kTickSeconds;
+        if (_carrySeconds < 0.0f) _carrySeconds = 0.0f;
+    }
+    std::vector<std::uint64_t> fired;
+    _wheel.advance(ticks, fired);
+    if (fired.empty()) return;
+    std::vector<unsigned int> byArea[kAreaCount];
+    for (auto id64 : fired) {
+        unsigned int id = static_cast<unsigned int>(id64);
+        auto it = _areaOf.find(id);
+        if (it == _areaOf.end()) continue;
+        byArea[areaIndex(it->second)].push_back(id);
+    }
+    for (auto area : kAllAreas) {
+        auto& ids = byArea[areaIndex(area)];
+        if (ids.empty()) continue;
+        if (_handlers[areaIndex(area)]) {
+            deliver(area, ids);
+        } else {
+            auto& ready = _ready[areaIndex(area)];
+            ready.insert(ready.end(), ids.begin(), ids.end());
+        }
+    }
+}
+
+// 把到期的熔炉归零并交给区域回调；已被拆除或重新挂表的熔炉（找不到编号）直接丢弃。
+void FurnaceScheduler::deliver(FurnaceArea area, const std::vector<unsigned int>& ids) {
+    std::vector<Furnace*> done;
+    done.reserve(ids.size());
+    for (auto id : ids) {
+        _areaOf.erase(id);
+        Furnace* f = findFurnace(area, id);
+        if (!f) continue;
+        f->remainingSeconds = 0.0f;
+        f->timerId = 0;
+        done.push_back(f);
+    }
+    auto& handler = _handlers[areaIndex(area)];
+    if (!done.empty() && handler) handler(done);
+}
+
+void FurnaceScheduler::start(FurnaceArea area, Furnace& f) {
+    if (f.timerId != 0) {
+        _wheel.cancel(f.timerId);
+        _areaOf.erase(f.timerId);
+    }
+    f.timerId = ++_nextTimerId;
+    if (f.timerId == 0) f.timerId = ++_nextTimerId;
+    _areaOf[f.timerId] = area;
+    _wheel.schedule(f.timerId, _wheel.now() + secondsToTicks(f.remainingSeconds));
+}
+
+int FurnaceScheduler::bindArea(FurnaceArea area, CompletionHandler handler) {
+    std::size_t idx = areaIndex(area);
+    _handlers[idx] = std::move(handler);
+    _tokens[idx] = ++_nextToken;
+    if (!_ready[idx].empty()) {
+        std::vector<unsigned int> ready;
+        ready.swap(_ready[idx]);
+        deliver(area, ready);
+    }
+    return _tokens[idx];
+}
+
+void FurnaceScheduler::unbindArea(FurnaceArea area, int token) {
+    std::size_t idx = areaIndex(area);
+    if (_tokens[idx] != token) return;
+    _handlers[idx] = nullptr;
+    _tokens[idx] = 0;
+}
+
+void FurnaceScheduler::rebuild() {
+    _wheel.clear();
+    _areaOf.clear();
+    for (auto area : kAllAreas) {
+        _ready[areaIndex(area)].clear();
+        for (auto& f : furnacesIn(area)) {
+            f.timerId = 0;
+            if (f.remainingSeconds > 0.0f) start(area, f);
+        }
+    }
+}
+
+// 等待交付的熔炉写回一刻的剩余时间：读档后 rebuild 会在下一刻让它们重新到期。
+void FurnaceScheduler::syncToWorld() {
+    const std::uint64_t now = _wheel.now();
+    for (auto area : kAllAreas) {
+        for (auto& f : furnacesIn(area)) {
+            if (f.timerId == 0 || _areaOf.find(f.timerId) == _areaOf.end()) continue;
+            std::uint64_t due = 0;
+            float remaining = kTickSeconds;
+            if (_wheel.dueTick(f.timerId, due) && due > now) {
+                remaining = static_cast<float>(due - now) * kTickSeconds - _carrySeconds;
+            }
+            f.remainingSeconds = std::max(remaining, kTickSeconds);
+        }
+    }
+}
+
+} // namespace Game
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include "Game/TimerWheel.h"
+#include "Game/PlaceableItem/Furnace.h"
+
+namespace Game {
+
+// 熔炉所在区域，对应 WorldState 中的 farm/house/town/beachFurnaces。
+enum class FurnaceArea { Farm = 0, House, Town, Beach };
+
+// FurnaceScheduler：全世界熔炉的熔炼计时（单例）。
+// - 所有区域的熔炉都挂在同一个 TimerWheel 上（每刻 0.1 秒游戏时间），由 SceneBase::update 每帧推进一次，
+//   不再按帧遍历熔炉列表；玩家不在的区域也照常计时；
+// - 区域已加载（FurnaceController 通过 bindArea 注册了完成回调）时，到期的熔炉立即交给回调生成锭；
+//   未加载时先记入该区域的待交付列表，下次 bindArea 时一次性交付；
+// - 待交付的熔炉保持 remainingSeconds > 0（仍显示为加热中、不可再投料），交付时才归零；
+// - Furnace::timerId 只在运行时有效：读档/新游戏后调用 rebuild() 重新挂表，存档前调用 syncToWorld() 写回剩余时间。
+class FurnaceScheduler {
+public:
+    // 回调参数为本次完成的熔炉（remainingSeconds 已归零），指针仅在回调期间有效。
+    using CompletionHandler = std::function<void(const std::vector<Furnace*>& done)>;
+
+    static const float kTickSeconds;
+
+    static FurnaceScheduler& getInstance();
+
+    // 推进 dt 秒游戏时间并派发到期的熔炉。
+    void advance(float dt);
+    // f 已设置好 remainingSeconds，开始计时（f 必须位于 area 对应的 WorldState 列表中）。
+    void start(FurnaceArea area, Furnace& f);
+    // 注册区域的完成回调并交付该区域积压的完成；返回的令牌用于 unbindArea。
+    int bindArea(FurnaceArea area, CompletionHandler handler);
+    // 令牌与当前绑定一致时解除绑定（场景切换时新场景可能先于旧场景析构完成绑定）。
+    void unbindArea(FurnaceArea area, int token);
+    // 丢弃全部定时器，并按 WorldState 中各熔炉的 remainingSeconds 重新挂表。
+    void rebuild();
+    // 把各熔炉的剩余时间写回 remainingSeconds（存档前调用）。
+    void syncToWorld();
+    // 正在计时与等待交付的熔炉总数。
+    std::size_t pendingCount() const { return _areaOf.size(); }
+
+private:
+    static const int kAreaCount = 4;
+
+    FurnaceScheduler() = default;
+
+    std::vector<Furnace>& furnacesIn(FurnaceArea area);
+    Furnace* findFurnace(FurnaceArea area, unsigned int timerId);
+    void deliver(FurnaceArea area, const std::vector<unsigned int>& ids);
+
+    TimerWheel _wheel;
+    float _carrySeconds = 0.0f;
+    unsigned int _nextTimerId = 0;
+    int _nextToken = 0;
+    // 定时器编号 -> 所在区域（包含等待交付的熔炉）
+    std::unordered_map<unsigned int, FurnaceArea> _areaOf;
+    std::vector<unsigned int> _ready[kAreaCount];
+    CompletionHandler _handlers[kAreaCount];
+    int _tokens[kAreaCount] = { 0, 0, 0, 0 };
+};
+
+} // namespace Game
@@ -0,0 +1,473 @@
+// 存档编解码基准与模糊测试实现：
+// - 合成世界使用固定种子的 std::mt19937，同一种子下报告中的字节数可直接对比；
+// - 三种编码都以“读回后再编码，结果与原始字节一致”作为往返校验标准；
+// - 模糊测试只要求解码器在损坏输入上正常返回（不崩溃、不挂起、不申请巨量内存）。
+#include "Game/Save/SaveBenchmark.h"
+#include "Game/WorldState.h"
+#include "Game/Inventory.h"
+#include "Game/Tool/ToolFactory.h"
+#include "Game/Save/SaveDetail.h"
+#include "Game/Save/SaveBinary.h"
+#include "Game/Save/SaveCodec.h"
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <random>
+#include <algorithm>
+
+namespace Game {
+
+namespace {
+
+using BenchClock = std::chrono::steady_clock;
+
+double msSince(BenchClock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(BenchClock::now() - t0).count();
+}
+
+struct BenchSize {
+    const char* name;
+    int chests;
+    int drops;
+    bool fullFarm;
+    int obstacles;
+    int animals;
+    int iterations;
+};
+
+const BenchSize kBenchSizes[] = {
+    { "small", 10, 100, false, 50, 4, 20 },
+    { "medium", 1000, 10000, false, 500, 40, 5 },
+    { "large", 10000, 100000, true, 2000, 200, 2 },
+};
+
+const ItemType kBenchItems[] = {
+    ItemType::Wood, ItemType::Stone, ItemType::Fiber, ItemType::Omelet,
+    ItemType::ParsnipSoup, ItemType::Salad, ItemType::FriedEgg, ItemType::Tortilla,
+};
+const int kBenchItemCount = static_cast<int>(sizeof(kBenchItems) / sizeof(kBenchItems[0]));
+const int kBenchToolKinds = 7;
+const int kBenchInventorySlots = 36;
+
+int randInt(std::mt19937& rng, int lo, int hi) {
+    return std::uniform_int_distribution<int>(lo, hi)(rng);
+}
+
+// 背包从 0 号格起连续填充（先工具后互不相同的物品），文本读取按顺序 addItems 也能还原到原位置。
+std::shared_ptr<Inventory> makeBenchInventory() {
+    auto inv = std::make_shared<Inventory>(static_cast<std::size_t>(kBenchInventorySlots));
+    for (int k = 0; k < kBenchToolKinds; ++k) {
+        auto tool = makeTool(static_cast<ToolKind>(k));
+        if (tool) tool->setLevel(k % 4);
+        inv->setTool(static_cast<std::size_t>(k), tool);
+    }
+    for (int i = 0; i < kBenchItemCount; ++i) {
+        inv->addItems(kBenchItems[i], 10 + i * 7);
+    }
+    return inv;
+}
+
+void fillBenchChest(Chest& chest, std::mt19937& rng) {
+    for (std::size_t k = 0; k < chest.slots.size(); ++k) {
+        Slot& s = chest.slots[k];
+        if (k % 12 == 11) {
+            s.kind = SlotKind::Tool;
+            s.tool = makeTool(static_cast<ToolKind>(randInt(rng, 0, kBenchToolKinds - 1)));
+            if (s.tool) s.tool->setLevel(randInt(rng, 0, 3));
+        } else if (randInt(rng, 0, 3) != 0) {
+            s.kind = SlotKind::Item;
+            s.itemType = kBenchItems[randInt(rng, 0, kBenchItemCount - 1)];
+            s.itemQty = randInt(rng, 1, ItemStack::MAX_STACK);
+        }
+    }
+    refreshChestEmpty(chest);
+}
+
+// 按规模构造合成世界；坐标取整数倍格子、浮点取 1/4 的倍数，文本格式也能精确表示。
+void buildBenchWorld(const BenchSize& size, unsigned int seed, WorldState& ws) {
+    std::mt19937 rng(seed);
+    const int cols = GameConfig::MAP_COLS;
+    const int rows = GameConfig::MAP_ROWS;
+    const float tile = static_cast<float>(GameConfig::TILE_SIZE);
+    ws = WorldState();
+    ws.inventory = makeBenchInventory();
+    fillBenchChest(ws.globalChest, rng);
+
+    ws.farmTiles.reset(cols, rows, TileType::Soil);
+    for (std::size_t i = 0; i < ws.farmTiles.size(); ++i) {
+        if (size.fullFarm || randInt(rng, 0, 7) == 0) {
+            ws.farmTiles.setAt(i, randInt(rng, 0, 1) ? TileType::Watered : TileType::Tilled);
+        }
+    }
+    ws.farmTiles.clearJournal();
+
+    std::vector<Chest>* chestLists[] = { &ws.farmChests, &ws.houseChests, &ws.townChests, &ws.beachChests };
+    for (int i = 0; i < size.chests; ++i) {
+        Chest chest;
+        chest.pos = cocos2d::Vec2((i % cols) * tile, (i / cols % rows) * tile);
+        fillBenchChest(chest, rng);
+        chestLists[i % 4]->push_back(chest);
+    }
+
+    ws.farmDrops.reserve(static_cast<std::size_t>(size.drops));
+    for (int i = 0; i < size.drops; ++i) {
+        Drop d;
+        d.type = kBenchItems[randInt(rng, 0, kBenchItemCount - 1)];
+        d.pos = cocos2d::Vec2(randInt(rng, 0, cols * 4) * 0.25f * tile, randInt(rng, 0, rows * 4) * 0.25f * tile);
+        d.qty = randInt(rng, 1, 20);
+        ws.farmDrops.push_back(d);
+    }
+
+    std::vector<Furnace>* furnaceLists[] = { &ws.farmFurnaces, &ws.houseFurnaces, &ws.townFurnaces, &ws.beachFurnaces };
+    for (int i = 0; i < size.obstacles / 10; ++i) {
+        Furnace f;
+        f.pos = cocos2d::Vec2((i % cols) * tile, (i / cols % rows) * tile);
+        f.oreType = ItemType::CopperGrain;
+        f.remainingSeconds = randInt(rng, 0, 400) * 0.25f;
+        furnaceLists[i % 4]->push_back(f);
+    }
+
+    if (size.fullFarm) {
+        ws.farmCrops.reserve(static_cast<std::size_t>(cols) * rows);
+    }
+    int cropCount = size.fullFarm ? cols * rows : size.chests / 2;
+    for (int i = 0; i < cropCount; ++i) {
+        Crop cp;
+        cp.c = i % cols;
+        cp.r = i / cols % rows;
+        cp.type = static_cast<CropType>(randInt(rng, 0, 4));
+        cp.maxStage = randInt(rng, 3, 5);
+        cp.stage = randInt(rng, 0, cp.maxStage);
+        cp.progress = randInt(rng, 0, 3);
+        cp.wateredToday = randInt(rng, 0, 1) != 0;
+        ws.farmCrops.push_back(cp);
+    }
+
+    for (int i = 0; i < size.obstacles; ++i) {
+        ws.farmTrees.push_back(TreePos{ randInt(rng, 0, cols - 1), randInt(rng, 0, rows - 1),
+                                        randInt(rng, 0, 1) ? TreeKind::Tree1 : TreeKind::Tree2 });
+        ws.farmRocks.push_back(RockPos{ randInt(rng, 0, cols - 1), randInt(rng, 0, rows - 1),
+                                        randInt(rng, 0, 1) ? RockKind::Rock1 : RockKind::Rock2 });
+        ws.farmWeeds.push_back(WeedPos{ randInt(rng, 0, cols - 1), randInt(rng, 0, rows - 1) });
+    }
+
+    for (int i = 0; i < size.animals; ++i) {
+        Animal a;
+        a.type = static_cast<AnimalType>(randInt(rng, 0, 2));
+        a.pos = cocos2d::Vec2(randInt(rng, 0, cols) * tile, randInt(rng, 0, rows) * tile);
+        a.target = a.pos + cocos2d::Vec2(tile, 0.0f);
+        a.speed = randInt(rng, 10, 40) * 0.25f;
+        a.wanderRadius = static_cast<float>(randInt(rng, 2, 6));
+        a.ageDays = randInt(rng, 0, 10);
+        a.isAdult = a.ageDays >= 5;
+        a.fedToday = randInt(rng, 0, 1) != 0;
+        ws.farmAnimals.push_back(a);
+    }
+
+    for (auto& st : ws.skillTrees) {
+        st.totalXp = randInt(rng, 0, 5000);
+        st.unspentPoints = randInt(rng, 0, 5);
+        for (int n = 0; n < 8; ++n) st.unlockedNodeIds.push_back(n * 3 + randInt(rng, 0, 2));
+    }
+    for (int id = 0; id < 12; ++id) {
+        ws.npcFriendship[id] = randInt(rng, 0, 2500);
+        ws.npcRomanceUnlocked[id] = randInt(rng, 0, 1) != 0;
+        ws.npcLastGiftDay[id] = randInt(rng, 0, 120);
+        std::vector<NpcQuest> quests;
+        for (int q = 0; q < 2; ++q) {
+            quests.push_back(NpcQuest{ "Quest " + std::to_string(id * 10 + q),
+                                       "Bring " + std::to_string(randInt(rng, 1, 30)) + " items to the saloon." });
+        }
+        ws.npcQuests[id] = quests;
+    }
+}
+
+// ---- 三种编码 ----
+
+std::string encodeBinary(const WorldState& ws) {
+    std::ostringstream out;
+    writeBinarySave(out, encodeSaveSections(ws));
+    return out.str();
+}
+
+std::string encodeZlib(const WorldState& ws, int level) {
+    std::ostringstream out;
+    out.write(kCompressedSaveMagic, static_cast<std::streamsize>(kCompressedSaveMagicLen));
+    out.put(static_cast<char>(kSaveCodecZlib));
+    DeflateStreamBuf deflater(out, level);
+    std::ostream zout(&deflater);
+    if (!writeBinarySave(zout, encodeSaveSections(ws)) || !deflater.finish()) return std::string();
+    return out.str();
+}
+
+bool decodeZlib(const std::string& data, WorldState& ws) {
+    if (!isCompressedSave(data)) return false;
+    std::istringstream in(data);
+    in.seekg(static_cast<std::streamoff>(kCompressedSaveMagicLen + 1));
+    std::string plain;
+    if (!inflateSaveStream(in, plain, std::numeric_limits<std::size_t>::max())) return false;
+    return readBinarySave(plain, ws);
+}
+
+// 文本编码：依次使用 SaveDetail.h 中的各个读写函数（与旧版文本存档的列表部分顺序一致）。
+std::string encodeText(const WorldState& ws) {
+    std::ostringstream out;
+    writeInventory(out, ws.inventory);
+    writeChest(out, ws.globalChest);
+    writeDrops(out, ws.farmDrops);
+    writeFurnaces(out, ws.farmFurnaces);
+    writeFurnaces(out, ws.houseFurnaces);
+    writeFurnaces(out, ws.townFurnaces);
+    writeFurnaces(out, ws.beachFurnaces);
+    writeChests(out, ws.farmChests);
+    writeCrops(out, ws.farmCrops);
+    writeTreePositions(out, ws.farmTrees);
+    writeRockPositions(out, ws.farmRocks);
+    writeWeedPositions(out, ws.farmWeeds);
+    writeAnimals(out, ws.farmAnimals);
+    writeSkillTrees(out, ws.skillTrees);
+    writeChests(out, ws.houseChests);
+    writeChests(out, ws.townChests);
+    writeChests(out, ws.beachChests);
+    writeNpcData(out, ws);
+    return out.str();
+}
+
+bool decodeText(const std::string& data, WorldState& ws) {
+    std::istringstream in(data);
+    ws.inventory = readInventory(in);
+    ws.globalChest = readChest(in);
+    readDrops(in, ws.farmDrops);
+    readFurnaces(in, ws.farmFurnaces);
+    readFurnaces(in, ws.houseFurnaces);
+    readFurnaces(in, ws.townFurnaces);
+    readFurnaces(in, ws.beachFurnaces);
+    readChests(in, ws.farmChests);
+    readCrops(in, ws.farmCrops);
+    readTreePositions(in, ws.farmTrees);
+    readRockPositions(in, ws.farmRocks);
+    readWeedPositions(in, ws.farmWeeds);
+    readAnimals(in, ws.farmAnimals);
+    readSkillTrees(in, ws.skillTrees);
+    readChests(in, ws.houseChests);
+    readChests(in, ws.townChests);
+    readChests(in, ws.beachChests);
+    readNpcData(in, ws);
+    return !in.fail();
+}
+
+// ---- 往返计时 ----
+
+struct CodecResult {
+    const char* codec = "";
+    std::size_t bytes = 0;
+    double saveMs = 0.0;
+    double loadMs = 0.0;
+    bool roundTrip = false;
+};
+
+enum class BenchCodec { Binary, Zlib, Text };
+
+const int kBenchZlibLevel = 6;
+
+std::string encodeWith(BenchCodec codec, const WorldState& ws) {
+    switch (codec) {
+        case BenchCodec::Binary: return encodeBinary(ws);
+        case BenchCodec::Zlib: return encodeZlib(ws, kBenchZlibLevel);
+        case BenchCodec::Text: return encodeText(ws);
+    }
+    return std::string();
+}
+
+bool decodeWith(BenchCodec codec, const std::string& data, WorldState& ws) {
+    switch (codec) {
+        case BenchCodec::Binary: return readBinarySave(data, ws);
+        case BenchCodec::Zlib: return decodeZlib(data, ws);
+        case BenchCodec::Text: return decodeText(data, ws);
+    }
+    return false;
+}
+
+const char* codecName(BenchCodec codec) {
+    switch (codec) {
+        case BenchCodec::Binary: return "binary";
+        case BenchCodec::Zlib: return "zlib";
+        case BenchCodec::Text: return "text";
+    }
+    return "";
+}
+
+// 存/读各执行 iterations 次取最短耗时；往返校验比较“读回后再编码”的结果。
+// zlib 的压缩字节与压缩器内部状态有关，因此比较解压后的二进制内容。
+CodecResult benchCodec(BenchCodec codec, const WorldState& ws, int iterations) {
+    CodecResult result;
+    result.codec = codecName(codec);
+    std::string data;
+    for (int i = 0; i < iterations; ++i) {
+        auto t0 = BenchClock::now();
+        data = encodeWith(codec, ws);
+        double ms = msSince(t0);
+        result.saveMs = (i == 0) ? ms : std::min(result.saveMs, ms);
+    }
+    result.bytes = data.size();
+    WorldState loaded;
+    bool decoded = false;
+    for (int i = 0; i < iterations; ++i) {
+        loaded = WorldState();
+        auto t0 = BenchClock::now();
+        decoded = decodeWith(codec, data, loaded);
+        double ms = msSince(t0);
+        result.loadMs = (i == 0) ? ms : std::min(result.loadMs, ms);
+    }
+    if (decoded) {
+        if (codec == BenchCodec::Zlib) {
+            result.roundTrip = (encodeBinary(loaded) == encodeBinary(ws));
+        } else {
+            result.roundTrip = (encodeWith(codec, loaded) == data);
+        }
+    }
+    return result;
+}
+
+// ---- 模糊测试 ----
+
+struct FuzzResult {
+    const char* codec = "";
+    int cases = 0;
+    int accepted = 0;
+    int rejected = 0;
+    double maxMs = 0.0;
+};
+
+// 二进制输入：截断、随机翻转若干字节、或把某处 4 字节改成极大的数量值。
+std::string mutateBinary(const std::string& src, std::mt19937& rng) {
+    std::string data = src;
+    if (data.empty()) return data;
+    switch (randInt(rng, 0, 2)) {
+        case 0:
+            data.resize(static_cast<std::size_t>(randInt(rng, 0, static_cast<int>(data.size()) - 1)));
+            break;
+        case 1: {
+            int flips = randInt(rng, 1, 8);
+            for (int i = 0; i < flips; ++i) {
+                std::size_t pos = static_cast<std::size_t>(randInt(rng, 0, static_cast<int>(data.size()) - 1));
+                data[pos] = static_cast<char>(data[pos] ^ randInt(rng, 1, 255));
+            }
+        } break;
+        default: {
+            static const std::uint32_t kHuge[] = { 0xFFFFFFFFu, 0x7FFFFFFFu, 0x10000000u, 0x00FFFFFFu };
+            std::uint32_t v = kHuge[randInt(rng, 0, 3)];
+            std::size_t pos = static_cast<std::size_t>(randInt(rng, 0, static_cast<int>(data.size()) - 1));
+            for (int b = 0; b < 4 && pos + b < data.size(); ++b) {
+                data[pos + b] = static_cast<char>((v >> (8 * b)) & 0xFF);
+            }
+        } break;
+    }
+    return data;
+}
+
+// 文本输入：截断、随机替换若干字符、或把某个数字替换成极大/负数。
+std::string mutateText(const std::string& src, std::mt19937& rng) {
+    std::string data = src;
+    if (data.empty()) return data;
+    switch (randInt(rng, 0, 2)) {
+        case 0:
+            data.resize(static_cast<std::size_t>(randInt(rng, 0, static_cast<int>(data.size()) - 1)));
+            break;
+        case 1: {
+            static const char kChars[] = "0123456789 -\nx.";
+            int flips = randInt(rng, 1, 8);
+            for (int i = 0; i < flips; ++i) {
+                std::size_t pos = static_cast<std::size_t>(randInt(rng, 0, static_cast<int>(data.size()) - 1));
+                data[pos] = kChars[randInt(rng, 0, static_cast<int>(sizeof(kChars)) - 2)];
+            }
+        } break;
+        default: {
+            static const char* kNumbers[] = { "4294967295", "18446744073709551615", "-1", "2147483647" };
+            std::size_t pos = static_cast<std::size_t>(randInt(rng, 0, static_cast<int>(data.size()) - 1));
+            while (pos < data.size() && (data[pos] < '0' || data[pos] > '9')) ++pos;
+            std::size_t end = pos;
+            while (end < data.size() && data[end] >= '0' && data[end] <= '9') ++end;
+            data.replace(pos, end - pos, kNumbers[randInt(rng, 0, 3)]);
+        } break;
+    }
+    return data;
+}
+
+FuzzResult fuzzCodec(BenchCodec codec, const WorldState& ws, int iterations, std::mt19937& rng) {
+    FuzzResult result;
+    result.codec = codecName(codec);
+    const std::string clean = encodeWith(codec, ws);
+    for (int i = 0; i < iterations; ++i) {
+        std::string data = (codec == BenchCodec::Text) ? mutateText(clean, rng) : mutateBinary(clean, rng);
+        WorldState loaded;
+        auto t0 = BenchClock::now();
+        bool ok = decodeWith(codec, data, loaded);
+        if (ok) encodeWith(codec, loaded); // 接受的输入再编码一次，确认解出的状态可以继续使用
+        double ms = msSince(t0);
+        ++result.cases;
+        if (ok) ++result.accepted;
+        else ++result.rejected;
+        result.maxMs = std::max(result.maxMs, ms);
+    }
+    return result;
+}
+
+void writeCodecJson(std::ostream& out, const CodecResult& r) {
+    out << "{\"codec\":\"" << r.codec << "\",\"bytes\":" << r.bytes
+        << ",\"saveMs\":" << r.saveMs << ",\"loadMs\":" << r.loadMs
+        << ",\"roundTrip\":" << (r.roundTrip ? "true" : "false") << "}";
+}
+
+void writeFuzzJson(std::ostream& out, const FuzzResult& r) {
+    out << "{\"codec\":\"" << r.codec << "\",\"cases\":" << r.cases
+        << ",\"accepted\":" << r.accepted << ",\"rejected\":" << r.rejected
+        << ",\"maxMs\":" << r.maxMs << "}";
+}
+
+} // namespace
+
+int runSaveBenchmark(const SaveBenchOptions& options) {
+    const BenchCodec codecs[] = { BenchCodec::Binary, BenchCodec::Zlib, BenchCodec::Text };
+    std::ostringstream report;
+    bool allOk = true;
+    report << "{\"seed\":" << options.seed << ",\"sizes\":[";
+    for (std::size_t s = 0; s < sizeof(kBenchSizes) / sizeof(kBenchSizes[0]); ++s) {
+        const BenchSize& size = kBenchSizes[s];
+        WorldState ws;
+        buildBenchWorld(size, options.seed + static_cast<unsigned int>(s), ws);
+        if (s > 0) report << ",";
+        report << "{\"name\":\"" << size.name << "\",\"chests\":" << size.chests
+               << ",\"drops\":" << size.drops << ",\"crops\":" << ws.farmCrops.size()
+               << ",\"codecs\":[";
+        for (std::size_t c = 0; c < sizeof(codecs) / sizeof(codecs[0]); ++c) {
+            CodecResult r = benchCodec(codecs[c], ws, size.iterations);
+            allOk = allOk && r.roundTrip;
+            if (c > 0) report << ",";
+            writeCodecJson(report, r);
+        }
+        report << "]}";
+    }
+    report << "]";
+    if (options.fuzz) {
+        std::mt19937 rng(options.seed);
+        WorldState ws;
+        buildBenchWorld(kBenchSizes[0], options.seed, ws);
+        report << ",\"fuzz\":[";
+        for (std::size_t c = 0; c < sizeof(codecs) / sizeof(codecs[0]); ++c) {
+            if (c > 0) report << ",";
+            writeFuzzJson(report, fuzzCodec(codecs[c], ws, options.fuzzIterations, rng));
+        }
+        report << "]";
+    }
+    report << ",\"ok\":" << (allOk ? "true" : "false") << "}\n";
+
+    std::ofstream out(options.reportPath, std::ios::trunc);
+    if (!out) return 1;
+    out << report.str();
+    out.close();
+    if (!out) return 1;
+    return allOk ? 0 : 1;
+}
+
+} // namespace Game
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+
+namespace Game {
+
+// 存档编解码基准与模糊测试（开发者工具，不参与正常游戏流程）：
+// - 以 small / medium / large 三档规模构造合成 WorldState（large 为 10k 箱子、100k 掉落、种满的农场）；
+// - 对二进制（SaveBinary.h）、zlib 压缩（SaveCodec.h）与文本（SaveDetail.h）三种编码计时存/读往返，
+//   并校验“读回后再编码”与原始字节完全一致；
+// - fuzz 为 true 时，对截断、字节翻转、数量字段篡改后的输入反复解码，统计拒绝/接受次数与最长耗时；
+// - 结果以 JSON 写入 reportPath。
+// 由启动参数 --save-bench（可加 --save-fuzz）触发，见 CommandLineModes.h。
+struct SaveBenchOptions {
+    std::string reportPath = "save_bench_report.json";
+    bool fuzz = false;
+    int fuzzIterations = 2000;
+    unsigned int seed = 20240601u;
+};
+
+// 返回 0 表示所有往返校验通过且报告写入成功，否则返回 1。
+int runSaveBenchmark(const SaveBenchOptions& options);
+
+} // namespace Game
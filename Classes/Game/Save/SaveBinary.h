@@ -0,0 +1,944 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <unordered_map>
+#include "Game/Save/SaveDetail.h"
+#include "Game/Save/SaveSystem.h"
+
+// 二进制存档（SDV_SAVE 11）的编码/解码细节：
+// - 文件首行与文本存档相同（"SDV_SAVE 11\n"），加载时读首行即可区分文本/二进制；
+// - 首行之后是段表：段数量 + 每段 { id, offset, size }，offset 相对文件开头；
+// - 各段内部使用小端定长字段；瓦片网格按游程编码（RLE），
+//   箱子/熔炉/作物/动物等列表为“数量 + 定长记录”；
+// - 加载时整块读入内存，按段表直接在缓冲区上解码，不存在的段保持默认值，未知段跳过；
+// - 第一个段固定为摘要段（季节/日期/金币/场景等），读档菜单只需读取文件开头几百字节；
+// - 快照标识段记录一个随机 id，增量日志（SaveJournal.h）据此确认自己对应哪一份快照。
+// 与 SaveDetail.h 相同，这里的函数放在匿名命名空间中，只供 SaveSystem.cpp、SaveBenchmark.cpp
+// 与 WorldSimulation.cpp（用段内容计算状态哈希）使用。
+namespace {
+
+const char kBinarySaveMagic[] = "SDV_SAVE 11\n";
+const std::size_t kBinarySaveMagicLen = sizeof(kBinarySaveMagic) - 1;
+
+// 段标识：数值写入文件，只能追加，不能修改已有取值。
+enum SaveSectionId : std::uint32_t {
+    SectionCore = 1,
+    SectionTiles = 2,
+    SectionElevator = 3,
+    SectionInventory = 4,
+    SectionGlobalChest = 5,
+    SectionDrops = 6,
+    SectionFurnaces = 7,
+    SectionChests = 8,
+    SectionCrops = 9,
+    SectionTrees = 10,
+    SectionRocks = 11,
+    SectionWeeds = 12,
+    SectionAnimals = 13,
+    SectionSkillTrees = 14,
+    SectionNpc = 15,
+    SectionSummary = 16,
+    SectionTileDelta = 17,
+    SectionSnapshotId = 18
+};
+
+// 各段内容的 FNV-1a 哈希（按段 id），用于判断两次存档之间哪些段发生了变化。
+using SaveSectionHashes = std::unordered_map<std::uint32_t, std::uint64_t>;
+
+// 读档时顺带得到的段信息：快照 id（旧存档没有该段时为 0）与各段哈希。
+struct SaveSectionInfo {
+    std::uint64_t snapshotId = 0;
+    SaveSectionHashes hashes;
+};
+
+std::uint64_t fnv1a64(const char* data, std::size_t size) {
+    std::uint64_t h = 14695981039346656037ULL;
+    for (std::size_t i = 0; i < size; ++i) {
+        h ^= static_cast<unsigned char>(data[i]);
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// 摘要段之前的最大字节数上限：首行 + 段数量 + 段表（预留 32 个段）。
+const std::size_t kSummaryPrefixBytes = kBinarySaveMagicLen + 4 + 24 * 32 + 64;
+
+// 段表中每一项的字节数：u32 id + u32 保留 + u64 offset + u64 size。
+const std::size_t kSectionEntrySize = 24;
+
+// BinWriter：向内存缓冲追加小端定长字段。
+class BinWriter {
+public:
+    void u8(std::uint8_t v) { _buf.push_back(static_cast<char>(v)); }
+    void u32(std::uint32_t v) {
+        char b[4];
+        for (int i = 0; i < 4; ++i) b[i] = static_cast<char>((v >> (8 * i)) & 0xFF);
+        _buf.append(b, 4);
+    }
+    void u64(std::uint64_t v) {
+        char b[8];
+        for (int i = 0; i < 8; ++i) b[i] = static_cast<char>((v >> (8 * i)) & 0xFF);
+        _buf.append(b, 8);
+    }
+    void i32(int v) { u32(static_cast<std::uint32_t>(v)); }
+    void i64(long long v) { u64(static_cast<std::uint64_t>(v)); }
+    void f32(float v) {
+        std::uint32_t bits = 0;
+        std::memcpy(&bits, &v, sizeof(bits));
+        u32(bits);
+    }
+    void boolean(bool v) { u8(v ? 1 : 0); }
+    void str(const std::string& s) {
+        u32(static_cast<std::uint32_t>(s.size()));
+        _buf.append(s);
+    }
+    const std::string& buffer() const { return _buf; }
+    std::size_t size() const { return _buf.size(); }
+
+private:
+    std::string _buf;
+};
+
+// BinReader：在只读缓冲上顺序解码；越界后 ok() 为 false，后续读取均返回 0。
+class BinReader {
+public:
+    BinReader(const char* data, std::size_t size) : _p(data), _end(data + size) {}
+
+    bool ok() const { return _ok; }
+    // 内容合法但语义不符（如尺寸不匹配）时由调用方标记失败。
+    void fail() {
+        _ok = false;
+        _p = _end;
+    }
+    std::size_t remaining() const { return static_cast<std::size_t>(_end - _p); }
+
+    std::uint8_t u8() {
+        if (!need(1)) return 0;
+        return static_cast<std::uint8_t>(*_p++);
+    }
+    std::uint32_t u32() {
+        if (!need(4)) return 0;
+        std::uint32_t v = 0;
+        for (int i = 0; i < 4; ++i) v |= static_cast<std::uint32_t>(static_cast<unsigned char>(_p[i])) << (8 * i);
+        _p += 4;
+        return v;
+    }
+    std::uint64_t u64() {
+        if (!need(8)) return 0;
+        std::uint64_t v = 0;
+        for (int i = 0; i < 8; ++i) v |= static_cast<std::uint64_t>(static_cast<unsigned char>(_p[i])) << (8 * i);
+        _p += 8;
+        return v;
+    }
+    int i32() { return static_cast<int>(u32()); }
+    long long i64() { return static_cast<long long>(u64()); }
+    float f32() {
+        std::uint32_t bits = u32();
+        float v = 0.0f;
+        std::memcpy(&v, &bits, sizeof(v));
+        return v;
+    }
+    bool boolean() { return u8() != 0; }
+    std::string str() {
+        std::uint32_t n = u32();
+        if (!need(n)) return std::string();
+        std::string s(_p, n);
+        _p += n;
+        return s;
+    }
+    // 读取元素个数前先按单条记录的最小字节数校验，防止损坏文件触发超大 reserve。
+    std::uint32_t count(std::size_t minRecordBytes) {
+        std::uint32_t n = u32();
+        if (minRecordBytes > 0 && n > remaining() / minRecordBytes) {
+            _ok = false;
+            _p = _end;
+            return 0;
+        }
+        return n;
+    }
+
+private:
+    bool need(std::size_t n) {
+        if (!_ok || remaining() < n) {
+            _ok = false;
+            _p = _end;
+            return false;
+        }
+        return true;
+    }
+
+    const char* _p;
+    const char* _end;
+    bool _ok = true;
+};
+
+// ---- 定长记录 ----
+
+// 槽位记录（背包/箱子通用）：u8 kind + i32 toolKind + i32 toolLevel + i32 itemType + i32 qty。
+const std::size_t kSlotRecordSize = 17;
+
+void binWriteSlotFields(BinWriter& w, Game::SlotKind kind, int tk, int tl, int itemType, int qty) {
+    w.u8(static_cast<std::uint8_t>(kind));
+    w.i32(tk);
+    w.i32(tl);
+    w.i32(itemType);
+    w.i32(qty);
+}
+
+void binWriteSlot(BinWriter& w, const Game::Slot& s) {
+    int tk = 0;
+    int tl = 0;
+    if (s.kind == Game::SlotKind::Tool && s.tool) {
+        tk = static_cast<int>(s.tool->kind());
+        tl = s.tool->level();
+    }
+    binWriteSlotFields(w, s.kind, tk, tl, static_cast<int>(s.itemType), s.itemQty);
+}
+
+void binReadSlot(BinReader& r, Game::Slot& s) {
+    int kind = r.u8();
+    int tk = r.i32();
+    int tl = r.i32();
+    s.kind = static_cast<Game::SlotKind>(kind);
+    s.itemType = static_cast<Game::ItemType>(r.i32());
+    s.itemQty = r.i32();
+    s.tool.reset();
+    if (s.kind == Game::SlotKind::Tool) {
+        s.tool = Game::makeTool(static_cast<Game::ToolKind>(tk));
+        if (s.tool) {
+            s.tool->setLevel(tl);
+        }
+    }
+}
+
+void binWriteInventory(BinWriter& w, const std::shared_ptr<Game::Inventory>& inv) {
+    if (!inv) {
+        w.u8(0);
+        w.u32(0);
+        return;
+    }
+    std::size_t sz = inv->size();
+    w.u8(1);
+    w.u32(static_cast<std::uint32_t>(sz));
+    for (std::size_t i = 0; i < sz; ++i) {
+        if (auto t = inv->toolAt(i)) {
+            binWriteSlotFields(w, Game::SlotKind::Tool, static_cast<int>(t->kind()), t->level(), 0, 0);
+        } else if (inv->isItem(i)) {
+            auto stack = inv->itemAt(i);
+            binWriteSlotFields(w, Game::SlotKind::Item, 0, 0, static_cast<int>(stack.type), stack.quantity);
+        } else {
+            binWriteSlotFields(w, Game::SlotKind::Empty, 0, 0, 0, 0);
+        }
+    }
+}
+
+// 与 readInventory 相同：物品通过 addItems 恢复（此时新背包尚未挂到 WorldState，不会溢出到全局箱子）。
+std::shared_ptr<Game::Inventory> binReadInventory(BinReader& r) {
+    int hasInv = r.u8();
+    std::uint32_t sz = r.count(kSlotRecordSize);
+    if (!r.ok() || hasInv == 0 || sz == 0) {
+        return nullptr;
+    }
+    auto inv = std::make_shared<Game::Inventory>(static_cast<std::size_t>(sz));
+    for (std::uint32_t i = 0; i < sz; ++i) {
+        Game::Slot s;
+        binReadSlot(r, s);
+        if (!r.ok()) break;
+        if (s.kind == Game::SlotKind::Tool) {
+            inv->setTool(static_cast<std::size_t>(i), s.tool);
+        } else if (s.kind == Game::SlotKind::Item) {
+            inv->addItems(s.itemType, s.itemQty);
+        }
+    }
+    return inv;
+}
+
+// 箱子记录：f32 x + f32 y + u32 槽位数 + 槽位记录。
+void binWriteChest(BinWriter& w, const Game::Chest& chest) {
+    w.f32(chest.pos.x);
+    w.f32(chest.pos.y);
+    w.u32(static_cast<std::uint32_t>(chest.slots.size()));
+    for (const auto& s : chest.slots) {
+        binWriteSlot(w, s);
+    }
+}
+
+Game::Chest binReadChest(BinReader& r) {
+    Game::Chest chest;
+    float x = r.f32();
+    float y = r.f32();
+    chest.pos = cocos2d::Vec2(x, y);
+    std::uint32_t slots = r.count(kSlotRecordSize);
+    chest.slots.clear();
+    chest.slots.resize(static_cast<std::size_t>(slots));
+    for (auto& s : chest.slots) {
+        binReadSlot(r, s);
+    }
+    Game::refreshChestEmpty(chest);
+    return chest;
+}
+
+void binWriteChests(BinWriter& w, const std::vector<Game::Chest>& chests) {
+    w.u32(static_cast<std::uint32_t>(chests.size()));
+    for (const auto& ch : chests) {
+        binWriteChest(w, ch);
+    }
+}
+
+void binReadChests(BinReader& r, std::vector<Game::Chest>& chests) {
+    std::uint32_t count = r.count(12);
+    chests.clear();
+    chests.reserve(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        Game::Chest ch = binReadChest(r);
+        if (!r.ok()) break;
+        chests.push_back(ch);
+    }
+}
+
+// 熔炉记录：f32 x + f32 y + i32 oreType + f32 remainingSeconds（16 字节）。
+void binWriteFurnaces(BinWriter& w, const std::vector<Game::Furnace>& furnaces) {
+    w.u32(static_cast<std::uint32_t>(furnaces.size()));
+    for (const auto& f : furnaces) {
+        w.f32(f.pos.x);
+        w.f32(f.pos.y);
+        w.i32(static_cast<int>(f.oreType));
+        w.f32(f.remainingSeconds);
+    }
+}
+
+void binReadFurnaces(BinReader& r, std::vector<Game::Furnace>& furnaces) {
+    std::uint32_t count = r.count(16);
+    furnaces.clear();
+    furnaces.reserve(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        Game::Furnace f;
+        float x = r.f32();
+        float y = r.f32();
+        f.pos = cocos2d::Vec2(x, y);
+        f.oreType = static_cast<Game::ItemType>(r.i32());
+        f.remainingSeconds = r.f32();
+        f.dropOffset = cocos2d::Vec2::ZERO;
+        if (!r.ok()) break;
+        furnaces.push_back(f);
+    }
+}
+
+// 掉落记录：i32 type + f32 x + f32 y + i32 qty（16 字节）。
+void binWriteDrops(BinWriter& w, const std::vector<Game::Drop>& drops) {
+    w.u32(static_cast<std::uint32_t>(drops.size()));
+    for (const auto& d : drops) {
+        w.i32(static_cast<int>(d.type));
+        w.f32(d.pos.x);
+        w.f32(d.pos.y);
+        w.i32(d.qty);
+    }
+}
+
+void binReadDrops(BinReader& r, std::vector<Game::Drop>& drops) {
+    std::uint32_t count = r.count(16);
+    drops.clear();
+    drops.reserve(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        Game::Drop d;
+        d.type = static_cast<Game::ItemType>(r.i32());
+        float x = r.f32();
+        float y = r.f32();
+        d.pos = cocos2d::Vec2(x, y);
+        d.qty = r.i32();
+        if (!r.ok()) break;
+        drops.push_back(d);
+    }
+}
+
+// 作物记录：i32 c/r/type/stage/progress/maxStage + u8 wateredToday（25 字节）。
+void binWriteCrops(BinWriter& w, const Game::CropStore& crops) {
+    w.u32(static_cast<std::uint32_t>(crops.size()));
+    for (std::size_t i = 0; i < crops.size(); ++i) {
+        const Game::Crop cp = crops.get(i);
+        w.i32(cp.c);
+        w.i32(cp.r);
+        w.i32(static_cast<int>(cp.type));
+        w.i32(cp.stage);
+        w.i32(cp.progress);
+        w.i32(cp.maxStage);
+        w.boolean(cp.wateredToday);
+    }
+}
+
+void binReadCrops(BinReader& r, Game::CropStore& crops) {
+    std::uint32_t count = r.count(25);
+    crops.clear();
+    crops.reserve(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        Game::Crop cp;
+        cp.c = r.i32();
+        cp.r = r.i32();
+        cp.type = static_cast<Game::CropType>(r.i32());
+        cp.stage = r.i32();
+        cp.progress = r.i32();
+        cp.maxStage = r.i32();
+        cp.wateredToday = r.boolean();
+        if (!r.ok()) break;
+        crops.push_back(cp);
+    }
+}
+
+// 树/石头记录：i32 c + i32 r + u8 kind（9 字节）；杂草记录：i32 c + i32 r（8 字节）。
+void binWriteTreePositions(BinWriter& w, const std::vector<Game::TreePos>& trees) {
+    w.u32(static_cast<std::uint32_t>(trees.size()));
+    for (const auto& t : trees) {
+        w.i32(t.c);
+        w.i32(t.r);
+        w.u8(static_cast<std::uint8_t>(t.kind));
+    }
+}
+
+void binReadTreePositions(BinReader& r, std::vector<Game::TreePos>& trees) {
+    std::uint32_t count = r.count(9);
+    trees.clear();
+    trees.reserve(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        Game::TreePos tp;
+        tp.c = r.i32();
+        tp.r = r.i32();
+        int kind = r.u8();
+        if (!r.ok()) break;
+        if (kind == static_cast<int>(Game::TreeKind::Tree1) ||
+            kind == static_cast<int>(Game::TreeKind::Tree2)) {
+            tp.kind = static_cast<Game::TreeKind>(kind);
+        } else {
+            tp.kind = Game::TreeKind::Tree1;
+        }
+        trees.push_back(tp);
+    }
+}
+
+void binWriteRockPositions(BinWriter& w, const std::vector<Game::RockPos>& rocks) {
+    w.u32(static_cast<std::uint32_t>(rocks.size()));
+    for (const auto& rp : rocks) {
+        w.i32(rp.c);
+        w.i32(rp.r);
+        w.u8(static_cast<std::uint8_t>(rp.kind));
+    }
+}
+
+void binReadRockPositions(BinReader& r, std::vector<Game::RockPos>& rocks) {
+    std::uint32_t count = r.count(9);
+    rocks.clear();
+    rocks.reserve(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        Game::RockPos rp;
+        rp.c = r.i32();
+        rp.r = r.i32();
+        int kind = r.u8();
+        if (!r.ok()) break;
+        if (kind == static_cast<int>(Game::RockKind::Rock1) ||
+            kind == static_cast<int>(Game::RockKind::Rock2)) {
+            rp.kind = static_cast<Game::RockKind>(kind);
+        } else {
+            rp.kind = Game::RockKind::Rock1;
+        }
+        rocks.push_back(rp);
+    }
+}
+
+void binWriteWeedPositions(BinWriter& w, const std::vector<Game::WeedPos>& weeds) {
+    w.u32(static_cast<std::uint32_t>(weeds.size()));
+    for (const auto& wp : weeds) {
+        w.i32(wp.c);
+        w.i32(wp.r);
+    }
+}
+
+void binReadWeedPositions(BinReader& r, std::vector<Game::WeedPos>& weeds) {
+    std::uint32_t count = r.count(8);
+    weeds.clear();
+    weeds.reserve(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        Game::WeedPos wp;
+        wp.c = r.i32();
+        wp.r = r.i32();
+        if (!r.ok()) break;
+        weeds.push_back(wp);
+    }
+}
+
+// 动物记录：i32 type + f32 pos/target/speed/radius + i32 ageDays + u8 isAdult + u8 fedToday（34 字节）。
+void binWriteAnimals(BinWriter& w, const std::vector<Game::Animal>& animals) {
+    w.u32(static_cast<std::uint32_t>(animals.size()));
+    for (const auto& a : animals) {
+        w.i32(static_cast<int>(a.type));
+        w.f32(a.pos.x);
+        w.f32(a.pos.y);
+        w.f32(a.target.x);
+        w.f32(a.target.y);
+        w.f32(a.speed);
+        w.f32(a.wanderRadius);
+        w.i32(a.ageDays);
+        w.boolean(a.isAdult);
+        w.boolean(a.fedToday);
+    }
+}
+
+void binReadAnimals(BinReader& r, std::vector<Game::Animal>& animals) {
+    std::uint32_t count = r.count(34);
+    animals.clear();
+    animals.reserve(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        Game::Animal a;
+        a.type = static_cast<Game::AnimalType>(r.i32());
+        float px = r.f32();
+        float py = r.f32();
+        float tx = r.f32();
+        float ty = r.f32();
+        a.pos = cocos2d::Vec2(px, py);
+        a.target = cocos2d::Vec2(tx, ty);
+        a.speed = r.f32();
+        a.wanderRadius = r.f32();
+        a.ageDays = r.i32();
+        a.isAdult = r.boolean();
+        a.fedToday = r.boolean();
+        if (!r.ok()) break;
+        animals.push_back(a);
+    }
+}
+
+// ---- 段内容 ----
+
+// 摘要段：供读档菜单展示，字段均可从 WorldState 直接得到；加载存档时忽略。
+void binWriteSummary(BinWriter& w, const Game::WorldState& ws) {
+    w.i32(ws.seasonIndex);
+    w.i32(ws.dayOfSeason);
+    w.i32(ws.timeHour);
+    w.i32(ws.timeMinute);
+    w.i64(ws.gold);
+    w.i32(ws.lastScene);
+    w.i32(ws.lastMineFloor);
+}
+
+void binReadSummary(BinReader& r, Game::SaveSummary& out) {
+    out.seasonIndex = r.i32();
+    out.dayOfSeason = r.i32();
+    out.timeHour = r.i32();
+    out.timeMinute = r.i32();
+    out.gold = r.i64();
+    out.lastScene = r.i32();
+    out.lastMineFloor = r.i32();
+}
+
+void binWriteCore(BinWriter& w, const Game::WorldState& ws) {
+    w.i32(ws.seasonIndex);
+    w.i32(ws.dayOfSeason);
+    w.i32(ws.timeHour);
+    w.i32(ws.timeMinute);
+    w.f32(ws.timeAccum);
+    w.i32(ws.energy);
+    w.i32(ws.maxEnergy);
+    w.i32(ws.water);
+    w.i32(ws.maxWater);
+    w.i64(ws.gold);
+    w.i32(ws.hp);
+    w.i32(ws.maxHp);
+    w.i32(ws.selectedIndex);
+    w.boolean(ws.grantedSwordAtEntrance);
+    w.boolean(ws.fishingActive);
+    w.i32(ws.lastScene);
+    w.f32(ws.lastPlayerX);
+    w.f32(ws.lastPlayerY);
+    w.i32(ws.lastMineFloor);
+    w.i32(ws.lastSaveSlot);
+    w.boolean(ws.isRaining);
+    w.i32(ws.weatherSeasonIndex);
+    w.i32(ws.weatherDayOfSeason);
+    w.i32(ws.playerShirt);
+    w.i32(ws.playerPants);
+    w.i32(ws.playerHair);
+    w.i32(ws.playerHairR);
+    w.i32(ws.playerHairG);
+    w.i32(ws.playerHairB);
+}
+
+void binReadCore(BinReader& r, Game::WorldState& ws) {
+    ws.seasonIndex = r.i32();
+    ws.dayOfSeason = r.i32();
+    ws.timeHour = r.i32();
+    ws.timeMinute = r.i32();
+    ws.timeAccum = r.f32();
+    ws.energy = r.i32();
+    ws.maxEnergy = r.i32();
+    ws.water = r.i32();
+    ws.maxWater = r.i32();
+    ws.gold = r.i64();
+    ws.hp = r.i32();
+    ws.maxHp = r.i32();
+    ws.selectedIndex = r.i32();
+    ws.grantedSwordAtEntrance = r.boolean();
+    ws.fishingActive = r.boolean();
+    ws.lastScene = r.i32();
+    ws.lastPlayerX = r.f32();
+    ws.lastPlayerY = r.f32();
+    ws.lastMineFloor = r.i32();
+    ws.lastSaveSlot = r.i32();
+    ws.isRaining = r.boolean();
+    ws.weatherSeasonIndex = r.i32();
+    ws.weatherDayOfSeason = r.i32();
+    ws.playerShirt = r.i32();
+    ws.playerPants = r.i32();
+    ws.playerHair = r.i32();
+    ws.playerHairR = r.i32();
+    ws.playerHairG = r.i32();
+    ws.playerHairB = r.i32();
+}
+
+// 网格格子数上限：远大于任何实际地图，只用于拒绝损坏的尺寸字段。
+const std::size_t kMaxTileCount = 1u << 24;
+
+// 瓦片网格：i32 cols + i32 rows + u32 游程数 + 游程 { u32 长度 + u8 瓦片值 }。
+// 农场大片区域是相同的 NotSoil/Soil，游程编码通常只有几百条记录。
+void binWriteTiles(BinWriter& w, const Game::TileGrid& grid) {
+    w.i32(grid.cols());
+    w.i32(grid.rows());
+    const auto& tiles = grid.data();
+    std::vector<std::pair<std::uint32_t, std::uint8_t>> runs;
+    std::size_t i = 0;
+    while (i < tiles.size()) {
+        Game::TileType t = tiles[i];
+        std::size_t j = i + 1;
+        while (j < tiles.size() && tiles[j] == t) ++j;
+        runs.emplace_back(static_cast<std::uint32_t>(j - i), static_cast<std::uint8_t>(toInt(t)));
+        i = j;
+    }
+    w.u32(static_cast<std::uint32_t>(runs.size()));
+    for (const auto& run : runs) {
+        w.u32(run.first);
+        w.u8(run.second);
+    }
+}
+
+void binReadTiles(BinReader& r, Game::TileGrid& grid) {
+    int cols = r.i32();
+    int rows = r.i32();
+    std::uint32_t runCount = r.count(5);
+    std::size_t total = (cols > 0 && rows > 0)
+        ? static_cast<std::size_t>(cols) * static_cast<std::size_t>(rows) : 0;
+    if (total > kMaxTileCount) {
+        r.fail();
+        return;
+    }
+    std::vector<Game::TileType> tiles;
+    tiles.reserve(total);
+    for (std::uint32_t k = 0; k < runCount; ++k) {
+        std::uint32_t len = r.u32();
+        Game::TileType t = tileFromInt(r.u8());
+        if (!r.ok()) break;
+        std::size_t room = total - tiles.size();
+        tiles.insert(tiles.end(), len < room ? len : room, t);
+    }
+    tiles.resize(total, Game::TileType::NotSoil);
+    grid.assign(cols, rows, std::move(tiles));
+}
+
+// 瓦片增量：i32 cols + i32 rows + u32 条数 + 记录 { u32 下标 + u8 瓦片值 }。
+// 下标取自 TileGrid 的变更日志（可能重复，写入的都是当前值），只用于增量日志。
+void binWriteTileDelta(BinWriter& w, const Game::TileGrid& grid) {
+    w.i32(grid.cols());
+    w.i32(grid.rows());
+    const auto& changed = grid.journal();
+    w.u32(static_cast<std::uint32_t>(changed.size()));
+    for (int idx : changed) {
+        w.u32(static_cast<std::uint32_t>(idx));
+        w.u8(static_cast<std::uint8_t>(toInt(grid.at(static_cast<std::size_t>(idx)))));
+    }
+}
+
+// 网格尺寸与增量不一致时视为损坏：增量只能叠加在同尺寸的网格上。
+void binReadTileDelta(BinReader& r, Game::TileGrid& grid) {
+    int cols = r.i32();
+    int rows = r.i32();
+    std::uint32_t count = r.count(5);
+    if (!r.ok()) return;
+    if (cols != grid.cols() || rows != grid.rows()) {
+        r.fail();
+        return;
+    }
+    for (std::uint32_t k = 0; k < count; ++k) {
+        std::uint32_t idx = r.u32();
+        Game::TileType t = tileFromInt(r.u8());
+        if (!r.ok()) return;
+        grid.setAt(idx, t);
+    }
+}
+
+void binWriteElevator(BinWriter& w, const std::unordered_set<int>& floors) {
+    std::vector<int> sorted(floors.begin(), floors.end());
+    std::sort(sorted.begin(), sorted.end());
+    w.u32(static_cast<std::uint32_t>(sorted.size()));
+    for (int floor : sorted) {
+        w.i32(floor);
+    }
+}
+
+void binReadElevator(BinReader& r, std::unordered_set<int>& floors) {
+    std::uint32_t count = r.count(4);
+    floors.clear();
+    for (std::uint32_t i = 0; i < count; ++i) {
+        int floor = r.i32();
+        if (!r.ok()) break;
+        floors.insert(floor);
+    }
+}
+
+void binWriteSkillTrees(BinWriter& w, const std::array<Game::WorldState::SkillTreeProgress, 6>& skillTrees) {
+    w.u32(static_cast<std::uint32_t>(skillTrees.size()));
+    for (const auto& st : skillTrees) {
+        w.i32(st.totalXp);
+        w.i32(st.unspentPoints);
+        w.u32(static_cast<std::uint32_t>(st.unlockedNodeIds.size()));
+        for (int id : st.unlockedNodeIds) {
+            w.i32(id);
+        }
+    }
+}
+
+void binReadSkillTrees(BinReader& r, std::array<Game::WorldState::SkillTreeProgress, 6>& skillTrees) {
+    std::uint32_t count = r.count(12);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        Game::WorldState::SkillTreeProgress st;
+        st.totalXp = r.i32();
+        st.unspentPoints = r.i32();
+        std::uint32_t nodes = r.count(4);
+        st.unlockedNodeIds.reserve(nodes);
+        for (std::uint32_t n = 0; n < nodes; ++n) {
+            st.unlockedNodeIds.push_back(r.i32());
+        }
+        if (!r.ok()) break;
+        if (i < skillTrees.size()) {
+            skillTrees[i] = std::move(st);
+        }
+    }
+}
+
+void binWriteNpcData(BinWriter& w, const Game::WorldState& ws) {
+    w.u32(static_cast<std::uint32_t>(ws.npcFriendship.size()));
+    for (const auto* kv : sortedById(ws.npcFriendship)) {
+        w.i32(kv->first);
+        w.i32(kv->second);
+    }
+    w.u32(static_cast<std::uint32_t>(ws.npcRomanceUnlocked.size()));
+    for (const auto* kv : sortedById(ws.npcRomanceUnlocked)) {
+        w.i32(kv->first);
+        w.boolean(kv->second);
+    }
+    w.u32(static_cast<std::uint32_t>(ws.npcLastGiftDay.size()));
+    for (const auto* kv : sortedById(ws.npcLastGiftDay)) {
+        w.i32(kv->first);
+        w.i32(kv->second);
+    }
+    w.u32(static_cast<std::uint32_t>(ws.npcQuests.size()));
+    for (const auto* kv : sortedById(ws.npcQuests)) {
+        w.i32(kv->first);
+        w.u32(static_cast<std::uint32_t>(kv->second.size()));
+        for (const auto& q : kv->second) {
+            w.str(q.title);
+            w.str(q.description);
+        }
+    }
+}
+
+void binReadNpcData(BinReader& r, Game::WorldState& ws) {
+    ws.npcFriendship.clear();
+    std::uint32_t count = r.count(8);
+    for (std::uint32_t i = 0; i < count && r.ok(); ++i) {
+        int id = r.i32();
+        int value = r.i32();
+        if (r.ok()) ws.npcFriendship[id] = value;
+    }
+    ws.npcRomanceUnlocked.clear();
+    count = r.count(5);
+    for (std::uint32_t i = 0; i < count && r.ok(); ++i) {
+        int id = r.i32();
+        bool value = r.boolean();
+        if (r.ok()) ws.npcRomanceUnlocked[id] = value;
+    }
+    ws.npcLastGiftDay.clear();
+    count = r.count(8);
+    for (std::uint32_t i = 0; i < count && r.ok(); ++i) {
+        int id = r.i32();
+        int value = r.i32();
+        if (r.ok()) ws.npcLastGiftDay[id] = value;
+    }
+    ws.npcQuests.clear();
+    count = r.count(8);
+    for (std::uint32_t i = 0; i < count && r.ok(); ++i) {
+        int id = r.i32();
+        std::uint32_t questCount = r.count(8);
+        std::vector<Game::NpcQuest> quests;
+        quests.reserve(questCount);
+        for (std::uint32_t q = 0; q < questCount && r.ok(); ++q) {
+            Game::NpcQuest quest;
+            quest.title = r.str();
+            quest.description = r.str();
+            if (r.ok()) quests.push_back(quest);
+        }
+        if (r.ok()) ws.npcQuests[id] = quests;
+    }
+}
+
+// ---- 整体读写 ----
+
+// 按段编码后的存档：{ 段 id, 段内容 }，顺序即写出顺序。
+using SaveSections = std::vector<std::pair<std::uint32_t, BinWriter>>;
+
+// 在内存中分别编码各段（不含快照标识段，由调用方按需追加）。
+SaveSections encodeSaveSections(const Game::WorldState& ws) {
+    SaveSections sections;
+    auto add = [&sections](SaveSectionId id) -> BinWriter& {
+        sections.emplace_back(static_cast<std::uint32_t>(id), BinWriter());
+        return sections.back().second;
+    };
+    sections.reserve(17);
+    binWriteSummary(add(SectionSummary), ws);
+    binWriteCore(add(SectionCore), ws);
+    binWriteTiles(add(SectionTiles), ws.farmTiles);
+    binWriteElevator(add(SectionElevator), ws.abyssElevatorFloors);
+    binWriteInventory(add(SectionInventory), ws.inventory);
+    binWriteChest(add(SectionGlobalChest), ws.globalChest);
+    binWriteDrops(add(SectionDrops), ws.farmDrops);
+    {
+        BinWriter& w = add(SectionFurnaces);
+        binWriteFurnaces(w, ws.farmFurnaces);
+        binWriteFurnaces(w, ws.houseFurnaces);
+        binWriteFurnaces(w, ws.townFurnaces);
+        binWriteFurnaces(w, ws.beachFurnaces);
+    }
+    {
+        BinWriter& w = add(SectionChests);
+        binWriteChests(w, ws.farmChests);
+        binWriteChests(w, ws.houseChests);
+        binWriteChests(w, ws.townChests);
+        binWriteChests(w, ws.beachChests);
+    }
+    binWriteCrops(add(SectionCrops), ws.farmCrops);
+    binWriteTreePositions(add(SectionTrees), ws.farmTrees);
+    binWriteRockPositions(add(SectionRocks), ws.farmRocks);
+    binWriteWeedPositions(add(SectionWeeds), ws.farmWeeds);
+    binWriteAnimals(add(SectionAnimals), ws.farmAnimals);
+    binWriteSkillTrees(add(SectionSkillTrees), ws.skillTrees);
+    binWriteNpcData(add(SectionNpc), ws);
+    return sections;
+}
+
+// 把已编码的段写成完整的二进制存档：首行、段表、段内容依次写出。
+bool writeBinarySave(std::ostream& out, const SaveSections& sections) {
+    BinWriter header;
+    header.u32(static_cast<std::uint32_t>(sections.size()));
+    std::uint64_t offset = kBinarySaveMagicLen + 4 + kSectionEntrySize * sections.size();
+    for (const auto& sec : sections) {
+        header.u32(sec.first);
+        header.u32(0);
+        header.u64(offset);
+        header.u64(sec.second.size());
+        offset += sec.second.size();
+    }
+    out.write(kBinarySaveMagic, static_cast<std::streamsize>(kBinarySaveMagicLen));
+    out.write(header.buffer().data(), static_cast<std::streamsize>(header.size()));
+    for (const auto& sec : sections) {
+        out.write(sec.second.buffer().data(), static_cast<std::streamsize>(sec.second.size()));
+    }
+    return static_cast<bool>(out);
+}
+
+bool isBinarySave(const std::string& data) {
+    return data.size() >= kBinarySaveMagicLen &&
+           data.compare(0, kBinarySaveMagicLen, kBinarySaveMagic) == 0;
+}
+
+// 解码单个段到 ws；快照与增量日志共用。未知段直接跳过。
+bool decodeSaveSection(std::uint32_t id, BinReader& r, Game::WorldState& ws) {
+    switch (id) {
+        case SectionCore: binReadCore(r, ws); break;
+        case SectionTiles: binReadTiles(r, ws.farmTiles); break;
+        case SectionTileDelta: binReadTileDelta(r, ws.farmTiles); break;
+        case SectionElevator: binReadElevator(r, ws.abyssElevatorFloors); break;
+        case SectionInventory: ws.inventory = binReadInventory(r); break;
+        case SectionGlobalChest: ws.globalChest = binReadChest(r); break;
+        case SectionDrops: binReadDrops(r, ws.farmDrops); break;
+        case SectionFurnaces:
+            binReadFurnaces(r, ws.farmFurnaces);
+            binReadFurnaces(r, ws.houseFurnaces);
+            binReadFurnaces(r, ws.townFurnaces);
+            binReadFurnaces(r, ws.beachFurnaces);
+            break;
+        case SectionChests:
+            binReadChests(r, ws.farmChests);
+            binReadChests(r, ws.houseChests);
+            binReadChests(r, ws.townChests);
+            binReadChests(r, ws.beachChests);
+            break;
+        case SectionCrops: binReadCrops(r, ws.farmCrops); break;
+        case SectionTrees: binReadTreePositions(r, ws.farmTrees); break;
+        case SectionRocks: binReadRockPositions(r, ws.farmRocks); break;
+        case SectionWeeds: binReadWeedPositions(r, ws.farmWeeds); break;
+        case SectionAnimals: binReadAnimals(r, ws.farmAnimals); break;
+        case SectionSkillTrees: binReadSkillTrees(r, ws.skillTrees); break;
+        case SectionNpc: binReadNpcData(r, ws); break;
+        case SectionSummary: break; // 摘要仅供菜单使用
+        case SectionSnapshotId: break; // 由 readBinarySave 单独解析
+        default: break; // 新版本追加的段：旧加载器直接跳过
+    }
+    return r.ok();
+}
+
+// 在整块读入的缓冲上解码二进制存档；段表或任一段损坏时返回 false。
+// info 非空时一并返回快照 id 与各段内容哈希（供增量日志比较）。
+bool readBinarySave(const std::string& data, Game::WorldState& ws, SaveSectionInfo* info = nullptr) {
+    if (!isBinarySave(data)) return false;
+    BinReader table(data.data() + kBinarySaveMagicLen, data.size() - kBinarySaveMagicLen);
+    std::uint32_t sectionCount = table.count(kSectionEntrySize);
+    if (!table.ok()) return false;
+    for (std::uint32_t i = 0; i < sectionCount; ++i) {
+        std::uint32_t id = table.u32();
+        table.u32();
+        std::uint64_t offset = table.u64();
+        std::uint64_t size = table.u64();
+        if (!table.ok() || offset > data.size() || size > data.size() - offset) return false;
+        const char* payload = data.data() + offset;
+        BinReader r(payload, static_cast<std::size_t>(size));
+        if (id == SectionSnapshotId) {
+            std::uint64_t snapshotId = r.u64();
+            if (info && r.ok()) info->snapshotId = snapshotId;
+            continue;
+        }
+        if (!decodeSaveSection(id, r, ws)) return false;
+        if (info) info->hashes[id] = fnv1a64(payload, static_cast<std::size_t>(size));
+    }
+    return true;
+}
+
+// 只解析文件开头的段表与摘要段；prefix 可以是文件的前若干字节。
+bool readBinarySummary(const std::string& prefix, Game::SaveSummary& out) {
+    if (!isBinarySave(prefix)) return false;
+    BinReader table(prefix.data() + kBinarySaveMagicLen, prefix.size() - kBinarySaveMagicLen);
+    std::uint32_t sectionCount = table.u32();
+    for (std::uint32_t i = 0; i < sectionCount && table.ok(); ++i) {
+        std::uint32_t id = table.u32();
+        table.u32();
+        std::uint64_t offset = table.u64();
+        std::uint64_t size = table.u64();
+        if (!table.ok()) return false;
+        if (id != SectionSummary) continue;
+        if (offset > prefix.size() || size > prefix.size() - offset) return false;
+        BinReader r(prefix.data() + offset, static_cast<std::size_t>(size));
+        binReadSummary(r, out);
+        out.version = 11;
+        return r.ok();
+    }
+    return false;
+}
+
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include "zlib.h"
+
+// 压缩存档的外层封装：
+// - 文件开头为 "SDV_SAVEZ 1\n" + u8 编码方式（1 = zlib），其后是压缩流；
+// - 压缩流解开后就是完整的二进制存档（SDV_SAVE 11），读档时按首行自动识别，与当前写入设置无关；
+// - 写入经 DeflateStreamBuf 边编码边压缩、分块写盘，读取按块解压，均不需要整份压缩数据常驻内存。
+// 与 SaveBinary.h 相同，这里的函数放在匿名命名空间中，只供 SaveSystem.cpp 与 SaveBenchmark.cpp 使用。
+namespace {
+
+const char kCompressedSaveMagic[] = "SDV_SAVEZ 1\n";
+const std::size_t kCompressedSaveMagicLen = sizeof(kCompressedSaveMagic) - 1;
+const std::uint8_t kSaveCodecZlib = 1;
+const std::size_t kCodecChunkBytes = 64 * 1024;
+
+bool isCompressedSave(const std::string& prefix) {
+    return prefix.size() >= kCompressedSaveMagicLen + 1 &&
+           prefix.compare(0, kCompressedSaveMagicLen, kCompressedSaveMagic) == 0;
+}
+
+// DeflateStreamBuf：作为 std::ostream 的缓冲区，写满一块就压缩并写入 sink。
+// 写完后必须调用 finish() 结束压缩流；任一环节失败时 finish() 返回 false。
+class DeflateStreamBuf : public std::streambuf {
+public:
+    DeflateStreamBuf(std::ostream& sink, int level)
+        : _sink(sink), _in(kCodecChunkBytes), _out(kCodecChunkBytes) {
+        std::memset(&_z, 0, sizeof(_z));
+        _ok = (deflateInit(&_z, level) == Z_OK);
+        _inited = _ok;
+        setp(_in.data(), _in.data() + _in.size());
+    }
+    ~DeflateStreamBuf() override {
+        if (_inited) deflateEnd(&_z);
+    }
+
+    bool finish() {
+        if (_ok) _ok = compressPending(Z_FINISH);
+        return _ok;
+    }
+
+protected:
+    int_type overflow(int_type ch) override {
+        if (!_ok || !compressPending(Z_NO_FLUSH)) {
+            _ok = false;
+            return traits_type::eof();
+        }
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+private:
+    // 压缩缓冲区中已写入的数据；输出块写满就继续，直到 zlib 不再产生输出。
+    bool compressPending(int flush) {
+        _z.next_in = reinterpret_cast<Bytef*>(pbase());
+        _z.avail_in = static_cast<uInt>(pptr() - pbase());
+        int rc = Z_OK;
+        do {
+            _z.next_out = reinterpret_cast<Bytef*>(_out.data());
+            _z.avail_out = static_cast<uInt>(_out.size());
+            rc = deflate(&_z, flush);
+            if (rc == Z_STREAM_ERROR) return false;
+            std::size_t produced = _out.size() - _z.avail_out;
+            _sink.write(_out.data(), static_cast<std::streamsize>(produced));
+            if (!_sink) return false;
+        } while (_z.avail_out == 0);
+        setp(_in.data(), _in.data() + _in.size());
+        return flush != Z_FINISH || rc == Z_STREAM_END;
+    }
+
+    std::ostream& _sink;
+    std::vector<char> _in;
+    std::vector<char> _out;
+    z_stream _z;
+    bool _ok = false;
+    bool _inited = false;
+};
+
+// 从 in 的当前位置按块读取并解压 zlib 流，追加到 out；
+// 解出 limit 字节后提前停止（读档菜单只需要开头的摘要）。
+// 压缩流不完整或损坏时返回 false（提前停止不算失败）。
+bool inflateSaveStream(std::istream& in, std::string& out, std::size_t limit) {
+    z_stream z;
+    std::memset(&z, 0, sizeof(z));
+    if (inflateInit(&z) != Z_OK) return false;
+    std::vector<char> inBuf(kCodecChunkBytes);
+    std::vector<char> outBuf(kCodecChunkBytes);
+    int rc = Z_OK;
+    bool ok = true;
+    while (rc != Z_STREAM_END && out.size() < limit) {
+        if (z.avail_in == 0) {
+            in.read(inBuf.data(), static_cast<std::streamsize>(inBuf.size()));
+            std::streamsize got = in.gcount();
+            if (got <= 0) {
+                ok = false;
+                break;
+            }
+            z.next_in = reinterpret_cast<Bytef*>(inBuf.data());
+            z.avail_in = static_cast<uInt>(got);
+        }
+        z.next_out = reinterpret_cast<Bytef*>(outBuf.data());
+        z.avail_out = static_cast<uInt>(outBuf.size());
+        rc = inflate(&z, Z_NO_FLUSH);
+        if (rc != Z_OK && rc != Z_STREAM_END) {
+            ok = false;
+            break;
+        }
+        out.append(outBuf.data(), outBuf.size() - z.avail_out);
+    }
+    inflateEnd(&z);
+    if (out.size() > limit) out.resize(limit);
+    return ok;
+}
+
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <algorithm>
 #include <array>
 #include <vector>
 #include <limits>
@@ -20,11 +21,32 @@
 // 本文件中都是“读写存档细节”的工具函数：
 // - 负责把 WorldState/Chest/Inventory 等结构体序列化成纯文本（写入输出流）
 // - 或者从文本中解析回结构体（从输入流读取）
-// 这里放在头文件中，供 SaveSystem.cpp 直接包含使用。
+// 这里放在头文件中，供 SaveSystem.cpp（以及存档基准/模糊测试工具 SaveBenchmark.cpp）直接包含使用。
 // 注意：下方使用匿名命名空间（namespace { ... }），等价于 C 语言里的 static 函数，
 // 这些函数只在包含它的 .cpp 文件内部可见，不会污染全局命名空间。
 namespace {
 
+// 损坏的存档可能给出极大的数量：槽位数超过上限视为损坏，列表预留容量也设上限
+// （实际元素仍按读到的条数追加），避免一次性申请巨量内存。
+const int kMaxTextSlots = 4096;
+const std::size_t kMaxTextReserve = 4096;
+
+template <typename Container>
+void reserveBounded(Container& v, std::size_t count) {
+    v.reserve(count < kMaxTextReserve ? count : kMaxTextReserve);
+}
+
+// 无序容器按 id 升序写出：同一世界状态总是得到相同的存档字节（增量日志的段哈希也随之稳定）。
+template <typename Map>
+std::vector<const typename Map::value_type*> sortedById(const Map& m) {
+    typedef const typename Map::value_type* Entry;
+    std::vector<Entry> entries;
+    entries.reserve(m.size());
+    for (const auto& kv : m) entries.push_back(&kv);
+    std::sort(entries.begin(), entries.end(), [](Entry a, Entry b) { return a->first < b->first; });
+    return entries;
+}
+
 // 把地图格子的枚举类型 Game::TileType 转成 int，方便写入文本存档。
 // 存档只保存数字，加载时再反向转换回枚举。
 int toInt(Game::TileType t) {
@@ -97,6 +119,10 @@ std::shared_ptr<Game::Inventory> readInventory(std::istream& in) {
     if (!in || hasInv == 0 || sz <= 0) {
         return nullptr;
     }
+    if (sz > kMaxTextSlots) {
+        in.setstate(std::ios::failbit);
+        return nullptr;
+    }
     auto inv = std::make_shared<Game::Inventory>(static_cast<std::size_t>(sz));
     for (int i = 0; i < sz; ++i) {
         int kind = 0;
@@ -155,6 +181,10 @@ Game::Chest readChest(std::istream& in) {
     chest.pos = cocos2d::Vec2(x, y);
     chest.slots.clear();
     if (slots < 0) slots = 0;
+    if (slots > kMaxTextSlots) {
+        in.setstate(std::ios::failbit);
+        slots = 0;
+    }
     chest.slots.resize(static_cast<std::size_t>(slots));
     for (int i = 0; i < slots; ++i) {
         int kind = 0;
@@ -200,7 +230,7 @@ void readDrops(std::istream& in, std::vector<Game::Drop>& drops) {
     in >> count;
     in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
     drops.clear();
-    drops.reserve(count);
+    reserveBounded(drops, count);
     for (std::size_t i = 0; i < count; ++i) {
         int type = 0;
         float x = 0.0f;
@@ -236,7 +266,7 @@ void readFurnaces(std::istream& in, std::vector<Game::Furnace>& furnaces) {
     in >> count;
     in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
     furnaces.clear();
-    furnaces.reserve(count);
+    reserveBounded(furnaces, count);
     for (std::size_t i = 0; i < count; ++i) {
         float x = 0.0f;
         float y = 0.0f;
@@ -272,7 +302,7 @@ void readChests(std::istream& in, std::vector<Game::Chest>& chests) {
     in >> count;
     in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
     chests.clear();
-    chests.reserve(count);
+    reserveBounded(chests, count);
     for (std::size_t i = 0; i < count; ++i) {
         Game::Chest ch = readChest(in);
         if (!in) break;
@@ -282,9 +312,10 @@ void readChests(std::istream& in, std::vector<Game::Chest>& chests) {
 
 // 写入农作物列表：
 // - 每个 Game::Crop 保存坐标(c, r)、作物类型 type、生长阶段 stage、进度 progress 等。
-void writeCrops(std::ostream& out, const std::vector<Game::Crop>& crops) {
+void writeCrops(std::ostream& out, const Game::CropStore& crops) {
     out << crops.size() << '\n';
-    for (const auto& cp : crops) {
+    for (std::size_t i = 0; i < crops.size(); ++i) {
+        const Game::Crop cp = crops.get(i);
         out << cp.c << ' ' << cp.r << ' ' << static_cast<int>(cp.type) << ' '
             << cp.stage << ' ' << cp.progress << ' ' << cp.maxStage << ' '
             << (cp.wateredToday ? 1 : 0) << '\n';
@@ -294,12 +325,12 @@ void writeCrops(std::ostream& out, const std::vector<Game::Crop>& crops) {
 // 读取农作物列表：
 // - 注意使用 static_cast<Game::CropType>(type) 把 int 转回枚举；
 // - wateredToday 字段使用 0/1 存储，再转换成 bool。
-void readCrops(std::istream& in, std::vector<Game::Crop>& crops) {
+void readCrops(std::istream& in, Game::CropStore& crops) {
     std::size_t count = 0;
     in >> count;
     in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
     crops.clear();
-    crops.reserve(count);
+    reserveBounded(crops, count);
     for (std::size_t i = 0; i < count; ++i) {
         int c = 0;
         int r = 0;
@@ -339,7 +370,7 @@ void readTreePositions(std::istream& in, std::vector<Game::TreePos>& trees) {
     in >> count;
     in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
     trees.clear();
-    trees.reserve(count);
+    reserveBounded(trees, count);
     for (std::size_t i = 0; i < count; ++i) {
         int c = 0;
         int r = 0;
@@ -374,7 +405,7 @@ void readRockPositions(std::istream& in, std::vector<Game::RockPos>& rocks) {
     in >> count;
     in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
     rocks.clear();
-    rocks.reserve(count);
+    reserveBounded(rocks, count);
     for (std::size_t i = 0; i < count; ++i) {
         int c = 0;
         int r = 0;
@@ -409,7 +440,7 @@ void readWeedPositions(std::istream& in, std::vector<Game::WeedPos>& weeds) {
     in >> count;
     in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
     weeds.clear();
-    weeds.reserve(count);
+    reserveBounded(weeds, count);
     for (std::size_t i = 0; i < count; ++i) {
         int c = 0;
         int r = 0;
@@ -445,7 +476,7 @@ void readAnimals(std::istream& in, std::vector<Game::Animal>& animals) {
     in >> count;
     in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
     animals.clear();
-    animals.reserve(count);
+    reserveBounded(animals, count);
     for (std::size_t i = 0; i < count; ++i) {
         int type = 0;
         float px = 0.0f;
@@ -494,10 +525,11 @@ void readSkillTrees(std::istream& in, std::array<Game::WorldState::SkillTreeProg
         st.totalXp = totalXp;
         st.unspentPoints = unspentPoints;
         st.unlockedNodeIds.clear();
-        st.unlockedNodeIds.reserve(nodeCount);
+        reserveBounded(st.unlockedNodeIds, nodeCount);
         for (std::size_t i = 0; i < nodeCount; ++i) {
             int id = 0;
             in >> id;
+            if (!in) break;
             st.unlockedNodeIds.push_back(id);
         }
         in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
@@ -520,10 +552,11 @@ void readSkillTreesV4(std::istream& in, std::array<Game::WorldState::SkillTreePr
         st.totalXp = totalXp;
         st.unspentPoints = unspentPoints;
         st.unlockedNodeIds.clear();
-        st.unlockedNodeIds.reserve(nodeCount);
+        reserveBounded(st.unlockedNodeIds, nodeCount);
         for (std::size_t n = 0; n < nodeCount; ++n) {
             int id = 0;
             in >> id;
+            if (!in) break;
             st.unlockedNodeIds.push_back(id);
         }
         in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
@@ -532,21 +565,21 @@ void readSkillTreesV4(std::istream& in, std::array<Game::WorldState::SkillTreePr
 
 void writeNpcData(std::ostream& out, const Game::WorldState& ws) {
     out << ws.npcFriendship.size() << '\n';
-    for (const auto& kv : ws.npcFriendship) {
-        out << kv.first << ' ' << kv.second << '\n';
+    for (const auto* kv : sortedById(ws.npcFriendship)) {
+        out << kv->first << ' ' << kv->second << '\n';
     }
     out << ws.npcRomanceUnlocked.size() << '\n';
-    for (const auto& kv : ws.npcRomanceUnlocked) {
-        out << kv.first << ' ' << (kv.second ? 1 : 0) << '\n';
+    for (const auto* kv : sortedById(ws.npcRomanceUnlocked)) {
+        out << kv->first << ' ' << (kv->second ? 1 : 0) << '\n';
     }
     out << ws.npcLastGiftDay.size() << '\n';
-    for (const auto& kv : ws.npcLastGiftDay) {
-        out << kv.first << ' ' << kv.second << '\n';
+    for (const auto* kv : sortedById(ws.npcLastGiftDay)) {
+        out << kv->first << ' ' << kv->second << '\n';
     }
     out << ws.npcQuests.size() << '\n';
-    for (const auto& kv : ws.npcQuests) {
-        out << kv.first << ' ' << kv.second.size() << '\n';
-        for (const auto& q : kv.second) {
+    for (const auto* kv : sortedById(ws.npcQuests)) {
+        out << kv->first << ' ' << kv->second.size() << '\n';
+        for (const auto& q : kv->second) {
             out << q.title << '\n';
             out << q.description << '\n';
         }
@@ -598,7 +631,7 @@ void readNpcData(std::istream& in, Game::WorldState& ws) {
         in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
         if (!in) break;
         std::vector<Game::NpcQuest> quests;
-        quests.reserve(questCount);
+        reserveBounded(quests, questCount);
         for (std::size_t q = 0; q < questCount; ++q) {
             std::string title;
             std::string desc;
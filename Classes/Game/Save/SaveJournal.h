@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <ostream>
+#include "Game/Save/SaveBinary.h"
+
+// 增量存档日志（存档路径 + ".journal"）：
+// - 文件头为 "SDV_JOURNAL 1\n" + u64 快照 id，必须与快照中 SectionSnapshotId 段一致，否则整份日志作废；
+// - 之后是只追加的记录：{ u32 段 id + u32 保留 + u64 size + u64 hash } + 段内容，
+//   段内容与快照中同 id 的段格式相同（SectionTileDelta 为瓦片增量），回放时按顺序覆盖到 WorldState；
+// - hash 为段内容的 FNV-1a，兼作校验：写到一半的尾部记录（崩溃或断电）连同其后内容一起忽略；
+// - 完整快照写盘成功后删除日志，即“压缩”。
+// 与 SaveBinary.h 相同，这里的函数放在匿名命名空间中，只供 SaveSystem.cpp 使用。
+namespace {
+
+const char kJournalMagic[] = "SDV_JOURNAL 1\n";
+const std::size_t kJournalMagicLen = sizeof(kJournalMagic) - 1;
+const std::size_t kJournalHeaderSize = kJournalMagicLen + 8;
+const std::size_t kJournalRecordHeaderSize = 24;
+
+bool writeJournalHeader(std::ostream& out, std::uint64_t snapshotId) {
+    BinWriter w;
+    w.u64(snapshotId);
+    out.write(kJournalMagic, static_cast<std::streamsize>(kJournalMagicLen));
+    out.write(w.buffer().data(), static_cast<std::streamsize>(w.size()));
+    return static_cast<bool>(out);
+}
+
+bool writeJournalRecord(std::ostream& out, std::uint32_t id, const BinWriter& payload, std::uint64_t hash) {
+    BinWriter w;
+    w.u32(id);
+    w.u32(0);
+    w.u64(payload.size());
+    w.u64(hash);
+    out.write(w.buffer().data(), static_cast<std::streamsize>(w.size()));
+    out.write(payload.buffer().data(), static_cast<std::streamsize>(payload.size()));
+    return static_cast<bool>(out);
+}
+
+// 把日志回放到已载入快照的 ws 上：
+// - 日志头缺失或快照 id 不符时返回 false，ws 不受影响；
+// - 否则依次应用每条完整且校验通过的记录，同步更新 hashes（瓦片增量不参与哈希比较），
+//   validBytes 返回成功应用的字节数；小于 data.size() 说明尾部损坏。
+bool replayJournal(const std::string& data, std::uint64_t snapshotId, Game::WorldState& ws,
+                   SaveSectionHashes& hashes, std::size_t& validBytes) {
+    validBytes = 0;
+    if (data.size() < kJournalHeaderSize ||
+        data.compare(0, kJournalMagicLen, kJournalMagic) != 0) {
+        return false;
+    }
+    BinReader header(data.data() + kJournalMagicLen, 8);
+    if (header.u64() != snapshotId) return false;
+    std::size_t pos = kJournalHeaderSize;
+    validBytes = pos;
+    while (data.size() - pos >= kJournalRecordHeaderSize) {
+        BinReader rec(data.data() + pos, kJournalRecordHeaderSize);
+        std::uint32_t id = rec.u32();
+        rec.u32();
+        std::uint64_t size = rec.u64();
+        std::uint64_t hash = rec.u64();
+        std::size_t body = pos + kJournalRecordHeaderSize;
+        if (size > data.size() - body) break;
+        const char* payload = data.data() + body;
+        if (fnv1a64(payload, static_cast<std::size_t>(size)) != hash) break;
+        BinReader r(payload, static_cast<std::size_t>(size));
+        if (!decodeSaveSection(id, r, ws)) break;
+        if (id != SectionTileDelta) hashes[id] = hash;
+        pos = body + static_cast<std::size_t>(size);
+        validBytes = pos;
+    }
+    return true;
+}
+
+}
@@ -1,13 +1,27 @@
 #include "Game/Save/SaveSystem.h"
 #include "Game/WorldState.h"
 #include "Game/Inventory.h"
+#include "Game/PlaceableItem/FurnaceScheduler.h"
 #include "Game/Tool/ToolFactory.h"
 #include "Game/Save/SaveDetail.h"
+#include "Game/Save/SaveBinary.h"
+#include "Game/Save/SaveJournal.h"
+#include "Game/Save/SaveCodec.h"
 #include "cocos2d.h"
 #include <fstream>
 #include <sstream>
+#include <iterator>
 #include <limits>
 #include <unordered_set>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdio>
+#include <algorithm>
+#include <random>
+#include <sys/types.h>
+#include <sys/stat.h>
 
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
 #include <windows.h>
@@ -22,12 +36,51 @@ namespace Game {
 static std::string g_customSaveRoot;
 static std::string g_currentSavePath;
 
+// 后台存档计数：提交时加一，工作线程写盘结束后减一并唤醒等待者。
+static std::mutex g_pendingSaveMutex;
+static std::condition_variable g_pendingSaveCv;
+static int g_pendingSaves = 0;
+
+// 完整快照的压缩设置：后台 IO 线程写盘时读取，因此使用原子变量。
+static std::atomic<int> g_saveCodec{ static_cast<int>(SaveCodec::None) };
+static std::atomic<int> g_saveCompressionLevel{ Z_DEFAULT_COMPRESSION };
+
+// 存档索引文件：与存档同目录，缓存每个存档的摘要；主线程列表与后台写盘都会访问，需加锁。
+static const char* const kSaveIndexFileName = "save_index.dat";
+static std::mutex g_saveIndexMutex;
+
+// 增量存档状态：记录最近一次落盘（快照或日志）后磁盘上的内容，
+// saveCheckpoint 据此只追加发生变化的段。path 为空表示没有可追加的快照，下次需写完整快照。
+// 完整快照可能在后台 IO 线程写完后更新该状态，因此加锁访问。
+struct JournalState {
+    std::string path;
+    std::uint64_t snapshotId = 0;
+    SaveSectionHashes hashes;
+    // 瓦片不比较哈希：以 TileGrid 的版本号与变更日志判断是否可只写增量。
+    unsigned long long tilesRevision = 0;
+    int tilesCols = 0;
+    int tilesRows = 0;
+    std::uint64_t snapshotBytes = 0;
+    std::uint64_t journalBytes = 0;
+};
+static std::mutex g_journalMutex;
+static JournalState g_journal;
+
+// 日志超过快照大小（且不小于该下限）时，checkpoint 直接改写完整快照。
+static const std::uint64_t kJournalCompactMinBytes = 64 * 1024;
+
 // 设置自定义存档根目录，不做路径拼接与合法性检查；
 // 真正使用时会在 makeAbsoluteSaveRoot 中结合 FileUtils 做处理。
 void setSaveRootDirectory(const std::string& rootDir) {
     g_customSaveRoot = rootDir;
 }
 
+// 设置完整快照的压缩方式与等级；等级截断到 zlib 的 1~9。
+void setSaveCompression(SaveCodec codec, int level) {
+    g_saveCodec = static_cast<int>(codec);
+    g_saveCompressionLevel = std::max(1, std::min(9, level));
+}
+
 // 记录当前存档的完整路径，通常在保存或加载成功时调用。
 void setCurrentSavePath(const std::string& fullPath) {
     g_currentSavePath = fullPath;
@@ -62,6 +115,16 @@ static std::string utf8FromWide(const std::wstring& w) {
     return result;
 }
 
+// Windows 专用：UTF-8 转宽字符，用于调用 *W 版本的文件 API。
+static std::wstring wideFromUtf8(const std::string& s) {
+    if (s.empty()) return std::wstring();
+    int size = MultiByteToWideChar(CP_UTF8, 0, s.c_str(), static_cast<int>(s.size()), nullptr, 0);
+    if (size <= 0) return std::wstring();
+    std::wstring result(static_cast<std::size_t>(size), L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, s.c_str(), static_cast<int>(s.size()), &result[0], size);
+    return result;
+}
+
 // Windows 专用：获得当前可执行文件所在的目录，作为相对路径的“基准目录”。
 static std::string getExeDirectory() {
     WCHAR buffer[MAX_PATH + 1] = { 0 };
@@ -190,12 +253,8 @@ std::string defaultSavePath() {
     return savePathForSlot(1);
 }
 
-// 核心函数：把当前全局 WorldState 序列化到指定文件。
-// 主要流程：
-// 1. 处理 fullPath（为空则使用 defaultSavePath），并确保目录存在；
-// 2. 打开 std::ofstream，写入存档版本号与基础数值字段；
-// 3. 利用 SaveDetail.h 中的辅助函数写入 Inventory / Chest / Furnace / Crop 等列表。
-bool saveToFile(const std::string& fullPath) {
+// 处理存档路径：为空则使用 defaultSavePath，否则确保所在目录存在。
+static std::string resolveSavePath(const std::string& fullPath) {
     std::string path = fullPath;
     if (path.empty()) {
         path = defaultSavePath();
@@ -208,92 +267,468 @@ bool saveToFile(const std::string& fullPath) {
             }
         }
     }
-    g_currentSavePath = path;
-    std::ofstream out(path, std::ios::trunc);
-    if (!out) return false;
-    auto& ws = globalState();
-    out << "SDV_SAVE 10" << '\n';
-    out << ws.seasonIndex << ' ' << ws.dayOfSeason << ' '
-        << ws.timeHour << ' ' << ws.timeMinute << ' '
-        << ws.timeAccum << ' '
-        << ws.energy << ' ' << ws.maxEnergy << ' '
-        << ws.water << ' ' << ws.maxWater << ' '
-        << ws.gold << ' '
-        << ws.hp << ' ' << ws.maxHp << ' '
-        << ws.selectedIndex << ' '
-        << (ws.grantedSwordAtEntrance ? 1 : 0) << ' '
-        << (ws.fishingActive ? 1 : 0) << ' '
-        << ws.lastScene << ' '
-        << ws.lastPlayerX << ' '
-        << ws.lastPlayerY << ' '
-        << ws.lastMineFloor << ' '
-        << ws.lastSaveSlot << ' '
-        << (ws.isRaining ? 1 : 0) << ' '
-        << ws.weatherSeasonIndex << ' '
-        << ws.weatherDayOfSeason << ' '
-        << ws.playerShirt << ' '
-        << ws.playerPants << ' '
-        << ws.playerHair << ' '
-        << ws.playerHairR << ' '
-        << ws.playerHairG << ' '
-        << ws.playerHairB << '\n';
-    out << ws.farmCols << ' ' << ws.farmRows << '\n';
-    std::size_t tilesCount = ws.farmTiles.size();
-    out << tilesCount << '\n';
-    for (std::size_t i = 0; i < tilesCount; ++i) {
-        out << toInt(ws.farmTiles[i]);
-        if (i + 1 < tilesCount) {
-            out << ' ';
+    return path;
+}
+
+// 用临时文件原子替换目标文件：写盘中途失败或崩溃时，旧存档保持完整。
+static bool replaceFile(const std::string& tmpPath, const std::string& path) {
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+    return MoveFileExW(wideFromUtf8(tmpPath).c_str(), wideFromUtf8(path).c_str(),
+                       MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return std::rename(tmpPath.c_str(), path.c_str()) == 0;
+#endif
+}
+
+// ---- 存档摘要索引 ----
+
+struct SaveIndexEntry {
+    long long size = 0;
+    long long mtime = 0;
+    SaveSummary summary;
+};
+
+static std::string fileNameOf(const std::string& path) {
+    auto pos = path.find_last_of("/\\");
+    return pos == std::string::npos ? path : path.substr(pos + 1);
+}
+
+// 读取文件大小与修改时间，用于判断索引中的摘要是否过期。
+static bool fileStamp(const std::string& path, long long& size, long long& mtime) {
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+    struct _stat64 st;
+    if (_wstat64(wideFromUtf8(path).c_str(), &st) != 0) return false;
+#else
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) return false;
+#endif
+    size = static_cast<long long>(st.st_size);
+    mtime = static_cast<long long>(st.st_mtime);
+    return true;
+}
+
+static SaveSummary summaryOf(const WorldState& ws) {
+    SaveSummary s;
+    s.version = 11;
+    s.seasonIndex = ws.seasonIndex;
+    s.dayOfSeason = ws.dayOfSeason;
+    s.timeHour = ws.timeHour;
+    s.timeMinute = ws.timeMinute;
+    s.gold = ws.gold;
+    s.lastScene = ws.lastScene;
+    s.lastMineFloor = ws.lastMineFloor;
+    s.valid = true;
+    return s;
+}
+
+// 只读取存档开头：二进制存档解析摘要段，文本存档解析首行版本与第二行基础字段。
+// 压缩存档只解压出开头的摘要部分。
+static bool readSummaryFromFile(const std::string& path, SaveSummary& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    std::string prefix(kSummaryPrefixBytes, '\0');
+    in.read(&prefix[0], static_cast<std::streamsize>(prefix.size()));
+    prefix.resize(static_cast<std::size_t>(in.gcount()));
+    if (isCompressedSave(prefix)) {
+        in.clear();
+        in.seekg(static_cast<std::streamoff>(kCompressedSaveMagicLen + 1));
+        std::string head;
+        if (!inflateSaveStream(in, head, kSummaryPrefixBytes) && head.size() < kSummaryPrefixBytes) {
+            return false;
         }
+        prefix.swap(head);
+    }
+    if (isBinarySave(prefix)) {
+        return readBinarySummary(prefix, out);
     }
-    out << '\n';
-    out << ws.abyssElevatorFloors.size() << '\n';
-    for (int floor : ws.abyssElevatorFloors) {
-        out << floor << '\n';
-    }
-    writeInventory(out, ws.inventory);
-    writeChest(out, ws.globalChest);
-    writeDrops(out, ws.farmDrops);
-    writeFurnaces(out, ws.farmFurnaces);
-    writeFurnaces(out, ws.houseFurnaces);
-    writeFurnaces(out, ws.townFurnaces);
-    writeFurnaces(out, ws.beachFurnaces);
-    writeChests(out, ws.farmChests);
-    writeCrops(out, ws.farmCrops);
-    writeTreePositions(out, ws.farmTrees);
-    writeRockPositions(out, ws.farmRocks);
-    writeWeedPositions(out, ws.farmWeeds);
-    writeAnimals(out, ws.farmAnimals);
-    writeSkillTrees(out, ws.skillTrees);
-    writeChests(out, ws.houseChests);
-    writeChests(out, ws.townChests);
-    writeChests(out, ws.beachChests);
-    writeNpcData(out, ws);
+    std::istringstream text(prefix);
+    std::string magic;
+    int version = 0;
+    text >> magic >> version;
+    if (!text || magic != "SDV_SAVE" || version < 7 || version > 10) return false;
+    float timeAccum = 0.0f;
+    float lastX = 0.0f;
+    float lastY = 0.0f;
+    int skip = 0;
+    text >> out.seasonIndex >> out.dayOfSeason >> out.timeHour >> out.timeMinute >> timeAccum;
+    for (int i = 0; i < 4; ++i) text >> skip; // energy maxEnergy water maxWater
+    text >> out.gold;
+    for (int i = 0; i < 5; ++i) text >> skip; // hp maxHp selectedIndex granted fishing
+    text >> out.lastScene >> lastX >> lastY >> out.lastMineFloor;
+    if (!text) return false;
+    out.version = version;
     return true;
 }
 
-// 从文件中加载存档到全局 WorldState：
-// 1. 处理 fullPath（为空则使用默认路径），尝试打开输入文件；
-// 2. 读取并校验“魔数 + 版本号”，不符合期望则立即返回 false；
-// 3. 依次读取基础字段、农田格子、矿井电梯层数、背包、箱子、熔炉等；
-// 4. 根据 version 做向后兼容处理，例如老版本没有某些字段时给默认值。
-bool loadFromFile(const std::string& fullPath) {
-    std::string path = fullPath;
-    if (path.empty()) {
-        path = defaultSavePath();
-    }
-    std::ifstream in(path);
-    if (!in) return false;
-    g_currentSavePath = path;
+// 索引文件格式（文本）：
+//   SDV_SAVE_INDEX 1
+//   count
+//   size mtime valid version season day hour minute gold scene mineFloor   （每个存档两行，第二行为文件名）
+//   name
+static std::unordered_map<std::string, SaveIndexEntry> readSaveIndex(const std::string& indexPath) {
+    std::unordered_map<std::string, SaveIndexEntry> entries;
+    std::ifstream in(indexPath);
+    if (!in) return entries;
     std::string magic;
     int version = 0;
-    in >> magic >> version;
-    in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-    if (!in || magic != "SDV_SAVE" || version < 7 || version > 10) {
+    std::size_t count = 0;
+    in >> magic >> version >> count;
+    if (!in || magic != "SDV_SAVE_INDEX" || version != 1) return entries;
+    for (std::size_t i = 0; i < count; ++i) {
+        SaveIndexEntry e;
+        int valid = 0;
+        auto& sm = e.summary;
+        in >> e.size >> e.mtime >> valid >> sm.version >> sm.seasonIndex >> sm.dayOfSeason
+           >> sm.timeHour >> sm.timeMinute >> sm.gold >> sm.lastScene >> sm.lastMineFloor;
+        in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        std::getline(in, sm.name);
+        if (!in) break;
+        sm.valid = (valid != 0);
+        entries[sm.name] = e;
+    }
+    return entries;
+}
+
+// 与存档相同，经临时文件原子替换写出：中途失败时旧索引保持完整（调用方持有 g_saveIndexMutex）。
+static void writeSaveIndex(const std::string& indexPath, const std::vector<SaveIndexEntry>& entries) {
+    std::string tmpPath = indexPath + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::trunc);
+        if (!out) return;
+        out << "SDV_SAVE_INDEX 1" << '\n' << entries.size() << '\n';
+        for (const auto& e : entries) {
+            const auto& sm = e.summary;
+            out << e.size << ' ' << e.mtime << ' ' << (sm.valid ? 1 : 0) << ' ' << sm.version << ' '
+                << sm.seasonIndex << ' ' << sm.dayOfSeason << ' ' << sm.timeHour << ' ' << sm.timeMinute << ' '
+                << sm.gold << ' ' << sm.lastScene << ' ' << sm.lastMineFloor << '\n'
+                << sm.name << '\n';
+        }
+        out.close();
+        if (!out) {
+            std::remove(tmpPath.c_str());
+            return;
+        }
+    }
+    if (!replaceFile(tmpPath, indexPath)) std::remove(tmpPath.c_str());
+}
+
+// 存档写盘成功后刷新索引中对应条目（可能在后台 IO 线程调用）。
+static void updateSaveIndex(const std::string& savePath, const WorldState& ws) {
+    std::string dir = savePath.substr(0, savePath.size() - fileNameOf(savePath).size());
+    if (dir.empty()) return;
+    std::string indexPath = dir + kSaveIndexFileName;
+    SaveIndexEntry e;
+    if (!fileStamp(savePath, e.size, e.mtime)) return;
+    e.summary = summaryOf(ws);
+    e.summary.name = fileNameOf(savePath);
+    std::lock_guard<std::mutex> lock(g_saveIndexMutex);
+    auto cached = readSaveIndex(indexPath);
+    cached[e.summary.name] = e;
+    std::vector<SaveIndexEntry> entries;
+    entries.reserve(cached.size());
+    for (auto& kv : cached) entries.push_back(kv.second);
+    writeSaveIndex(indexPath, entries);
+}
+
+static std::string journalPathFor(const std::string& path) {
+    return path + ".journal";
+}
+
+static std::uint64_t newSnapshotId() {
+    static std::mt19937_64 rng{ std::random_device{}() };
+    std::uint64_t id = 0;
+    while (id == 0) id = rng();
+    return id;
+}
+
+// 把一份 WorldState 编码写入 path：先写 path.tmp，关闭后再替换为正式文件。
+// 快照带有新的快照 id，替换成功后删除旧日志，并以本次内容重置增量存档状态。
+static bool writeSaveFile(const WorldState& ws, const std::string& path) {
+    SaveSections sections = encodeSaveSections(ws);
+    std::uint64_t snapshotId = 0;
+    {
+        std::lock_guard<std::mutex> lock(g_journalMutex);
+        snapshotId = newSnapshotId();
+    }
+    sections.emplace_back(static_cast<std::uint32_t>(SectionSnapshotId), BinWriter());
+    sections.back().second.u64(snapshotId);
+    std::string tmpPath = path + ".tmp";
+    // 增量日志的压缩阈值按未压缩大小比较
+    std::uint64_t bytes = kBinarySaveMagicLen + 4 + kSectionEntrySize * sections.size();
+    for (const auto& sec : sections) bytes += sec.second.size();
+    bool written = false;
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (out) {
+            if (static_cast<SaveCodec>(g_saveCodec.load()) == SaveCodec::Zlib) {
+                out.write(kCompressedSaveMagic, static_cast<std::streamsize>(kCompressedSaveMagicLen));
+                out.put(static_cast<char>(kSaveCodecZlib));
+                DeflateStreamBuf deflater(out, g_saveCompressionLevel.load());
+                std::ostream zout(&deflater);
+                written = writeBinarySave(zout, sections) && deflater.finish();
+            } else {
+                written = writeBinarySave(out, sections);
+            }
+            out.close();
+            written = written && static_cast<bool>(out);
+        }
+    }
+    if (!written || !replaceFile(tmpPath, path)) {
+        std::remove(tmpPath.c_str());
+        std::lock_guard<std::mutex> lock(g_journalMutex);
+        if (g_journal.path == path) g_journal = JournalState();
         return false;
     }
+    std::remove(journalPathFor(path).c_str());
+    {
+        std::lock_guard<std::mutex> lock(g_journalMutex);
+        g_journal = JournalState();
+        g_journal.path = path;
+        g_journal.snapshotId = snapshotId;
+        for (const auto& sec : sections) {
+            if (sec.first == SectionSnapshotId) continue;
+            g_journal.hashes[sec.first] = fnv1a64(sec.second.buffer().data(), sec.second.size());
+        }
+        g_journal.tilesRevision = ws.farmTiles.revision();
+        g_journal.tilesCols = ws.farmTiles.cols();
+        g_journal.tilesRows = ws.farmTiles.rows();
+        g_journal.snapshotBytes = bytes;
+    }
+    updateSaveIndex(path, ws);
+    return true;
+}
+
+// 向 path 的日志追加自上次落盘以来变化的段；没有可追加的快照、日志过大或写入失败时返回 false，
+// 由调用方改写完整快照。changed 为 false 表示没有变化的段，磁盘内容未动。
+static bool appendCheckpoint(WorldState& ws, const std::string& path, bool& changed) {
+    changed = false;
+    std::lock_guard<std::mutex> lock(g_journalMutex);
+    JournalState& st = g_journal;
+    if (st.path != path || st.snapshotId == 0) return false;
+    SaveSections sections = encodeSaveSections(ws);
+    SaveSections records;
+    std::vector<std::uint64_t> recordHashes;
+    for (auto& sec : sections) {
+        if (sec.first == SectionTiles) continue;
+        std::uint64_t h = fnv1a64(sec.second.buffer().data(), sec.second.size());
+        auto it = st.hashes.find(sec.first);
+        if (it != st.hashes.end() && it->second == h) continue;
+        records.emplace_back(sec.first, std::move(sec.second));
+        recordHashes.push_back(h);
+    }
+    const TileGrid& grid = ws.farmTiles;
+    if (grid.revision() != st.tilesRevision) {
+        // 自上次落盘以来的每次改动都在变更日志中（未溢出、未整体重置）时只写增量
+        bool deltaOnly = !grid.journalOverflowed() &&
+                         grid.cols() == st.tilesCols && grid.rows() == st.tilesRows &&
+                         grid.revision() - st.tilesRevision == grid.journal().size();
+        BinWriter w;
+        if (deltaOnly) binWriteTileDelta(w, grid);
+        else binWriteTiles(w, grid);
+        recordHashes.push_back(fnv1a64(w.buffer().data(), w.size()));
+        records.emplace_back(static_cast<std::uint32_t>(deltaOnly ? SectionTileDelta : SectionTiles), std::move(w));
+    }
+    if (records.empty()) return true;
+
+    std::uint64_t recordBytes = 0;
+    for (const auto& rec : records) recordBytes += kJournalRecordHeaderSize + rec.second.size();
+    std::uint64_t limit = std::max(st.snapshotBytes, kJournalCompactMinBytes);
+    if (st.journalBytes + recordBytes > limit) return false;
+
+    std::string journalPath = journalPathFor(path);
+    std::ofstream out(journalPath, std::ios::binary | (st.journalBytes == 0 ? std::ios::trunc : std::ios::app));
+    if (!out) return false;
+    bool ok = true;
+    if (st.journalBytes == 0) {
+        ok = writeJournalHeader(out, st.snapshotId);
+        st.journalBytes = kJournalHeaderSize;
+    }
+    for (std::size_t i = 0; ok && i < records.size(); ++i) {
+        ok = writeJournalRecord(out, records[i].first, records[i].second, recordHashes[i]);
+    }
+    out.close();
+    if (!ok || !out) {
+        // 日志尾部可能残留半条记录：作废状态，改写完整快照
+        st = JournalState();
+        return false;
+    }
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        if (records[i].first == SectionTileDelta) continue;
+        st.hashes[records[i].first] = recordHashes[i];
+    }
+    st.tilesRevision = grid.revision();
+    st.tilesCols = grid.cols();
+    st.tilesRows = grid.rows();
+    st.journalBytes += recordBytes;
+    ws.farmTiles.clearJournal();
+    changed = true;
+    return true;
+}
+
+static std::shared_ptr<ToolBase> cloneTool(const ToolBase* tool) {
+    if (!tool) return nullptr;
+    auto copy = makeTool(tool->kind());
+    if (copy) {
+        copy->setLevel(tool->level());
+    }
+    return copy;
+}
+
+static void cloneSlotTools(std::vector<Slot>& slots) {
+    for (auto& s : slots) {
+        if (s.tool) s.tool = cloneTool(s.tool.get());
+    }
+}
+
+static void cloneChestTools(std::vector<Chest>& chests) {
+    for (auto& ch : chests) {
+        cloneSlotTools(ch.slots);
+    }
+}
+
+// 为后台存档拷贝一份与主线程完全不共享可变对象的快照：
+// WorldState 按值拷贝后，背包与所有箱子中的工具（shared_ptr）也替换为独立副本。
+static std::shared_ptr<WorldState> snapshotForSave(const WorldState& ws) {
+    auto snap = std::make_shared<WorldState>(ws);
+    if (ws.inventory) {
+        snap->inventory = std::make_shared<Inventory>(*ws.inventory);
+        for (std::size_t i = 0; i < snap->inventory->size(); ++i) {
+            if (const ToolBase* t = ws.inventory->toolAt(i)) {
+                snap->inventory->setTool(i, cloneTool(t));
+            }
+        }
+    }
+    cloneSlotTools(snap->globalChest.slots);
+    cloneChestTools(snap->farmChests);
+    cloneChestTools(snap->houseChests);
+    cloneChestTools(snap->townChests);
+    cloneChestTools(snap->beachChests);
+    return snap;
+}
+
+void waitForPendingSaves() {
+    std::unique_lock<std::mutex> lock(g_pendingSaveMutex);
+    g_pendingSaveCv.wait(lock, [] { return g_pendingSaves == 0; });
+}
+
+std::vector<SaveSummary> listSaveSummaries() {
+    std::string dir = saveDirectory();
+    std::string indexPath = dir + kSaveIndexFileName;
+    std::lock_guard<std::mutex> lock(g_saveIndexMutex);
+    auto cached = readSaveIndex(indexPath);
+    std::vector<SaveIndexEntry> entries;
+    bool dirty = false;
+    for (const auto& p : FileUtils::getInstance()->listFiles(dir)) {
+        if (!hasTxtExtension(p)) continue;
+        SaveIndexEntry e;
+        if (!fileStamp(p, e.size, e.mtime)) continue;
+        std::string name = fileNameOf(p);
+        auto it = cached.find(name);
+        if (it != cached.end() && it->second.size == e.size && it->second.mtime == e.mtime) {
+            e.summary = it->second.summary;
+        } else {
+            e.summary.valid = readSummaryFromFile(p, e.summary);
+            dirty = true;
+        }
+        e.summary.name = name;
+        e.summary.path = p;
+        entries.push_back(e);
+    }
+    if (entries.size() != cached.size()) dirty = true;
+    std::sort(entries.begin(), entries.end(), [](const SaveIndexEntry& a, const SaveIndexEntry& b) {
+        return a.summary.name < b.summary.name;
+    });
+    if (dirty) writeSaveIndex(indexPath, entries);
+    std::vector<SaveSummary> result;
+    result.reserve(entries.size());
+    for (const auto& e : entries) result.push_back(e.summary);
+    return result;
+}
+
+// 核心函数：把当前全局 WorldState 序列化到指定文件。
+// 主要流程：
+// 1. 等待尚未完成的后台存档，避免同时写同一个临时文件；
+// 2. 处理 fullPath（为空则使用 defaultSavePath），并确保目录存在；
+// 3. 利用 SaveBinary.h 编码（SDV_SAVE 11 格式），按压缩设置边写边压缩，经临时文件原子替换写出；
+// 4. 删除该存档的增量日志（快照已包含其全部内容）。
+bool saveToFile(const std::string& fullPath) {
+    waitForPendingSaves();
+    std::string path = resolveSavePath(fullPath);
+    g_currentSavePath = path;
     auto& ws = globalState();
-    ws = WorldState();
+    FurnaceScheduler::getInstance().syncToWorld();
+    if (!writeSaveFile(ws, path)) return false;
+    // 瓦片日志记录“自上次存档以来”的改动，落盘后清空
+    ws.farmTiles.clearJournal();
+    return true;
+}
+
+void saveCheckpoint(const std::string& fullPath) {
+    std::string path = resolveSavePath(fullPath);
+    {
+        std::lock_guard<std::mutex> lock(g_pendingSaveMutex);
+        // 已有后台存档在排队或写盘时不等待：它的快照已包含提交前的改动，之后的改动由下一次检查点追加
+        if (g_pendingSaves > 0) return;
+        ++g_pendingSaves;
+    }
+    g_currentSavePath = path;
+    auto& ws = globalState();
+    FurnaceScheduler::getInstance().syncToWorld();
+    auto snap = snapshotForSave(ws);
+    // 与 saveToFileAsync 相同：快照带走了瓦片日志，提交时即清空
+    ws.farmTiles.clearJournal();
+    // 编码、比较哈希与写盘都在 IO 线程上进行，与后台存档共用同一队列，按提交顺序执行
+    AsyncTaskPool::getInstance()->enqueue(
+        AsyncTaskPool::TaskType::TASK_IO,
+        [snap, path]() mutable {
+            bool changed = false;
+            if (!appendCheckpoint(*snap, path, changed)) {
+                writeSaveFile(*snap, path);
+            } else if (changed) {
+                updateSaveIndex(path, *snap);
+            }
+            snap.reset();
+            {
+                std::lock_guard<std::mutex> lock(g_pendingSaveMutex);
+                --g_pendingSaves;
+            }
+            g_pendingSaveCv.notify_all();
+        });
+}
+
+void saveToFileAsync(const std::string& fullPath, SaveCallback onDone) {
+    std::string path = resolveSavePath(fullPath);
+    g_currentSavePath = path;
+    auto& ws = globalState();
+    FurnaceScheduler::getInstance().syncToWorld();
+    auto snap = snapshotForSave(ws);
+    // 快照已包含全部改动，日志在提交时即清空
+    ws.farmTiles.clearJournal();
+    {
+        std::lock_guard<std::mutex> lock(g_pendingSaveMutex);
+        ++g_pendingSaves;
+    }
+    auto ok = std::make_shared<bool>(false);
+    AsyncTaskPool::getInstance()->enqueue(
+        AsyncTaskPool::TaskType::TASK_IO,
+        [ok, path, onDone](void*) {
+            if (onDone) onDone(*ok, path);
+        },
+        nullptr,
+        [snap, ok, path]() mutable {
+            *ok = writeSaveFile(*snap, path);
+            snap.reset();
+            {
+                std::lock_guard<std::mutex> lock(g_pendingSaveMutex);
+                --g_pendingSaves;
+            }
+            g_pendingSaveCv.notify_all();
+        });
+}
+
+// 解析 7~10 版本的文本存档（首行“魔数 + 版本号”已由调用方读取并校验）。
+// 根据 version 做向后兼容处理，例如老版本没有某些字段时给默认值。
+static bool loadTextSave(std::istream& in, int version, WorldState& ws) {
     int granted = 0;
     int fishing = 0;
     int raining = 0;
@@ -336,23 +771,25 @@ bool loadFromFile(const std::string& fullPath) {
         ws.weatherSeasonIndex = -1;
         ws.weatherDayOfSeason = -1;
     }
-    in >> ws.farmCols >> ws.farmRows;
+    int farmCols = 0;
+    int farmRows = 0;
+    in >> farmCols >> farmRows;
     in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
     std::size_t tilesCount = 0;
     in >> tilesCount;
     in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-    ws.farmTiles.clear();
+    std::vector<TileType> farmTiles;
     std::vector<long long> legacyRockTiles;
     std::vector<long long> legacyTreeTiles;
     if (tilesCount > 0) {
-        ws.farmTiles.resize(tilesCount);
+        farmTiles.resize(tilesCount);
         for (std::size_t i = 0; i < tilesCount; ++i) {
             int v = 0;
             in >> v;
-            ws.farmTiles[i] = tileFromInt(v);
-            if (ws.farmCols > 0) {
-                int c = static_cast<int>(i % static_cast<std::size_t>(ws.farmCols));
-                int r = static_cast<int>(i / static_cast<std::size_t>(ws.farmCols));
+            farmTiles[i] = tileFromInt(v);
+            if (farmCols > 0) {
+                int c = static_cast<int>(i % static_cast<std::size_t>(farmCols));
+                int r = static_cast<int>(i / static_cast<std::size_t>(farmCols));
                 long long key = (static_cast<long long>(r) << 32) | static_cast<unsigned long long>(c);
                 if (v == 3) legacyRockTiles.push_back(key);
                 if (v == 4) legacyTreeTiles.push_back(key);
@@ -360,6 +797,7 @@ bool loadFromFile(const std::string& fullPath) {
         }
         in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
     }
+    ws.farmTiles.assign(farmCols, farmRows, std::move(farmTiles));
     std::size_t elevatorCount = 0;
     in >> elevatorCount;
     in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
@@ -441,4 +879,89 @@ bool loadFromFile(const std::string& fullPath) {
     return static_cast<bool>(in);
 }
 
+// 把存档内容整块读入 data；压缩存档（首行 "SDV_SAVEZ"）边读边解压，得到内部的二进制存档。
+static bool readSaveData(const std::string& path, std::string& data) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    std::string head(kCompressedSaveMagicLen + 1, '\0');
+    file.read(&head[0], static_cast<std::streamsize>(head.size()));
+    head.resize(static_cast<std::size_t>(file.gcount()));
+    if (isCompressedSave(head)) {
+        if (static_cast<std::uint8_t>(head.back()) != kSaveCodecZlib) return false;
+        return inflateSaveStream(file, data, std::numeric_limits<std::size_t>::max());
+    }
+    data = head;
+    data.append(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+// 从文件中加载存档到全局 WorldState：
+// 1. 处理 fullPath（为空则使用默认路径），把整个文件一次性读入内存；
+// 2. 首行为 "SDV_SAVEZ" 时先解压；内容首行为 "SDV_SAVE 11" 时按二进制段表直接在缓冲区上解码，
+//    再回放同名 .journal 增量日志；
+// 3. 否则按文本存档解析，校验“魔数 + 版本号”（支持 7~10），不符合期望则返回 false。
+// 读入成功后重建农场障碍物占用层，并按各熔炉的剩余时间重新挂到 FurnaceScheduler。
+bool loadFromFile(const std::string& fullPath) {
+    std::string path = fullPath;
+    if (path.empty()) {
+        path = defaultSavePath();
+    }
+    waitForPendingSaves();
+    std::string data;
+    if (!readSaveData(path, data)) return false;
+    g_currentSavePath = path;
+    auto& ws = globalState();
+    {
+        std::lock_guard<std::mutex> lock(g_journalMutex);
+        g_journal = JournalState();
+    }
+    if (isBinarySave(data)) {
+        ws = WorldState();
+        SaveSectionInfo info;
+        if (!readBinarySave(data, ws, &info)) return false;
+        JournalState st;
+        st.path = path;
+        st.snapshotId = info.snapshotId;
+        st.hashes = std::move(info.hashes);
+        st.snapshotBytes = data.size();
+        bool usable = (info.snapshotId != 0);
+        std::ifstream journalFile(journalPathFor(path), std::ios::binary);
+        if (journalFile) {
+            std::string journal((std::istreambuf_iterator<char>(journalFile)), std::istreambuf_iterator<char>());
+            std::size_t validBytes = 0;
+            // 快照 id 不符（例如新快照替换后、删除旧日志前崩溃）的日志整份忽略；
+            // 尾部损坏时保留已回放的内容。两种情况下次 checkpoint 都改写完整快照。
+            if (!replayJournal(journal, info.snapshotId, ws, st.hashes, validBytes) ||
+                validBytes != journal.size()) {
+                usable = false;
+            }
+            st.journalBytes = journal.size();
+        }
+        ws.farmTiles.clearJournal();
+        st.tilesRevision = ws.farmTiles.revision();
+        st.tilesCols = ws.farmTiles.cols();
+        st.tilesRows = ws.farmTiles.rows();
+        if (usable) {
+            std::lock_guard<std::mutex> lock(g_journalMutex);
+            g_journal = std::move(st);
+        }
+        syncFarmBlockers(ws);
+        FurnaceScheduler::getInstance().rebuild();
+        return true;
+    }
+    std::istringstream in(data);
+    std::string magic;
+    int version = 0;
+    in >> magic >> version;
+    in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    if (!in || magic != "SDV_SAVE" || version < 7 || version > 10) {
+        return false;
+    }
+    ws = WorldState();
+    if (!loadTextSave(in, version, ws)) return false;
+    syncFarmBlockers(ws);
+    FurnaceScheduler::getInstance().rebuild();
+    return true;
+}
+
 } // namespace Game
@@ -1,19 +1,50 @@
 #pragma once
 
 #include <string>
+#include <vector>
+#include <functional>
 
 namespace Game {
 
-// 保存当前全局游戏状态到指定路径的文本文件中。
+// 保存当前全局游戏状态到指定路径（二进制 SDV_SAVE 11 格式，见 SaveBinary.h）。
 // - fullPath 为空字符串时，使用 defaultSavePath() 指定的默认存档路径。
 // - 返回值为 true 表示保存成功，false 表示文件创建或写入失败。
 bool saveToFile(const std::string& fullPath);
 
-// 从指定路径的文本文件中加载游戏存档到全局状态 WorldState。
+// 后台存档完成回调：在主线程调用；ok 为 true 表示已写入并替换到 path。
+using SaveCallback = std::function<void(bool ok, const std::string& path)>;
+
+// 后台存档（用于每日结束时的自动存档）：
+// - 在调用线程上拷贝一份 WorldState 快照（工具实例一并复制），立即返回；
+// - 在 IO 工作线程上编码并写入临时文件，再原子替换为目标文件；
+// - 完成后通过 onDone 在主线程报告结果。多次调用按提交顺序依次写盘。
+void saveToFileAsync(const std::string& fullPath, SaveCallback onDone = nullptr);
+
+// 增量存档（用于切换场景等频繁的检查点）：
+// - 只把自上次落盘以来发生变化的段追加到存档旁的 .journal 日志，农场瓦片只记录改动的格子；
+// - 尚无可追加的快照（新游戏、旧格式存档）、日志已超过快照大小或追加失败时，改写完整快照；
+// - saveToFile/saveToFileAsync 写出完整快照后删除日志，loadFromFile 读快照后回放日志；
+// - 与 saveToFileAsync 一样只在调用线程上拷贝快照，编码与写盘在 IO 工作线程上进行；
+// - 已有后台存档未完成时直接跳过（不阻塞），其后的改动由下一次检查点追加。
+void saveCheckpoint(const std::string& fullPath);
+
+// 阻塞等待所有已提交的后台存档写盘完成；saveToFile/loadFromFile 内部会先调用。
+void waitForPendingSaves();
+
+// 从指定路径加载游戏存档到全局状态 WorldState（支持二进制 11 版与文本 7~10 版）。
 // - fullPath 为空字符串时，同样使用 defaultSavePath()；
 // - 返回值为 true 表示读取并解析成功，false 表示文件打不开或格式/版本不匹配。
 bool loadFromFile(const std::string& fullPath);
 
+// 存档压缩方式：只影响写入；读档时按文件头自动识别压缩与否。
+enum class SaveCodec {
+    None = 0,
+    Zlib = 1
+};
+
+// 设置完整快照的压缩方式与等级（zlib 1~9，越大文件越小、写入越慢）；增量日志不压缩。
+void setSaveCompression(SaveCodec codec, int level);
+
 // 设置自定义的存档根目录（例如 “save” 或绝对路径），用于覆盖默认的写入目录。
 // 实际使用时会通过 FileUtils 把相对路径转换成绝对路径。
 void setSaveRootDirectory(const std::string& rootDir);
@@ -41,4 +72,25 @@ std::string defaultSavePath();
 // 根据槽位编号生成对应的存档路径（save1.txt ~ save50.txt）。
 std::string savePathForSlot(int slot);
 
+// SaveSummary：读档菜单展示用的存档摘要，不包含任何世界数据。
+// - valid 为 false 表示文件无法识别（仍会列出文件名）。
+struct SaveSummary {
+    std::string path;
+    std::string name;
+    int version = 0;
+    int seasonIndex = 0;
+    int dayOfSeason = 1;
+    int timeHour = 6;
+    int timeMinute = 0;
+    long long gold = 0;
+    int lastScene = 0;
+    int lastMineFloor = 0;
+    bool valid = false;
+};
+
+// 列出 saveDirectory() 下全部存档的摘要（按文件名排序），不会修改 globalState()：
+// - 摘要缓存在存档目录的索引文件中，以文件大小与修改时间判断是否过期；
+// - 只有新增或被改动的存档才会重新读取其文件头（二进制存档的摘要段 / 文本存档的前两行）。
+std::vector<SaveSummary> listSaveSummaries();
+
 } // namespace Game
@@ -254,14 +254,17 @@ int SkillTreeSystem::xpForFishingCatch(int fishQty) const {
     return 12 + qty * 2;
 }
 
-int SkillTreeSystem::adjustAnimalProductQuantityForHusbandry(Game::ItemType, int baseQty) const {
+int SkillTreeSystem::adjustAnimalProductQuantityForHusbandry(Game::ItemType product, int baseQty) const {
+    static std::mt19937 rng{ std::random_device{}() };
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    return adjustAnimalProductQuantityForHusbandry(product, baseQty, dist(rng));
+}
+
+int SkillTreeSystem::adjustAnimalProductQuantityForHusbandry(Game::ItemType, int baseQty, float roll) const {
     if (baseQty <= 0) return baseQty;
     float chance = husbandryExtraProductChance();
     if (chance <= 0.0001f) return baseQty;
 
-    static std::mt19937 rng{ std::random_device{}() };
-    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
-    float roll = dist(rng);
     if (roll < chance) {
         return baseQty + 1;
     }
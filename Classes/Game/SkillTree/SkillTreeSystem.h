@@ -49,6 +49,8 @@ public:
 
     // 养殖加成：动物产物生成时根据技能树概率额外 +1 产物数量。
     int adjustAnimalProductQuantityForHusbandry(Game::ItemType product, int baseQty) const;
+    // 同上，但由调用方提供 [0,1) 的随机数（夜间结算使用当日随机流，结果可复现）。
+    int adjustAnimalProductQuantityForHusbandry(Game::ItemType product, int baseQty, float roll) const;
     // 养殖经验：一次动物产物生成应获得的经验。
     int xpForAnimalProduct(Game::ItemType product, int qty) const;
 
@@ -0,0 +1,100 @@
+#include "Game/TileGrid.h"
+
+namespace Game {
+
+void TileGrid::reset(int cols, int rows, TileType fill) {
+    _cols = cols > 0 ? cols : 0;
+    _rows = rows > 0 ? rows : 0;
+    _tiles.assign(static_cast<std::size_t>(_cols) * static_cast<std::size_t>(_rows), fill);
+    clearJournal();
+    resetBlockers();
+    ++_revision;
+}
+
+void TileGrid::assign(int cols, int rows, std::vector<TileType> tiles) {
+    _cols = cols > 0 ? cols : 0;
+    _rows = rows > 0 ? rows : 0;
+    _tiles = std::move(tiles);
+    clearJournal();
+    resetBlockers();
+    ++_revision;
+}
+
+TileType TileGrid::get(int c, int r) const {
+    if (!inBounds(c, r)) return TileType::NotSoil;
+    std::size_t idx = static_cast<std::size_t>(r) * static_cast<std::size_t>(_cols) + static_cast<std::size_t>(c);
+    if (idx >= _tiles.size()) return TileType::NotSoil;
+    return _tiles[idx];
+}
+
+bool TileGrid::set(int c, int r, TileType t) {
+    if (!inBounds(c, r)) return false;
+    return setAt(static_cast<std::size_t>(r) * static_cast<std::size_t>(_cols) + static_cast<std::size_t>(c), t);
+}
+
+bool TileGrid::setAt(std::size_t idx, TileType t) {
+    if (idx >= _tiles.size() || _tiles[idx] == t) return false;
+    _tiles[idx] = t;
+    refreshFree(idx);
+    ++_revision;
+    if (!_journalOverflow) {
+        if (_journal.size() >= _tiles.size()) {
+            _journalOverflow = true;
+            _journal.clear();
+        } else {
+            _journal.push_back(static_cast<int>(idx));
+        }
+    }
+    return true;
+}
+
+void TileGrid::clearJournal() {
+    _journal.clear();
+    _journalOverflow = false;
+}
+
+void TileGrid::addBlocker(int c, int r) {
+    ++_blockerTotal;
+    if (!inBounds(c, r)) return;
+    std::size_t idx = static_cast<std::size_t>(r) * static_cast<std::size_t>(_cols) + static_cast<std::size_t>(c);
+    if (idx >= _blockers.size()) return;
+    if (_blockers[idx]++ == 0) _freeSoil.erase(static_cast<int>(idx));
+}
+
+void TileGrid::removeBlocker(int c, int r) {
+    if (_blockerTotal > 0) --_blockerTotal;
+    if (!inBounds(c, r)) return;
+    std::size_t idx = static_cast<std::size_t>(r) * static_cast<std::size_t>(_cols) + static_cast<std::size_t>(c);
+    if (idx >= _blockers.size() || _blockers[idx] == 0) return;
+    if (--_blockers[idx] == 0) refreshFree(idx);
+}
+
+void TileGrid::clearBlockers() {
+    resetBlockers();
+}
+
+bool TileGrid::blocked(int c, int r) const {
+    if (!inBounds(c, r)) return false;
+    std::size_t idx = static_cast<std::size_t>(r) * static_cast<std::size_t>(_cols) + static_cast<std::size_t>(c);
+    return idx < _blockers.size() && _blockers[idx] > 0;
+}
+
+void TileGrid::refreshFree(std::size_t idx) {
+    if (idx < _blockers.size() && _blockers[idx] == 0 && _tiles[idx] == TileType::Soil) {
+        _freeSoil.insert(static_cast<int>(idx));
+    } else {
+        _freeSoil.erase(static_cast<int>(idx));
+    }
+}
+
+// 清空占用层并按当前瓦片重建空闲集合（O(格子数)，只在整体替换网格或重建占用时调用）。
+void TileGrid::resetBlockers() {
+    _blockers.assign(_tiles.size(), 0);
+    _blockerTotal = 0;
+    _freeSoil.reset(_tiles.size());
+    for (std::size_t idx = 0; idx < _tiles.size(); ++idx) {
+        if (_tiles[idx] == TileType::Soil) _freeSoil.insert(static_cast<int>(idx));
+    }
+}
+
+} // namespace Game
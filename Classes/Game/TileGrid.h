@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "Game/FreeTileSet.h"
+#include "Game/Tile.h"
+
+namespace Game {
+
+// TileGrid：农场瓦片网格的唯一存储（按行主序 r*cols + c）。
+// - WorldState 持有实例；FarmMapController / CropSystem / 存档系统直接读写同一份数据，
+//   不再在控制器与全局状态之间整表拷贝。
+// - 变更日志：记录自上次 clearJournal() 以来被修改过的瓦片下标，供存档等增量消费；
+//   日志长度超过格子总数时视为“全量变化”，不再逐条记录。
+// - 障碍物占用层：树/石头/杂草所在格子的计数（存档不保存，读档与进入农场后由 syncFarmBlockers 重建），
+//   与瓦片类型一起增量维护“空闲土壤”集合（Soil 且无障碍物），夜间障碍物再生直接从中抽取。
+//   作物只种在耕地上，耕地不属于 Soil，因此作物无需单独登记。
+class TileGrid {
+public:
+    // 重置为 cols x rows，全部填充为 fill（清空日志）。
+    void reset(int cols, int rows, TileType fill);
+    // 以现成数据整体替换（用于读档；清空日志）。
+    void assign(int cols, int rows, std::vector<TileType> tiles);
+
+    int cols() const { return _cols; }
+    int rows() const { return _rows; }
+    bool empty() const { return _tiles.empty(); }
+    std::size_t size() const { return _tiles.size(); }
+    bool inBounds(int c, int r) const { return c >= 0 && r >= 0 && c < _cols && r < _rows; }
+
+    TileType at(std::size_t idx) const { return _tiles[idx]; }
+    // 越界返回 NotSoil。
+    TileType get(int c, int r) const;
+    const std::vector<TileType>& data() const { return _tiles; }
+
+    // 写入瓦片；值发生变化时记录日志并返回 true。
+    bool set(int c, int r, TileType t);
+    bool setAt(std::size_t idx, TileType t);
+
+    // 每次写入变化自增，供调用方判断网格是否被改动。
+    unsigned long long revision() const { return _revision; }
+    const std::vector<int>& journal() const { return _journal; }
+    bool journalOverflowed() const { return _journalOverflow; }
+    void clearJournal();
+
+    // 登记/注销一个障碍物（同一格可叠放多个）；越界坐标只计入总数。
+    void addBlocker(int c, int r);
+    void removeBlocker(int c, int r);
+    void clearBlockers();
+    bool blocked(int c, int r) const;
+    // 已登记的障碍物总数：与 WorldState 中障碍物列表的总长度不一致时说明需要重建。
+    std::size_t blockerCount() const { return _blockerTotal; }
+    // 空闲土壤格子（下标按行主序）。
+    const FreeTileSet& freeSoil() const { return _freeSoil; }
+
+private:
+    void refreshFree(std::size_t idx);
+    void resetBlockers();
+
+    int _cols = 0;
+    int _rows = 0;
+    std::vector<TileType> _tiles;
+    std::vector<int> _journal;
+    bool _journalOverflow = false;
+    unsigned long long _revision = 0;
+    std::vector<int> _blockers;
+    std::size_t _blockerTotal = 0;
+    FreeTileSet _freeSoil;
+};
+
+} // namespace Game
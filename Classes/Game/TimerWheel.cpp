@@ -0,0 +1,116 @@
+#include "Game/TimerWheel.h"
+
+namespace Game {
+
+namespace {
+
+std::uint64_t levelSpan(int level) {
+    return std::uint64_t(1) << (TimerWheel::kSlotBits * level);
+}
+
+std::size_t slotIndex(std::uint64_t tick, int level) {
+    return static_cast<std::size_t>((tick >> (TimerWheel::kSlotBits * level)) & (TimerWheel::kSlots - 1));
+}
+
+}
+
+void TimerWheel::schedule(std::uint64_t id, std::uint64_t dueTick) {
+    auto it = _due.find(id);
+    if (it != _due.end() && it->second == dueTick) return;
+    _due[id] = dueTick;
+    if (dueTick <= _now) {
+        _expired.push_back(Entry{ id, dueTick });
+    } else {
+        insert(Entry{ id, dueTick });
+    }
+}
+
+bool TimerWheel::cancel(std::uint64_t id) {
+    return _due.erase(id) > 0;
+}
+
+bool TimerWheel::dueTick(std::uint64_t id, std::uint64_t& out) const {
+    auto it = _due.find(id);
+    if (it == _due.end()) return false;
+    out = it->second;
+    return true;
+}
+
+void TimerWheel::advance(std::uint64_t ticks, std::vector<std::uint64_t>& fired) {
+    if (!_expired.empty()) {
+        std::vector<Entry> due;
+        due.swap(_expired);
+        for (const auto& e : due) {
+            if (!isLive(e)) continue;
+            _due.erase(e.id);
+            fired.push_back(e.id);
+        }
+    }
+    while (ticks > 0 && !_due.empty()) {
+        tick(fired);
+        --ticks;
+    }
+    _now += ticks;
+}
+
+void TimerWheel::clear() {
+    for (auto& level : _slots) {
+        for (auto& slot : level) slot.clear();
+    }
+    _overflow.clear();
+    _expired.clear();
+    _due.clear();
+}
+
+bool TimerWheel::isLive(const Entry& e) const {
+    auto it = _due.find(e.id);
+    return it != _due.end() && it->second == e.due;
+}
+
+// 按距离当前时刻的远近选层：距离 < 64^(l+1) 的放在第 l 层，槽号取触发时刻在该层的位。
+// 这样第 l 层的槽在时钟到达“触发时刻向下取整到 64^l”时被首次访问，不会早于或晚于一轮。
+// 下放时 due 可能恰好等于当前时刻，此时落入第 0 层当前槽，在同一刻内触发。
+void TimerWheel::insert(const Entry& e) {
+    std::uint64_t delta = e.due - _now;
+    for (int l = 0; l < kLevels; ++l) {
+        if (delta < levelSpan(l + 1)) {
+            _slots[l][slotIndex(e.due, l)].push_back(e);
+            return;
+        }
+    }
+    _overflow.push_back(e);
+}
+
+void TimerWheel::cascade(std::vector<Entry>& bucket) {
+    if (bucket.empty()) return;
+    std::vector<Entry> moving;
+    moving.swap(bucket);
+    for (const auto& e : moving) {
+        if (isLive(e)) insert(e);
+    }
+}
+
+void TimerWheel::tick(std::vector<std::uint64_t>& fired) {
+    ++_now;
+    // 从高层往低层下放：高层下放的条目可能落入本刻同样要下放的低层槽
+    int top = 0;
+    while (top < kLevels && (_now & (levelSpan(top + 1) - 1)) == 0) ++top;
+    if (top == kLevels) {
+        cascade(_overflow);
+        top = kLevels - 1;
+    }
+    for (int l = top; l >= 1; --l) {
+        cascade(_slots[l][slotIndex(_now, l)]);
+    }
+    auto& slot = _slots[0][slotIndex(_now, 0)];
+    if (slot.empty()) return;
+    std::vector<Entry> due;
+    due.swap(slot);
+    for (const auto& e : due) {
+        if (!isLive(e)) continue;
+        _due.erase(e.id);
+        fired.push_back(e.id);
+    }
+}
+
+} // namespace Game
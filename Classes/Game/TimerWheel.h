@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Game {
+
+// TimerWheel：分层时间轮（4 层 × 64 槽，时间单位为调用方定义的“刻”）。
+// - 第 0 层每槽对应 1 刻，第 l 层每槽对应 64^l 刻；超出 64^4 刻的定时器放在溢出表中；
+// - 每推进一刻只处理当前槽：到达高层槽边界时先把该槽的定时器按剩余时间重新分层，再触发第 0 层当前槽；
+// - 取消/重设采用惰性删除：槽中的旧条目在下次被访问时与 _due 比对后丢弃；
+// - 没有任何定时器时推进只改时钟，不遍历槽。
+class TimerWheel {
+public:
+    static const int kSlotBits = 6;
+    static const int kSlots = 1 << kSlotBits;
+    static const int kLevels = 4;
+
+    std::uint64_t now() const { return _now; }
+    bool empty() const { return _due.empty(); }
+    std::size_t size() const { return _due.size(); }
+
+    // 在 dueTick 触发 id；dueTick <= now() 时在下一次 advance 中触发。同一 id 重复调度以最后一次为准。
+    void schedule(std::uint64_t id, std::uint64_t dueTick);
+    // 取消定时器；id 不存在时返回 false。
+    bool cancel(std::uint64_t id);
+    // 查询 id 的触发时刻；id 不存在时返回 false。
+    bool dueTick(std::uint64_t id, std::uint64_t& out) const;
+    // 推进 ticks 刻，把到期的 id 按触发时刻先后追加到 fired。
+    void advance(std::uint64_t ticks, std::vector<std::uint64_t>& fired);
+    // 清空所有定时器（时钟不回退）。
+    void clear();
+
+private:
+    struct Entry {
+        std::uint64_t id;
+        std::uint64_t due;
+    };
+
+    bool isLive(const Entry& e) const;
+    void insert(const Entry& e);
+    void cascade(std::vector<Entry>& bucket);
+    void tick(std::vector<std::uint64_t>& fired);
+
+    std::uint64_t _now = 0;
+    std::vector<Entry> _slots[kLevels][kSlots];
+    std::vector<Entry> _overflow;
+    std::vector<Entry> _expired;
+    std::unordered_map<std::uint64_t, std::uint64_t> _due;
+};
+
+} // namespace Game
@@ -80,6 +80,7 @@ std::string Hoe::use(Controllers::IMapController* map,
         msg = std::string("Nothing");
     } else {
         bool anyAction = false;
+        map->beginTileBatch();
         for (const auto& tile : tiles) {
             int tc = tile.first;
             int tr = tile.second;
@@ -169,6 +170,7 @@ std::string Hoe::use(Controllers::IMapController* map,
                 }
             }
         }
+        map->commitTileBatch();
         if (!anyAction && msg.empty()) {
             msg = std::string("Nothing");
         }
@@ -118,6 +118,7 @@ std::string WaterCan::use(Controllers::IMapController* map,
     std::string msg;
     int remaining = ws.water;
     int wateredCount = 0;
+    map->beginTileBatch();
     for (const auto& tile : tiles) {
         int tc = tile.first;
         int tr = tile.second;
@@ -129,6 +130,7 @@ std::string WaterCan::use(Controllers::IMapController* map,
             ++wateredCount;
         }
     }
+    map->commitTileBatch();
     ws.water = remaining;
     if (wateredCount > 0) {
         msg = std::string("Water! (") + std::to_string(ws.water) + std::string("/") + std::to_string(ws.maxWater) + std::string(")");
@@ -0,0 +1,55 @@
+#include "Game/WorkerPool.h"
+#include <algorithm>
+
+namespace Game {
+
+WorkerPool::WorkerPool(unsigned int threads) {
+    if (threads == 0) {
+        unsigned int hw = std::thread::hardware_concurrency();
+        threads = std::min(4u, std::max(1u, hw > 1 ? hw - 1 : 1u));
+    }
+    _threads.reserve(threads);
+    for (unsigned int i = 0; i < threads; ++i) {
+        _threads.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _cv.notify_all();
+    for (auto& t : _threads) {
+        if (t.joinable()) t.join();
+    }
+}
+
+WorkerPool& WorkerPool::shared() {
+    static WorkerPool pool;
+    return pool;
+}
+
+void WorkerPool::submit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _jobs.push_back(std::move(job));
+    }
+    _cv.notify_one();
+}
+
+void WorkerPool::workerLoop() {
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cv.wait(lock, [this]() { return _stopping || !_jobs.empty(); });
+            if (_jobs.empty()) return;
+            job = std::move(_jobs.front());
+            _jobs.pop_front();
+        }
+        if (job) job();
+    }
+}
+
+} // namespace Game
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Game {
+
+// WorkerPool：固定线程数的后台任务池（夜间结算等 CPU 任务用；存档写盘仍走 AsyncTaskPool 的 IO 线程）。
+// - 任务按提交顺序取出，线程数在构造后不变；
+// - 析构时先执行完已提交的任务再退出线程；
+// - 任务不应抛出异常，也不得访问 cocos2d 节点（只在主线程安全）。
+class WorkerPool {
+public:
+    // threads 为 0 时按硬件核数选择（保留一个核给主线程，至少 1 个、至多 4 个）。
+    explicit WorkerPool(unsigned int threads = 0);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // 进程内共享的默认实例，首次使用时创建。
+    static WorkerPool& shared();
+
+    unsigned int size() const { return static_cast<unsigned int>(_threads.size()); }
+    void submit(std::function<void()> job);
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> _threads;
+    std::deque<std::function<void()>> _jobs;
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    bool _stopping = false;
+};
+
+} // namespace Game
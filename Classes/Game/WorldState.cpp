@@ -1,4 +1,5 @@
 #include "Game/WorldState.h"
+#include <cstdint>
 
 namespace Game {
 
@@ -7,4 +8,24 @@ WorldState& globalState() {
     return state;
 }
 
+void syncFarmBlockers(WorldState& ws) {
+    ws.farmTiles.clearBlockers();
+    for (const auto& tp : ws.farmTrees) ws.farmTiles.addBlocker(tp.c, tp.r);
+    for (const auto& rp : ws.farmRocks) ws.farmTiles.addBlocker(rp.c, rp.r);
+    for (const auto& wp : ws.farmWeeds) ws.farmTiles.addBlocker(wp.c, wp.r);
+}
+
+unsigned int daySeed(const WorldState& ws) {
+    // 先转成无符号再相乘：有符号乘法在槽位或日期稍大时就会溢出（未定义行为）
+    std::uint32_t seed = 0u;
+    seed ^= static_cast<std::uint32_t>(ws.lastSaveSlot) * 73856093u;
+    seed ^= static_cast<std::uint32_t>(ws.seasonIndex) * 19349663u;
+    seed ^= static_cast<std::uint32_t>(ws.dayOfSeason) * 83492791u;
+    return seed;
+}
+
+unsigned int nightlySeed(const WorldState& ws, NightlyStream stream) {
+    return daySeed(ws) ^ (static_cast<std::uint32_t>(stream) * 2654435761u);
+}
+
 } // namespace Game
\ No newline at end of file
@@ -11,10 +11,12 @@
 #include <string>
 #include "Game/Inventory.h"
 #include "Game/Tile.h"
+#include "Game/TileGrid.h"
 #include "Game/Drop.h"
 #include "Game/PlaceableItem/Chest.h"
 #include "Game/GameConfig.h"
 #include "Game/Crops/crop/CropBase.h"
+#include "Game/Crops/crop/CropStore.h"
 #include "Game/EnvironmentObstacle/Tree.h"
 #include "Game/EnvironmentObstacle/Rock.h"
 #include "Game/EnvironmentObstacle/Weed.h"
@@ -43,10 +45,8 @@ struct WorldState {
     // 全局箱子（相当于扩展背包）
     Chest globalChest;
 
-    // 农场地图（按行主序 r*_cols + c）
-    std::vector<TileType> farmTiles;
-    int farmCols = 0;
-    int farmRows = 0;
+    // 农场地图（按行主序 r*cols + c）：唯一存储，FarmMapController 直接读写
+    TileGrid farmTiles;
 
     // 农场掉落（未拾取的物品）
     std::vector<Drop> farmDrops;
@@ -66,8 +66,8 @@ struct WorldState {
     // 农场箱子（已放置的储物箱）
     std::vector<Chest> farmChests;
 
-    // 农场作物
-    std::vector<Crop> farmCrops;
+    // 农场作物（按列存储，见 CropStore）
+    CropStore farmCrops;
 
     std::vector<TreePos> farmTrees;
     std::vector<RockPos> farmRocks;
@@ -157,4 +157,35 @@ struct WorldState {
 // 获取全局状态（惰性初始化由调用方保证）
 WorldState& globalState();
 
+// 按 farmTrees/farmRocks/farmWeeds 重建 farmTiles 的障碍物占用层（及空闲土壤集合）。
+// 读档、生成障碍物等整表替换之后调用；单个障碍物的增删直接用 TileGrid::addBlocker/removeBlocker。
+void syncFarmBlockers(WorldState& ws);
+
+// 夜间结算的随机流：每个系统使用各自的流，互不影响抽取顺序。
+enum class NightlyStream : unsigned int { Crops = 1, Animals, Trees, Rocks, Weeds };
+
+// 当天的随机种子：由存档槽与日期散列得到，天气选择直接使用，夜间结算在此基础上按随机流区分。
+unsigned int daySeed(const WorldState& ws);
+
+// 夜间结算的随机种子：daySeed 再按随机流区分。
+// 同一存档的同一天总是得到相同的结算结果，无头模拟也因此可以用状态哈希做回归比较。
+unsigned int nightlySeed(const WorldState& ws, NightlyStream stream);
+
+// 按格子取随机数的计数器式散列：结果只取决于 (seed, day, c, r)，与遍历顺序、线程数及
+// 其他系统是否先抽过随机数无关。内联且只用 32 位整数运算，批量调用时编译器可以向量化。
+inline unsigned int nightlyTileHash(unsigned int seed, int day, int c, int r) {
+    auto mix = [](unsigned int h) {
+        h ^= h >> 16;
+        h *= 0x85ebca6bu;
+        h ^= h >> 13;
+        h *= 0xc2b2ae35u;
+        h ^= h >> 16;
+        return h;
+    };
+    unsigned int h = mix(seed ^ (static_cast<unsigned int>(day) * 0x9e3779b9u));
+    h = mix(h ^ (static_cast<unsigned int>(c) * 0x85ebca6bu));
+    h = mix(h ^ (static_cast<unsigned int>(r) * 0xc2b2ae35u));
+    return h;
+}
+
 } // namespace Game
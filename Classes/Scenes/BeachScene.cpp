@@ -45,15 +45,15 @@ bool BeachScene::init() {
         if (furnace) {
             furnace->bindContext(_mapController, _uiController, _inventory);
             furnace->syncLoad();
-            addUpdateCallback([furnace](float dt) {
-                furnace->update(dt);
-            });
         }
     }
     return true;
 }
 
 BeachScene::~BeachScene() {
+    if (_beachMap && _beachMap->furnaceController()) {
+        _beachMap->furnaceController()->detach();
+    }
     delete _chestInteractor;
     _chestInteractor = nullptr;
     delete _npcController;
@@ -50,9 +50,6 @@ bool FarmScene::init() {
         if (furnace) {
             furnace->bindContext(_mapController, _uiController, _inventory);
             furnace->syncLoad();
-            addUpdateCallback([furnace](float dt) {
-                furnace->update(dt);
-            });
         }
     }
     if (_uiController && _animalSystem) {
@@ -72,6 +69,9 @@ bool FarmScene::init() {
 }
 
 FarmScene::~FarmScene() {
+    if (_farmMap && _farmMap->furnaceController()) {
+        _farmMap->furnaceController()->detach();
+    }
     delete _interactor;
     _interactor = nullptr;
     delete _animalSystem;
@@ -7,6 +7,7 @@
 #include "Scenes/CustomizationScene.h"
 #include "Game/WorldState.h"
 #include "Game/Save/SaveSystem.h"
+#include "Game/PlaceableItem/FurnaceScheduler.h"
 #include "cocos2d.h"
 #include "ui/CocosGUI.h"
 
@@ -117,6 +118,7 @@ void MainMenuScene::onStart(Ref* sender) {
         Game::setCurrentSavePath(path);
         auto& ws = Game::globalState();
         ws = Game::WorldState();
+        Game::FurnaceScheduler::getInstance().rebuild();
         ws.lastScene = static_cast<int>(Game::SceneKind::Room);
         auto nextScene = CustomizationScene::createScene();
         auto trans = TransitionFade::create(0.5f, nextScene);
@@ -152,6 +154,30 @@ static cocos2d::Scene* createSceneForLastState() {
     }
 }
 
+// 读档列表中一行的文字：文件名 + 季节日期、时间、金币与所在场景。
+static std::string describeSave(const Game::SaveSummary& save) {
+    if (!save.valid) {
+        return save.name + "  (unreadable)";
+    }
+    static const char* kSeasons[] = { "Spring", "Summer", "Fall", "Winter" };
+    const char* place = "Room";
+    switch (static_cast<Game::SceneKind>(save.lastScene)) {
+        case Game::SceneKind::Farm:  place = "Farm"; break;
+        case Game::SceneKind::Mine:  place = "Mine"; break;
+        case Game::SceneKind::Beach: place = "Beach"; break;
+        case Game::SceneKind::Town:  place = "Town"; break;
+        default: break;
+    }
+    int season = ((save.seasonIndex % 4) + 4) % 4;
+    std::string text = StringUtils::format("%s  %s Day %d, %02d:%02d  %lldg  %s",
+        save.name.c_str(), kSeasons[season], save.dayOfSeason,
+        save.timeHour, save.timeMinute, save.gold, place);
+    if (static_cast<Game::SceneKind>(save.lastScene) == Game::SceneKind::Mine && save.lastMineFloor > 0) {
+        text += StringUtils::format(" B%d", save.lastMineFloor);
+    }
+    return text;
+}
+
 void MainMenuScene::onLoad(Ref* sender) {
     auto visibleSize = Director::getInstance()->getVisibleSize();
     auto origin = Director::getInstance()->getVisibleOrigin();
@@ -169,20 +195,13 @@ void MainMenuScene::onLoad(Ref* sender) {
         overlay->addChild(title, 1);
     }
 
-    auto* fu = FileUtils::getInstance();
-    std::string dir = Game::saveDirectory();
-    std::vector<std::string> paths = fu->listFiles(dir);
+    // 摘要来自存档目录的索引缓存，只有新增/改动过的存档才会读取文件头。
+    std::vector<Game::SaveSummary> saves = Game::listSaveSummaries();
 
     cocos2d::Vector<MenuItem*> items;
-    for (const auto& p : paths) {
-        if (p.size() < 4) continue;
-        if (p.substr(p.size() - 4) != ".txt") continue;
-        std::string name = p;
-        auto pos = name.find_last_of("/\\");
-        if (pos != std::string::npos) {
-            name = name.substr(pos + 1);
-        }
-        auto label = Label::createWithTTF(name, "fonts/Marker Felt.ttf", 24);
+    for (const auto& save : saves) {
+        std::string p = save.path;
+        auto label = Label::createWithTTF(describeSave(save), "fonts/Marker Felt.ttf", 24);
         auto item = MenuItemLabel::create(label, [overlay, p](Ref*){
             if (!Game::loadFromFile(p)) {
                 overlay->removeFromParent();
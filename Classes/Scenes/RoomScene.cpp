@@ -34,15 +34,15 @@ bool RoomScene::init() {
         if (furnace) {
             furnace->bindContext(_mapController, _uiController, _inventory);
             furnace->syncLoad();
-            addUpdateCallback([furnace](float dt) {
-                furnace->update(dt);
-            });
         }
     }
     return true;
 }
 
 RoomScene::~RoomScene() {
+    if (_roomMap && _roomMap->furnaceController()) {
+        _roomMap->furnaceController()->detach();
+    }
     delete _interactor;
     _interactor = nullptr;
 }
@@ -91,6 +91,19 @@ void RoomScene::onKeyPressedHook(EventKeyboard::KeyCode code) {
         auto mine = MineScene::create();
         auto trans = TransitionFade::create(0.6f, mine);
         Director::getInstance()->replaceScene(trans);
+    } else if (code == EventKeyboard::KeyCode::KEY_N) {
+        // 快进：在床上按 N 连睡多天，整段只存档一次、只重建一次场景（醒来仍在床上）
+        if (!_stateController || !_roomMap || !_player) return;
+        const auto& bed = _roomMap->bedRect();
+        if (!bed.containsPoint(_player->getPosition())) return;
+        _stateController->sleepDays(GameConfig::FAST_FORWARD_DAYS);
+        auto& ws = Game::globalState();
+        ws.lastScene = static_cast<int>(Game::SceneKind::Room);
+        ws.lastPlayerX = bed.getMidX();
+        ws.lastPlayerY = bed.getMidY();
+        auto room = RoomScene::create();
+        auto trans = TransitionFade::create(0.6f, room);
+        Director::getInstance()->replaceScene(trans);
     }
 }
 
@@ -10,6 +10,8 @@
 #include "Controllers/Weather/WeatherController.h"
 #include "Controllers/Systems/FestivalController.h"
 #include "Game/Tool/FishingRod.h"
+#include "Game/Save/SaveSystem.h"
+#include "Game/PlaceableItem/FurnaceScheduler.h"
 
 using namespace cocos2d;
 
@@ -145,17 +147,13 @@ bool SceneBase::initBase(float worldScale, bool buildCraftPanel, bool enableTool
 
     if (_mapController && _mapController->supportsWeather()) {
         _weatherController = new Controllers::WeatherController(_mapController, _worldNode, _playerController);
-        addUpdateCallback([this](float dt) {
-            if (_weatherController) _weatherController->update(dt);
-        });
     }
 
     if (_mapController) {
         _festivalController = new Controllers::FestivalController(_mapController);
-        addUpdateCallback([this](float dt) {
-            if (_festivalController) _festivalController->update(dt);
-        });
     }
+    scheduleMorningRefresh();
+    refreshDayNightOverlay();
 
     _fishingController = new Controllers::FishingController(_mapController, _inventory, _uiController, this, _worldNode);
     addUpdateCallback([this](float dt) {
@@ -204,6 +202,56 @@ void SceneBase::registerCommonInputHandlers(bool enableToolOnSpace, bool enableT
         [this](EventMouse* e) { onMouseDown(e); });
 }
 
+void SceneBase::onEnterTransitionDidFinish() {
+    Scene::onEnterTransitionDidFinish();
+    std::string path = Game::currentSavePath();
+    if (!path.empty()) {
+        Game::saveCheckpoint(path);
+    }
+}
+
+void SceneBase::scheduleMorningRefresh() {
+    if (!_stateController) return;
+    _stateController->scheduleNextMorning([this]() {
+        if (_weatherController) _weatherController->onNewDay();
+        if (_festivalController) _festivalController->onNewDay();
+        scheduleMorningRefresh();
+    });
+}
+
+// 遮罩只在 17:30~19:00 之间逐分钟加深：之前等到 17:31，期间每分钟唤醒一次，之后等到次日早晨。
+void SceneBase::refreshDayNightOverlay() {
+    if (!_dayNightOverlay) return;
+    if (!_mapController || !_mapController->supportsWeather()) {
+        _dayNightOverlay->setOpacity(0);
+        _dayNightOverlay->setVisible(false);
+        return;
+    }
+    const auto& ws = Game::globalState();
+    int minutes = ws.timeHour * 60 + ws.timeMinute;
+    const int start = 17 * 60 + 30;
+    const int end = 19 * 60;
+    const int maxOpacity = 120;
+    int opacity = 0;
+    if (minutes >= end) {
+        opacity = maxOpacity;
+    } else if (minutes > start) {
+        float t = static_cast<float>(minutes - start) / static_cast<float>(end - start);
+        opacity = static_cast<int>(static_cast<float>(maxOpacity) * t);
+    }
+    _dayNightOverlay->setOpacity(static_cast<GLubyte>(std::max(0, std::min(255, opacity))));
+    _dayNightOverlay->setVisible(true);
+    if (!_stateController) return;
+    auto wake = [this]() { refreshDayNightOverlay(); };
+    if (minutes >= end) {
+        _stateController->scheduleNextMorning(wake);
+    } else if (minutes >= start) {
+        _stateController->scheduleInMinutes(1, wake);
+    } else {
+        _stateController->scheduleAt(17, 31, wake);
+    }
+}
+
 void SceneBase::update(float dt) {
     auto& ws = Game::globalState();
     if (_player) {
@@ -228,26 +276,8 @@ void SceneBase::update(float dt) {
         return;
     }
     _stateController->update(dt);
-    if (_dayNightOverlay) {
-        if (_mapController && _mapController->supportsWeather()) {
-            int minutes = ws.timeHour * 60 + ws.timeMinute;
-            const int start = 17 * 60 + 30;
-            const int end = 19 * 60;
-            const int maxOpacity = 120;
-            int opacity = 0;
-            if (minutes >= end) {
-                opacity = maxOpacity;
-            } else if (minutes > start) {
-                float t = static_cast<float>(minutes - start) / static_cast<float>(end - start);
-                opacity = static_cast<int>(static_cast<float>(maxOpacity) * t);
-            }
-            _dayNightOverlay->setOpacity(static_cast<GLubyte>(std::max(0, std::min(255, opacity))));
-            _dayNightOverlay->setVisible(true);
-        } else {
-            _dayNightOverlay->setOpacity(0);
-            _dayNightOverlay->setVisible(false);
-        }
-    }
+    // 全世界熔炉共用一个时间轮，每帧推进一次（含未加载区域）
+    Game::FurnaceScheduler::getInstance().advance(dt);
     bool blockMoveByUI = ws.fishingActive
                          || (_uiController && (_uiController->isDialogueVisible()
                                                || _uiController->isNpcSocialVisible()
@@ -266,8 +296,9 @@ void SceneBase::update(float dt) {
         Vec2 p = _player->getPosition();
         if (_inventory) {
             _mapController->collectDropsNear(p, _inventory.get());
-            _uiController->refreshHotbar();
         }
+        // 热键栏按背包版本号比对，无变化时为空操作，可每帧调用。
+        _uiController->refreshHotbar();
         bool nearDoor = _mapController->isNearDoor(p);
         _uiController->showDoorPrompt(nearDoor, _mapController->getPlayerPosition(p), doorPromptText());
         bool nearLake = _mapController->isNearLake(p, _mapController->tileSize() * (GameConfig::LAKE_REFILL_RADIUS_TILES + 0.5f));
@@ -40,6 +40,9 @@ protected:
     // 统一 update 调度：转发到控制器并刷新提示。
     void update(float dt) override;
 
+    // 场景切换完成：写一次增量存档检查点（只追加变化的部分）。
+    void onEnterTransitionDidFinish() override;
+
     // 子类必须提供：创建地图控制器；设置初始玩家位置；空格交互；提示文案。
     // 创建地图控制器：返回当前场景使用的 IMapController 实现。
     virtual Controllers::IMapController* createMapController(cocos2d::Node* worldNode) = 0;
@@ -78,6 +81,10 @@ private:
     // 事件转发
     // 注册通用输入处理并绑定到 PlayerController/子类钩子。
     void registerCommonInputHandlers(bool enableToolOnSpace, bool enableToolOnLeftClick, bool buildCraftPanel);
+    // 订阅“次日早晨”事件：刷新天气/节日后再订阅下一次。
+    void scheduleMorningRefresh();
+    // 按当前时刻设置黄昏遮罩透明度，并订阅下一次需要变化的时刻。
+    void refreshDayNightOverlay();
 
 protected:
     // 子类可覆盖的事件挂钩（默认空），用于转发到自定义控制器
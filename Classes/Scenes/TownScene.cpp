@@ -54,15 +54,15 @@ bool TownScene::init() {
         if (furnace) {
             furnace->bindContext(_mapController, _uiController, _inventory);
             furnace->syncLoad();
-            addUpdateCallback([furnace](float dt) {
-                furnace->update(dt);
-            });
         }
     }
     return true;
 }
 
 TownScene::~TownScene() {
+    if (_townMap && _townMap->furnaceController()) {
+        _townMap->furnaceController()->detach();
+    }
     delete _chestInteractor;
     _chestInteractor = nullptr;
     delete _npcController;
@@ -23,16 +23,25 @@
  ****************************************************************************/
 
 #include "../Classes/AppDelegate.h"
+#include "../Classes/CommandLineModes.h"
 
 #include <stdlib.h>
 #include <stdio.h>
 #include <unistd.h>
 #include <string>
+#include <vector>
 
 USING_NS_CC;
 
 int main(int argc, char **argv)
 {
+    // 开发者命令行模式：不创建窗口，跑完写出报告后直接退出
+    std::vector<std::string> args(argv + 1, argv + argc);
+    int exitCode = 0;
+    if (runCommandLineMode(args, exitCode)) {
+        return exitCode;
+    }
+
     // create the application instance
     AppDelegate app;
     return Application::getInstance()->run();
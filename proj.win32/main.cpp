@@ -25,6 +25,9 @@
 #include "main.h"
 #include "AppDelegate.h"
 #include "cocos2d.h"
+#include "CommandLineModes.h"
+#include <string>
+#include <vector>
 
 USING_NS_CC;
 
@@ -36,6 +39,24 @@ int WINAPI _tWinMain(HINSTANCE hInstance,
     UNREFERENCED_PARAMETER(hPrevInstance);
     UNREFERENCED_PARAMETER(lpCmdLine);
 
+    // 开发者命令行模式：不创建窗口，跑完写出报告后直接退出
+    std::vector<std::string> args;
+    for (int i = 1; i < __argc; ++i) {
+#ifdef UNICODE
+        const wchar_t* arg = __wargv[i];
+        int len = WideCharToMultiByte(CP_UTF8, 0, arg, -1, nullptr, 0, nullptr, nullptr);
+        std::string utf8(len > 0 ? static_cast<std::size_t>(len - 1) : 0, '\0');
+        if (len > 1) WideCharToMultiByte(CP_UTF8, 0, arg, -1, &utf8[0], len, nullptr, nullptr);
+        args.push_back(utf8);
+#else
+        args.push_back(__argv[i]);
+#endif
+    }
+    int exitCode = 0;
+    if (runCommandLineMode(args, exitCode)) {
+        return exitCode;
+    }
+
     // create the application instance
     AppDelegate app;
     return Application::getInstance()->run();